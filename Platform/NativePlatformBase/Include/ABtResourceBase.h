@@ -12,6 +12,7 @@
 /// SOFTWARE.
 ///
 
+#include <cstddef>
 #include <cstdint>
 
 namespace dy
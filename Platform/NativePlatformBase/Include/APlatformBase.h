@@ -13,6 +13,7 @@
 ///
 
 #include <cstdint>
+#include <memory>
 #include <EPlatform.h>
 #include <EBtResource.h>
 #include <AHandlesBase.h>
@@ -13,6 +13,7 @@
 ///
 
 #include <cstdint>
+#include <vector>
 
 namespace dy
 {
@@ -30,6 +31,11 @@ public:
 
   /// @brief Get ram usage as byte unit.
   virtual uint64_t GetRamUsage() = 0;
+
+  /// @brief Get cpu usage of each logical core as percentage. (0 ~ 100)
+  /// This is usage of whole system, not only this process.
+  /// If platform does not support it, return empty list.
+  virtual std::vector<float> GetCpuUsagePerCore() { return {}; }
 };
 
 inline AProfilingBase::~AProfilingBase() = default;
@@ -0,0 +1,148 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace dy
+{
+
+class APlatformBase;
+
+/// @struct PFrameLoopDescriptor
+/// @brief Descriptor of frame loop.
+struct PFrameLoopDescriptor final
+{
+  /// @brief Fixed simulation step as seconds.
+  /// This value must be bigger than 0.
+  double mFixedStep = 1.0 / 60.0;
+  /// @brief Maximum fixed steps in one frame. Remaining time is dropped when exceeded,
+  /// so long frame (e.g. breakpoint) does not make simulation catch up forever.
+  uint32_t mMaxStepsPerFrame = 8;
+  /// @brief Frame rate cap. If 0, frame rate is not capped.
+  double mMaxFrameRate = 0.0;
+  /// @brief Remaining time to be spun instead of sleeping when pacing frame as seconds.
+  /// OS sleep overshoots by its timer granularity, so last part of frame is spun.
+  double mSpinThreshold = 0.002;
+};
+
+/// @struct DFrameLoopStatistics
+/// @brief Frame time statistics of recent frames. Frame time includes pacing sleep.
+struct DFrameLoopStatistics final
+{
+  uint64_t mFrameCount = 0;
+  /// @brief Average frame time of recent frames as seconds.
+  double mAverageFrameTime = 0.0;
+  /// @brief Standard deviation of recent frame times as seconds.
+  double mJitter = 0.0;
+  /// @brief Minimum and maximum frame time of recent frames as seconds.
+  double mMinFrameTime = 0.0;
+  double mMaxFrameTime = 0.0;
+  /// @brief The number of frames which exceeded target frame time of frame rate cap.
+  uint64_t mMissedFrameCount = 0;
+  /// @brief Total simulation time dropped by mMaxStepsPerFrame as seconds.
+  double mDroppedTime = 0.0;
+};
+
+/// @class FFrameLoop
+/// @brief Frame-paced main loop with measured delta time and fixed-step simulation accumulator.
+///
+/// @code
+/// while (platform.CanShutdown() == false)
+/// {
+///   loop.BeginFrame();
+///   platform.PollEvents();
+///   while (loop.StepFixed() == true) { Simulate(loop.GetFixedStep()); }
+///   Render(loop.GetAlpha());
+///   loop.EndFrame();
+/// }
+/// @endcode
+class FFrameLoop final
+{
+public:
+  using TClock = std::chrono::steady_clock;
+  /// @brief Frame callback type of `Run`.
+  using TFrameCallback = std::function<void(FFrameLoop&)>;
+
+  FFrameLoop(const PFrameLoopDescriptor& desc = {});
+
+  /// @brief Run loop until platform can be shutdown. 
+  /// Each frame polls events of platform and calls given callback between BeginFrame and EndFrame.
+  void Run(APlatformBase& platform, const TFrameCallback& onFrame);
+
+  /// @brief Begin frame with measured delta time from previous frame.
+  /// Delta time of first frame is fixed step.
+  void BeginFrame();
+
+  /// @brief Begin frame with given delta time as seconds.
+  /// This does not read clock, so simulation can be driven deterministically.
+  /// Frame begun by this function is not paced by EndFrame.
+  void BeginFrame(double deltaTime);
+
+  /// @brief Consume one fixed step from accumulator.
+  /// @return If fixed step should be simulated, return true.
+  bool StepFixed() noexcept;
+
+  /// @brief End frame. If frame rate is capped and frame was begun with measured delta time,
+  /// wait until target frame time.
+  void EndFrame();
+
+  /// @brief Get delta time of this frame as seconds.
+  float GetDeltaTime() const noexcept;
+
+  /// @brief Get fixed step as seconds.
+  float GetFixedStep() const noexcept;
+
+  /// @brief Get interpolation factor [0, 1] between previous and present fixed step state.
+  /// Remainder is less than fixed step, but may be rounded to 1 when converted to float.
+  float GetAlpha() const noexcept;
+
+  /// @brief Set frame rate cap. If 0, frame rate is not capped.
+  void SetMaxFrameRate(double frameRate) noexcept;
+
+  /// @brief Get statistics of recent frames.
+  DFrameLoopStatistics GetStatistics() const noexcept;
+
+private:
+  /// @brief Accumulate delta time and start new frame statistics.
+  void AdvanceFrame(double deltaTime);
+
+  /// @brief Sleep until given time point, spinning last part for precision.
+  void WaitUntil(TClock::time_point timePoint) const;
+
+  /// @brief Insert frame time into recent frame time window.
+  void InsertFrameTime(double frameTime) noexcept;
+
+  static constexpr size_t kWindowSize = 128;
+
+  PFrameLoopDescriptor mDesc;
+  TClock::time_point mFrameStart = {};
+  bool mHasFrameStarted = false;
+  /// If true, this frame was begun with measured delta time and is paced by EndFrame.
+  bool mIsPaced = false;
+
+  double mDeltaTime = 0.0;
+  double mAccumulator = 0.0;
+  uint32_t mStepCount = 0;
+
+  std::array<double, kWindowSize> mFrameTimes = {};
+  size_t mFrameTimeCount = 0;
+  uint64_t mFrameCount = 0;
+  uint64_t mMissedFrameCount = 0;
+  double mDroppedTime = 0.0;
+};
+
+} /// ::dy namespace
@@ -0,0 +1,185 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <FFrameLoop.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <thread>
+#include <APlatformBase.h>
+
+namespace dy
+{
+
+FFrameLoop::FFrameLoop(const PFrameLoopDescriptor& desc)
+  : mDesc{desc}
+{
+  assert(this->mDesc.mFixedStep > 0.0);
+}
+
+void FFrameLoop::Run(APlatformBase& platform, const TFrameCallback& onFrame)
+{
+  while (platform.CanShutdown() == false)
+  {
+    this->BeginFrame();
+    platform.PollEvents();
+    onFrame(*this);
+    this->EndFrame();
+  }
+}
+
+void FFrameLoop::BeginFrame()
+{
+  const auto now = TClock::now();
+  const double deltaTime = this->mHasFrameStarted == true
+    ? std::chrono::duration<double>(now - this->mFrameStart).count()
+    : this->mDesc.mFixedStep;
+
+  this->mFrameStart = now;
+  this->mHasFrameStarted = true;
+  this->mIsPaced = true;
+  this->AdvanceFrame(deltaTime);
+}
+
+void FFrameLoop::BeginFrame(double deltaTime)
+{
+  this->mIsPaced = false;
+  this->AdvanceFrame(deltaTime);
+}
+
+void FFrameLoop::AdvanceFrame(double deltaTime)
+{
+  this->mDeltaTime = (std::max)(deltaTime, 0.0);
+  this->mAccumulator += this->mDeltaTime;
+  this->mStepCount = 0;
+
+  this->InsertFrameTime(this->mDeltaTime);
+  this->mFrameCount += 1;
+}
+
+bool FFrameLoop::StepFixed() noexcept
+{
+  const double fixedStep = this->mDesc.mFixedStep;
+  if (this->mAccumulator < fixedStep) { return false; }
+
+  // When simulation can not catch up, drop whole steps and keep only remainder for interpolation.
+  if (this->mStepCount >= this->mDesc.mMaxStepsPerFrame)
+  {
+    const double remainder = std::fmod(this->mAccumulator, fixedStep);
+    this->mDroppedTime += this->mAccumulator - remainder;
+    this->mAccumulator = remainder;
+    return false;
+  }
+
+  this->mAccumulator -= fixedStep;
+  this->mStepCount += 1;
+  return true;
+}
+
+void FFrameLoop::EndFrame()
+{
+  // Frame driven by given delta time is not paced.
+  if (this->mIsPaced == false || this->mDesc.mMaxFrameRate <= 0.0) { return; }
+
+  const auto targetTime = std::chrono::duration<double>(1.0 / this->mDesc.mMaxFrameRate);
+  const auto targetPoint = this->mFrameStart 
+    + std::chrono::duration_cast<TClock::duration>(targetTime);
+  if (TClock::now() > targetPoint)
+  {
+    this->mMissedFrameCount += 1;
+    return;
+  }
+
+  this->WaitUntil(targetPoint);
+}
+
+float FFrameLoop::GetDeltaTime() const noexcept
+{
+  return static_cast<float>(this->mDeltaTime);
+}
+
+float FFrameLoop::GetFixedStep() const noexcept
+{
+  return static_cast<float>(this->mDesc.mFixedStep);
+}
+
+float FFrameLoop::GetAlpha() const noexcept
+{
+  const double alpha = this->mAccumulator / this->mDesc.mFixedStep;
+  return static_cast<float>((std::min)(alpha, 1.0));
+}
+
+void FFrameLoop::SetMaxFrameRate(double frameRate) noexcept
+{
+  this->mDesc.mMaxFrameRate = (std::max)(frameRate, 0.0);
+}
+
+DFrameLoopStatistics FFrameLoop::GetStatistics() const noexcept
+{
+  DFrameLoopStatistics result;
+  result.mFrameCount = this->mFrameCount;
+  result.mMissedFrameCount = this->mMissedFrameCount;
+  result.mDroppedTime = this->mDroppedTime;
+
+  const size_t count = (std::min)(this->mFrameTimeCount, kWindowSize);
+  if (count == 0) { return result; }
+
+  const auto begin = this->mFrameTimes.begin();
+  const auto [minIt, maxIt] = std::minmax_element(begin, begin + count);
+  result.mMinFrameTime = *minIt;
+  result.mMaxFrameTime = *maxIt;
+
+  double sum = 0.0;
+  for (size_t i = 0; i < count; ++i) { sum += this->mFrameTimes[i]; }
+  result.mAverageFrameTime = sum / count;
+
+  double squaredSum = 0.0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const double diff = this->mFrameTimes[i] - result.mAverageFrameTime;
+    squaredSum += diff * diff;
+  }
+  result.mJitter = std::sqrt(squaredSum / count);
+
+  return result;
+}
+
+void FFrameLoop::WaitUntil(TClock::time_point timePoint) const
+{
+  const auto spinThreshold = std::chrono::duration_cast<TClock::duration>(
+    std::chrono::duration<double>(this->mDesc.mSpinThreshold));
+
+  while (true)
+  {
+    const auto remaining = timePoint - TClock::now();
+    if (remaining <= TClock::duration::zero()) { return; }
+
+    if (remaining > spinThreshold)
+    {
+      std::this_thread::sleep_for(remaining - spinThreshold);
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void FFrameLoop::InsertFrameTime(double frameTime) noexcept
+{
+  this->mFrameTimes[this->mFrameTimeCount % kWindowSize] = frameTime;
+  this->mFrameTimeCount += 1;
+}
+
+} /// ::dy namespace
@@ -0,0 +1,36 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <ADebugBase.h>
+
+namespace dy
+{
+
+/// @class FHeadlessDebug
+/// @brief Debug type of headless platform.
+/// There is nobody to answer message box, so failed assertion is written into stderr and aborts program.
+class FHeadlessDebug final : public ADebugBase
+{
+public:
+  FHeadlessDebug() = default;
+  virtual ~FHeadlessDebug() = default;
+
+  void OnAssertionFailed(
+    const char* failedMessage, 
+    const char* function, 
+    const char* file, 
+    int line) override final;
+};
+
+} /// ::dy namespace
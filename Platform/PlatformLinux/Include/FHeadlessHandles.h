@@ -0,0 +1,42 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include <AHandlesBase.h>
+#include <Math/Type/Micellanous/DUuid.h>
+
+namespace dy
+{
+
+/// @struct DHeadlessWindow
+/// @brief Virtual window of headless platform. Nothing is displayed.
+struct DHeadlessWindow final
+{
+  std::string mTitle;
+  uint32_t mWidth = 0;
+  uint32_t mHeight = 0;
+};
+
+/// @struct FHeadlessHandles
+/// @brief Handle container of headless platform.
+struct FHeadlessHandles final : public AHandlesBase
+{
+  /// @brief User-created virtual window container.
+  std::unordered_map<math::DUuid, DHeadlessWindow> mWindows;
+};
+
+} /// ::dy namespace
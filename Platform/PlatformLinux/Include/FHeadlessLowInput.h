@@ -0,0 +1,40 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <ALowInput.h>
+
+namespace dy
+{
+
+/// @class FHeadlessLowInput
+/// @brief Low-input management type of headless platform.
+/// There is no input device, so inputs are only updated by descriptors queued into FHeadlessPlatform.
+class FHeadlessLowInput final : public base::ALowInput
+{
+public:
+  FHeadlessLowInput() = default;
+  virtual ~FHeadlessLowInput() = default;
+
+private:
+  /// @brief Implementation function. Descriptor type is PHeadlessInputKeyboard.
+  void UpdateKeyboard(void* descriptor) override final;
+
+  /// @brief Implementation function. Descriptor type is PHeadlessInputMouseBtn.
+  void UpdateMouseButton(void* descriptor) override final;
+
+  /// @brief Implementation function. Descriptor type is PHeadlessInputMousePos.
+  void UpdateMousePos(void* descriptor) override final;
+};
+
+} /// ::dy namespace
@@ -0,0 +1,121 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <variant>
+
+#include <APlatformBase.h>
+#include <PHeadlessInputKeyboard.h>
+#include <PHeadlessInputMouseBtn.h>
+#include <PHeadlessInputMousePos.h>
+
+namespace dy
+{
+
+/// @class FHeadlessPlatform
+/// @brief Platform type without display and GPU. 
+/// Windows are virtual and only keep title and size, so frame loop, input and profiling code
+/// can be run on Linux CI machines. Inputs are queued by user and applied when polling events.
+class FHeadlessPlatform final : public APlatformBase
+{
+public:
+  FHeadlessPlatform();
+  virtual ~FHeadlessPlatform(); 
+
+  /// @brief Set the number of `PollEvents` call before platform is shutdown automatically.
+  /// If 0, platform is not shutdown by frame count. (default)
+  void SetMaxFrameCount(uint64_t count) noexcept;
+
+  /// @brief Get the number of `PollEvents` call after `InitPlatform`.
+  uint64_t GetFrameCount() const noexcept;
+
+  /// @brief Queue keyboard input which will be applied at next `PollEvents`.
+  void QueueKeyboard(const PHeadlessInputKeyboard& desc);
+
+  /// @brief Queue mouse button input which will be applied at next `PollEvents`.
+  void QueueMouseButton(const PHeadlessInputMouseBtn& desc);
+
+  /// @brief Queue mouse position input which will be applied at next `PollEvents`.
+  void QueueMousePos(const PHeadlessInputMousePos& desc);
+
+private:
+  /// @brief Do nothing. Headless platform does not have background window.
+  bool CreateBackgroundWindow() override final;
+
+  /// @brief Do nothing. Headless platform does not have background window.
+  bool RemoveBackgroundWindow() override final;
+
+  void SetWindowTitle(const DWindowHandle& handle, const std::string& newTitle) override final;
+
+  std::string GetWindowTitle(const DWindowHandle& handle) const override final;
+
+  uint32_t GetWindowHeight(const DWindowHandle& handle) const override final;
+
+  uint32_t GetWindowWidth(const DWindowHandle& handle) const override final;
+
+  void ResizeWindow(const DWindowHandle& handle, uint32_t width, uint32_t height) override final;
+
+  /// @brief Just turn on console flag. stdout is already bound to terminal.
+  bool CreateConsoleWindow() override final;
+
+  /// @brief Just turn off console flag.
+  bool RemoveConsoleWindow() override final;
+
+  /// @brief There is no built-in resource in headless platform, so always return nullptr.
+  std::unique_ptr<ABtResourceBase> 
+  FindResource(int id, EXPR_E(EBtResource) type) override final;
+
+  /// @brief Create virtual window. Nothing is displayed.
+  /// If given size is not valid, just return std::nullopt.
+  std::optional<DWindowHandle> 
+  CreateWindow(const PWindowCreationDescriptor& desc) override final;
+
+  /// @brief Remove virtual window.
+  bool RemoveWindow(const DWindowHandle& handle) override final;
+
+  /// @brief Remove all virtual windows.
+  bool RemoveAllWindow() override final;
+
+  /// @brief Apply queued inputs and check termination signal and frame count.
+  void PollEvents() override final;
+
+  /// @brief Initialize platform dependent resources.
+  /// This installs SIGINT and SIGTERM handler to shutdown platform gracefully.
+  bool InitPlatform() override final;
+
+  /// @brief Release platform dependent resources.
+  /// Signal handlers are restored.
+  bool ReleasePlatform() override final;
+
+  /// @brief Check platform module can be shutdown.
+  /// Return true when all virtual windows are removed or shutdown is requested.
+  bool CanShutdown() override final;
+
+  /// @brief Get `DHeadlessWindow` instance of given handle.
+  /// If not exist, just return nullptr.
+  void* _GetHandleOf(const DWindowHandle& handle) override final;
+
+  using TInputEvent = std::variant<
+    PHeadlessInputKeyboard, 
+    PHeadlessInputMouseBtn, 
+    PHeadlessInputMousePos>;
+
+  std::queue<TInputEvent> mInputEvents;
+  uint64_t mMaxFrameCount = 0;
+  uint64_t mFrameCount = 0;
+};
+
+} /// ::dy namespace
@@ -0,0 +1,120 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <AProfilingBase.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dy
+{
+
+/// @struct DLinuxThreadStats
+/// @brief CPU time of one thread of process.
+struct DLinuxThreadStats final
+{
+  int32_t mThreadId = 0;
+  std::string mName;
+  /// @brief User + system CPU time of thread as second unit.
+  double mCpuSeconds = 0.0;
+};
+
+/// @struct DLinuxProcessStats
+/// @brief Sampled statistics of process.
+struct DLinuxProcessStats final
+{
+  /// @brief CPU usage of all cores as percentage. (100% is all cores are busy)
+  float mCpuUsage = 0.0f;
+  /// @brief CPU usage of each logical core of system as percentage.
+  std::vector<float> mCpuUsagePerCore;
+  /// @brief Resident set size as byte unit.
+  uint64_t mRss = 0;
+  /// @brief Peak resident set size as byte unit.
+  uint64_t mPeakRss = 0;
+  uint64_t mMinorPageFaults = 0;
+  uint64_t mMajorPageFaults = 0;
+  uint64_t mVoluntaryContextSwitches = 0;
+  uint64_t mInvoluntaryContextSwitches = 0;
+  std::vector<DLinuxThreadStats> mThreads;
+};
+
+/// @class FLinuxProfiling
+/// @brief Linux profiling. 
+/// Reads procfs and getrusage on background thread per sampling interval, 
+/// so getters just return the latest sample without blocking on procfs.
+class FLinuxProfiling final : public AProfilingBase
+{
+public:
+  explicit FLinuxProfiling(std::chrono::milliseconds samplingInterval = std::chrono::milliseconds(500));
+  virtual ~FLinuxProfiling();
+
+  FLinuxProfiling(const FLinuxProfiling&) = delete;
+  FLinuxProfiling& operator=(const FLinuxProfiling&) = delete;
+
+  /// @brief Get cpu usage as percentage.
+  float GetCpuUsage() override final;
+
+  /// @brief Get ram usage as byte unit.
+  uint64_t GetRamUsage() override final;
+
+  /// @brief Get cpu usage of each logical core as percentage.
+  std::vector<float> GetCpuUsagePerCore() override final;
+
+  /// @brief Get the latest sampled statistics of process.
+  DLinuxProcessStats GetProcessStats();
+
+private:
+  /// @brief Sampling thread routine.
+  void SampleRoutine();
+
+  /// @brief Read statistics of process. 
+  /// CPU usage is calculated from CPU time difference since the last sample.
+  DLinuxProcessStats Sample();
+
+  /// @brief Read CPU time of each thread from /proc/self/task/*/stat.
+  std::vector<DLinuxThreadStats> SampleThreads() const;
+
+  /// @brief Read CPU time of each core from /proc/stat, 
+  /// and calculate usage from time difference since the last sample.
+  std::vector<float> SampleCores();
+
+  std::chrono::milliseconds mSamplingInterval;
+  int64_t mNumProcessors = 1;
+  int64_t mClockTicksPerSecond = 100;
+  int64_t mPageSize = 4096;
+
+  /// @brief Only accessed by sampling thread.
+  std::chrono::steady_clock::time_point mLastSampleTime;
+  double mLastCpuSeconds = 0.0;
+  /// @brief Idle and total ticks of each core of the last sample.
+  std::vector<std::pair<uint64_t, uint64_t>> mLastCoreTicks;
+
+  std::atomic<float> mCpuUsage = 0.0f;
+  std::atomic<uint64_t> mRamUsage = 0;
+
+  std::mutex mMutex;
+  std::condition_variable mConditionVariable;
+  DLinuxProcessStats mStats;
+  bool mIsStopRequested = false;
+  std::thread mSamplingThread;
+};
+
+} /// ::dy namespace
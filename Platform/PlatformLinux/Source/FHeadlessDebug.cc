@@ -0,0 +1,33 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+/// Header file
+#include <FHeadlessDebug.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace dy
+{
+
+void FHeadlessDebug::OnAssertionFailed(
+  const char* failedMessage, const char* function, const char* file, int line)
+{
+  std::fprintf(stderr, "Assert %s, in %s of %s at %d.\n", failedMessage, function, file, line);
+  std::fflush(stderr);
+
+  this->TryCallReleaseFunction();
+  std::abort();
+}
+
+} /// ::dy namespace
@@ -0,0 +1,57 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+/// Header file
+#include <FHeadlessLowInput.h>
+
+#include <PHeadlessInputKeyboard.h>
+#include <PHeadlessInputMouseBtn.h>
+#include <PHeadlessInputMousePos.h>
+
+namespace dy
+{
+
+void FHeadlessLowInput::UpdateKeyboard(void* descriptor)
+{
+  const auto& desc = *static_cast<PHeadlessInputKeyboard*>(descriptor);
+  if (desc.mKey < 0 || desc.mKey >= base::Dy_Key_Menu) { return; }
+
+  this->sLowKeyboards[desc.mKey].Update(desc.mState);
+}
+
+void FHeadlessLowInput::UpdateMouseButton(void* descriptor)
+{
+  const auto& desc = *static_cast<PHeadlessInputMouseBtn*>(descriptor);
+  if (desc.mButton < 0 || desc.mButton >= base::DyMouse__Sum) { return; }
+
+  this->sLowMouseButtons[desc.mButton].Update(desc.mState);
+}
+
+void FHeadlessLowInput::UpdateMousePos(void* descriptor)
+{
+  using namespace base;
+  const auto& desc = *static_cast<PHeadlessInputMousePos*>(descriptor);
+
+  // There is no cursor to be centered, so unlimited state also just follows given position.
+  switch (this->GetMousePosState())
+  {
+  case ELowMousePosState::Normal: 
+  case ELowMousePosState::Unlimited: 
+  {
+    this->mLowMousePos.UpdatePosition(desc.mX, desc.mY);
+  } break;
+  default: break;
+  }
+}
+
+} /// ::dy namespace
@@ -0,0 +1,281 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+/// Header file
+#include <FHeadlessPlatform.h>
+
+#include <cassert>
+#include <csignal>
+
+#include <EPlatform.h>
+#include <FHeadlessHandles.h>
+#include <FHeadlessDebug.h>
+#include <FHeadlessLowInput.h>
+#include <FLinuxProfiling.h>
+
+namespace
+{
+
+/// @brief Set by signal handler when SIGINT or SIGTERM is received.
+volatile std::sig_atomic_t sIsTerminationRequested = 0;
+/// @brief Previous signal actions to be restored when releasing platform.
+struct sigaction sPrevSigInt = {};
+struct sigaction sPrevSigTerm = {};
+
+/// @brief
+void OnTerminationSignal(int)
+{
+  sIsTerminationRequested = 1;
+}
+
+} /// ::anonymous namespace
+
+namespace dy
+{
+
+FHeadlessPlatform::FHeadlessPlatform()
+  : APlatformBase{EPlatform::Linux}
+{
+  this->mHandle     = std::make_unique<FHeadlessHandles>();
+  this->mDebug      = std::make_unique<FHeadlessDebug>();
+  this->mProfiling  = std::make_unique<FLinuxProfiling>();
+  this->mLowInput   = std::make_unique<FHeadlessLowInput>();
+}
+
+FHeadlessPlatform::~FHeadlessPlatform() = default;
+
+void FHeadlessPlatform::SetMaxFrameCount(uint64_t count) noexcept
+{
+  this->mMaxFrameCount = count;
+}
+
+uint64_t FHeadlessPlatform::GetFrameCount() const noexcept
+{
+  return this->mFrameCount;
+}
+
+void FHeadlessPlatform::QueueKeyboard(const PHeadlessInputKeyboard& desc)
+{
+  this->mInputEvents.emplace(desc);
+}
+
+void FHeadlessPlatform::QueueMouseButton(const PHeadlessInputMouseBtn& desc)
+{
+  this->mInputEvents.emplace(desc);
+}
+
+void FHeadlessPlatform::QueueMousePos(const PHeadlessInputMousePos& desc)
+{
+  this->mInputEvents.emplace(desc);
+}
+
+bool FHeadlessPlatform::CreateBackgroundWindow()
+{
+  return true;
+}
+
+bool FHeadlessPlatform::RemoveBackgroundWindow()
+{
+  return true;
+}
+
+void FHeadlessPlatform::SetWindowTitle(const DWindowHandle& handle, const std::string& newTitle)
+{
+  auto& handleContainer = static_cast<FHeadlessHandles&>(*this->mHandle);
+  const auto it = handleContainer.mWindows.find(handle.mHandleUuid);
+  if (it == handleContainer.mWindows.end())
+  {
+    return;
+  }
+
+  it->second.mTitle = newTitle;
+}
+
+std::string FHeadlessPlatform::GetWindowTitle(const DWindowHandle& handle) const
+{
+  const auto& handleContainer = static_cast<const FHeadlessHandles&>(*this->mHandle);
+  const auto it = handleContainer.mWindows.find(handle.mHandleUuid);
+  if (it == handleContainer.mWindows.end())
+  {
+    return "";
+  }
+
+  return it->second.mTitle;
+}
+
+uint32_t FHeadlessPlatform::GetWindowHeight(const DWindowHandle& handle) const
+{
+  const auto& handleContainer = static_cast<const FHeadlessHandles&>(*this->mHandle);
+  const auto it = handleContainer.mWindows.find(handle.mHandleUuid);
+  if (it == handleContainer.mWindows.end())
+  {
+    return 0;
+  }
+
+  return it->second.mHeight;
+}
+
+uint32_t FHeadlessPlatform::GetWindowWidth(const DWindowHandle& handle) const
+{
+  const auto& handleContainer = static_cast<const FHeadlessHandles&>(*this->mHandle);
+  const auto it = handleContainer.mWindows.find(handle.mHandleUuid);
+  if (it == handleContainer.mWindows.end())
+  {
+    return 0;
+  }
+
+  return it->second.mWidth;
+}
+
+void FHeadlessPlatform::ResizeWindow(const DWindowHandle& handle, uint32_t width, uint32_t height)
+{
+  auto& handleContainer = static_cast<FHeadlessHandles&>(*this->mHandle);
+  const auto it = handleContainer.mWindows.find(handle.mHandleUuid);
+  if (it == handleContainer.mWindows.end() || width == 0 || height == 0)
+  {
+    return;
+  }
+
+  it->second.mWidth = width;
+  it->second.mHeight = height;
+}
+
+bool FHeadlessPlatform::CreateConsoleWindow()
+{
+  if (this->mIsConsoleWindowCreated == true) { return false; } 
+
+  this->mIsConsoleWindowCreated = true;
+  return true;
+}
+
+bool FHeadlessPlatform::RemoveConsoleWindow()
+{
+  if (this->mIsConsoleWindowCreated == false) { return false; } 
+
+  this->mIsConsoleWindowCreated = false;
+  return true;
+}
+
+std::unique_ptr<ABtResourceBase> 
+FHeadlessPlatform::FindResource(int, EXPR_E(EBtResource))
+{
+  return nullptr;
+}
+
+std::optional<DWindowHandle>
+FHeadlessPlatform::CreateWindow(const PWindowCreationDescriptor& desc)
+{
+  if (desc.mWindowWidth == 0 || desc.mWindowHeight == 0)
+  {
+    return std::nullopt;
+  }
+
+  DHeadlessWindow window;
+  window.mTitle   = desc.mWindowName;
+  window.mWidth   = desc.mWindowWidth;
+  window.mHeight  = desc.mWindowHeight;
+
+  // Insert virtual window with generated uuid.
+  auto& handleContainer = static_cast<FHeadlessHandles&>(*this->mHandle);
+  DWindowHandle uuidHandle = {};
+  auto [it, isSucceeded] = handleContainer.mWindows.try_emplace(
+      uuidHandle.mHandleUuid
+    , std::move(window));
+  assert(isSucceeded == true);
+
+  return uuidHandle;
+}
+
+bool FHeadlessPlatform::RemoveWindow(const DWindowHandle& handle)
+{
+  auto& handleContainer = static_cast<FHeadlessHandles&>(*this->mHandle);
+  handleContainer.mWindows.erase(handle.mHandleUuid);
+  return true;
+}
+
+bool FHeadlessPlatform::RemoveAllWindow()
+{
+  auto& handleContainer = static_cast<FHeadlessHandles&>(*this->mHandle);
+  handleContainer.mWindows.clear();
+  return true;
+}
+
+void FHeadlessPlatform::PollEvents()
+{
+  // Apply queued inputs in order.
+  auto& input = this->GetInputManager();
+  while (this->mInputEvents.empty() == false)
+  {
+    auto& event = this->mInputEvents.front();
+    switch (event.index())
+    {
+    case 0: { input.UpdateKeyboard(&std::get<0>(event)); } break;
+    case 1: { input.UpdateMouseButton(&std::get<1>(event)); } break;
+    case 2: { input.UpdateMousePos(&std::get<2>(event)); } break;
+    default: break;
+    }
+
+    this->mInputEvents.pop();
+  }
+
+  this->mFrameCount += 1;
+  if (sIsTerminationRequested != 0
+  || (this->mMaxFrameCount > 0 && this->mFrameCount >= this->mMaxFrameCount))
+  {
+    this->TryShutdown();
+  }
+}
+
+bool FHeadlessPlatform::InitPlatform()
+{
+  sIsTerminationRequested = 0;
+  this->mFrameCount = 0;
+
+  struct sigaction action = {};
+  action.sa_handler = OnTerminationSignal;
+  sigemptyset(&action.sa_mask);
+
+  if (sigaction(SIGINT, &action, &sPrevSigInt) != 0) { return false; }
+  if (sigaction(SIGTERM, &action, &sPrevSigTerm) != 0) { return false; }
+
+  return this->CreateBackgroundWindow();
+}
+
+bool FHeadlessPlatform::ReleasePlatform()
+{
+  if (this->RemoveBackgroundWindow() == false) { return false; }
+
+  sigaction(SIGINT, &sPrevSigInt, nullptr);
+  sigaction(SIGTERM, &sPrevSigTerm, nullptr);
+  return true;
+}
+
+bool FHeadlessPlatform::CanShutdown()
+{
+  const auto& handleContainer = static_cast<const FHeadlessHandles&>(*this->mHandle);
+  return handleContainer.mWindows.empty() == true || this->mShouldShutdown == true;
+}
+
+void* FHeadlessPlatform::_GetHandleOf(const DWindowHandle& handle)
+{
+  auto& handleContainer = static_cast<FHeadlessHandles&>(*this->mHandle);
+  const auto it = handleContainer.mWindows.find(handle.mHandleUuid);
+  if (it == handleContainer.mWindows.end())
+  {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+} /// ::dy namespace
@@ -0,0 +1,255 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+/// Header file
+#include <FLinuxProfiling.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace
+{
+
+/// @brief Get user + system CPU time of timeval pair as second unit.
+double ToSeconds(const timeval& user, const timeval& system)
+{
+  return double(user.tv_sec + system.tv_sec) + double(user.tv_usec + system.tv_usec) / 1'000'000.0;
+}
+
+/// @brief Read whole small procfs file into buffer. If failed, return false.
+bool ReadProcFile(const char* path, char* buffer, std::size_t bufferSize)
+{
+  FILE* pFile = std::fopen(path, "r");
+  if (pFile == nullptr) { return false; }
+
+  const auto length = std::fread(buffer, 1, bufferSize - 1, pFile);
+  std::fclose(pFile);
+
+  buffer[length] = '\0';
+  return length > 0;
+}
+
+} /// ::anonymous namespace
+
+namespace dy
+{
+
+FLinuxProfiling::FLinuxProfiling(std::chrono::milliseconds samplingInterval)
+  : mSamplingInterval{samplingInterval}
+{
+  this->mNumProcessors        = std::max<int64_t>(1, sysconf(_SC_NPROCESSORS_ONLN));
+  this->mClockTicksPerSecond  = std::max<int64_t>(1, sysconf(_SC_CLK_TCK));
+  this->mPageSize             = std::max<int64_t>(1, sysconf(_SC_PAGESIZE));
+
+  // Take the first sample synchronously, so getters are valid right after construction.
+  rusage usage = {};
+  getrusage(RUSAGE_SELF, &usage);
+  this->mLastCpuSeconds = ToSeconds(usage.ru_utime, usage.ru_stime);
+  this->mLastSampleTime = std::chrono::steady_clock::now();
+  this->mStats = this->Sample();
+
+  this->mSamplingThread = std::thread{&FLinuxProfiling::SampleRoutine, this};
+}
+
+FLinuxProfiling::~FLinuxProfiling()
+{
+  {
+    std::lock_guard<std::mutex> lock{this->mMutex};
+    this->mIsStopRequested = true;
+  }
+  this->mConditionVariable.notify_one();
+  this->mSamplingThread.join();
+}
+
+float FLinuxProfiling::GetCpuUsage()
+{
+  return this->mCpuUsage.load(std::memory_order_relaxed);
+}
+
+uint64_t FLinuxProfiling::GetRamUsage()
+{
+  return this->mRamUsage.load(std::memory_order_relaxed);
+}
+
+std::vector<float> FLinuxProfiling::GetCpuUsagePerCore()
+{
+  std::lock_guard<std::mutex> lock{this->mMutex};
+  return this->mStats.mCpuUsagePerCore;
+}
+
+DLinuxProcessStats FLinuxProfiling::GetProcessStats()
+{
+  std::lock_guard<std::mutex> lock{this->mMutex};
+  return this->mStats;
+}
+
+void FLinuxProfiling::SampleRoutine()
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock{this->mMutex};
+      const auto isStopped = this->mConditionVariable.wait_for(
+        lock, this->mSamplingInterval, 
+        [this] { return this->mIsStopRequested; });
+      if (isStopped == true) { return; }
+    }
+
+    // Read procfs without lock, and publish result.
+    auto stats = this->Sample();
+    {
+      std::lock_guard<std::mutex> lock{this->mMutex};
+      this->mStats = std::move(stats);
+    }
+  }
+}
+
+DLinuxProcessStats FLinuxProfiling::Sample()
+{
+  DLinuxProcessStats stats;
+
+  // CPU time, page faults, context switches and peak RSS.
+  rusage usage = {};
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    const auto cpuSeconds = ToSeconds(usage.ru_utime, usage.ru_stime);
+    const auto wallSeconds = std::chrono::duration<double>(now - this->mLastSampleTime).count();
+    if (wallSeconds > 0.0)
+    {
+      stats.mCpuUsage = float((cpuSeconds - this->mLastCpuSeconds) / wallSeconds / this->mNumProcessors * 100.0);
+    }
+    this->mLastCpuSeconds = cpuSeconds;
+    this->mLastSampleTime = now;
+
+    // ru_maxrss is kilobyte unit on Linux.
+    stats.mPeakRss                    = uint64_t(usage.ru_maxrss) * 1024;
+    stats.mMinorPageFaults            = uint64_t(usage.ru_minflt);
+    stats.mMajorPageFaults            = uint64_t(usage.ru_majflt);
+    stats.mVoluntaryContextSwitches   = uint64_t(usage.ru_nvcsw);
+    stats.mInvoluntaryContextSwitches = uint64_t(usage.ru_nivcsw);
+  }
+
+  // Resident pages are the second field of statm.
+  char buffer[256];
+  if (ReadProcFile("/proc/self/statm", buffer, sizeof(buffer)) == true)
+  {
+    unsigned long long size = 0, resident = 0;
+    if (std::sscanf(buffer, "%llu %llu", &size, &resident) == 2)
+    {
+      stats.mRss = uint64_t(resident) * uint64_t(this->mPageSize);
+    }
+  }
+
+  stats.mThreads = this->SampleThreads();
+  stats.mCpuUsagePerCore = this->SampleCores();
+
+  this->mCpuUsage.store(stats.mCpuUsage, std::memory_order_relaxed);
+  this->mRamUsage.store(stats.mRss, std::memory_order_relaxed);
+  return stats;
+}
+
+std::vector<DLinuxThreadStats> FLinuxProfiling::SampleThreads() const
+{
+  std::vector<DLinuxThreadStats> threads;
+
+  DIR* pDirectory = opendir("/proc/self/task");
+  if (pDirectory == nullptr) { return threads; }
+
+  while (const dirent* pEntry = readdir(pDirectory))
+  {
+    if (pEntry->d_name[0] == '.') { continue; }
+
+    char path[300];
+    std::snprintf(path, sizeof(path), "/proc/self/task/%s/stat", pEntry->d_name);
+
+    char buffer[1024];
+    if (ReadProcFile(path, buffer, sizeof(buffer)) == false) { continue; }
+
+    // Format is "tid (comm) state ...". comm can have spaces and parentheses, so find the last ')'.
+    const char* pOpen = std::strchr(buffer, '(');
+    const char* pClose = std::strrchr(buffer, ')');
+    if (pOpen == nullptr || pClose == nullptr || pClose < pOpen) { continue; }
+
+    // utime and stime are the 12th and 13th fields after comm and state.
+    unsigned long long userTicks = 0, systemTicks = 0;
+    const auto count = std::sscanf(
+      pClose + 2, 
+      "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", 
+      &userTicks, &systemTicks);
+    if (count != 2) { continue; }
+
+    DLinuxThreadStats thread;
+    thread.mThreadId = std::atoi(pEntry->d_name);
+    thread.mName.assign(pOpen + 1, pClose);
+    thread.mCpuSeconds = double(userTicks + systemTicks) / double(this->mClockTicksPerSecond);
+    threads.emplace_back(std::move(thread));
+  }
+
+  closedir(pDirectory);
+  return threads;
+}
+
+std::vector<float> FLinuxProfiling::SampleCores()
+{
+  std::vector<float> usages;
+
+  FILE* pFile = std::fopen("/proc/stat", "r");
+  if (pFile == nullptr) { return usages; }
+
+  std::vector<std::pair<uint64_t, uint64_t>> coreTicks;
+  char line[512];
+  while (std::fgets(line, sizeof(line), pFile) != nullptr)
+  {
+    // Only "cpuN ..." lines are needed. "cpu ..." line is sum of all cores.
+    if (std::strncmp(line, "cpu", 3) != 0) { break; }
+    if (line[3] < '0' || line[3] > '9') { continue; }
+
+    unsigned long long user = 0, nice = 0, system = 0, idle = 0;
+    unsigned long long ioWait = 0, irq = 0, softIrq = 0, steal = 0;
+    const auto count = std::sscanf(
+      line, 
+      "%*s %llu %llu %llu %llu %llu %llu %llu %llu", 
+      &user, &nice, &system, &idle, &ioWait, &irq, &softIrq, &steal);
+    if (count < 4) { continue; }
+
+    const auto idleTicks = uint64_t(idle + ioWait);
+    const auto totalTicks = uint64_t(user + nice + system + idle + ioWait + irq + softIrq + steal);
+    coreTicks.emplace_back(idleTicks, totalTicks);
+  }
+  std::fclose(pFile);
+
+  // Cores can be changed by hotplug, so compare only when the number of cores is same.
+  usages.resize(coreTicks.size(), 0.0f);
+  if (coreTicks.size() == this->mLastCoreTicks.size())
+  {
+    for (std::size_t i = 0; i < coreTicks.size(); ++i)
+    {
+      const auto idleDelta = coreTicks[i].first - this->mLastCoreTicks[i].first;
+      const auto totalDelta = coreTicks[i].second - this->mLastCoreTicks[i].second;
+      if (totalDelta == 0) { continue; }
+
+      usages[i] = float(double(totalDelta - std::min(idleDelta, totalDelta)) / double(totalDelta) * 100.0);
+    }
+  }
+
+  this->mLastCoreTicks = std::move(coreTicks);
+  return usages;
+}
+
+} /// ::dy namespace
@@ -14,6 +14,8 @@
 
 #include <AProfilingBase.h>
 #include <Windows.h>
+#include <utility>
+#include <vector>
 
 namespace dy
 {
@@ -30,12 +32,19 @@ public:
   /// @brief Get ram usage as byte unit.
   uint64_t GetRamUsage() override final;
 
+  /// @brief Get cpu usage of each logical core as percentage.
+  /// Usage is calculated from processor times difference since the last call.
+  std::vector<float> GetCpuUsagePerCore() override final;
+
 private:
   ULARGE_INTEGER mLastCpu;
   ULARGE_INTEGER mLastSysCpu;
   ULARGE_INTEGER mLastUserCpu;
   int            mNumProcessors = 0;
   HANDLE         mSelf = nullptr;
+
+  /// @brief Idle and total times of each core of the last call.
+  std::vector<std::pair<uint64_t, uint64_t>> mLastCoreTimes;
 };
 
 } /// ::dy namespace
\ No newline at end of file
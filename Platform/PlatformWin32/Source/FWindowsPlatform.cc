@@ -29,6 +29,7 @@
 #include <StringUtil/XUtility.h>
 
 #include <atlconv.h>
+#include <timeapi.h> // timeBeginPeriod, timeEndPeriod
 
 #define IS_32
 #include <Dbt.h> // DEV_BROADCAST_DEVICEINTERFACE_W ... HID devices.
@@ -597,6 +598,9 @@ bool FWindowsPlatform::InitPlatform()
 {
   platform = this;
 
+  // Request 1ms timer resolution, so frame pacing sleep does not overshoot by 15.6ms.
+  timeBeginPeriod(1);
+
   if (this->RegisterWindowClassWin32() == false) { return false; }
 
   if (this->CreateBackgroundWindow() == false) { return false; }
@@ -692,6 +696,7 @@ bool FWindowsPlatform::ReleasePlatform()
   if (this->UnregisterWindowClassWin32() == false) { return false; }
 
   platform = nullptr;
+  timeEndPeriod(1);
   PostQuitMessage(0);
 
   return true;
@@ -14,10 +14,28 @@
 /// Header file
 #include <FWindowsProfiling.h>
 
+#include <algorithm>
 #include <Windows.h>
 #include <Psapi.h>
 #include <strsafe.h>
 #include <atlconv.h>
+#include <winternl.h>
+
+namespace
+{
+
+/// @brief Function type of NtQuerySystemInformation of ntdll.
+using TNtQuerySystemInformation = NTSTATUS (NTAPI*)(SYSTEM_INFORMATION_CLASS, PVOID, ULONG, PULONG);
+
+/// @brief Get NtQuerySystemInformation from ntdll without linking ntdll.lib.
+TNtQuerySystemInformation GetNtQuerySystemInformation()
+{
+  static const auto function = reinterpret_cast<TNtQuerySystemInformation>(
+    GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQuerySystemInformation"));
+  return function;
+}
+
+} /// ::anonymous namespace
 
 namespace dy
 {
@@ -73,4 +91,45 @@ uint64_t FWindowsProfiling::GetRamUsage()
   return pmc.WorkingSetSize;
 }
 
+std::vector<float> FWindowsProfiling::GetCpuUsagePerCore()
+{
+  const auto pQuery = GetNtQuerySystemInformation();
+  if (pQuery == nullptr) { return {}; }
+
+  std::vector<SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION> infos(this->mNumProcessors);
+  const auto byteSize = ULONG(sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION) * infos.size());
+  ULONG returnedSize = 0;
+  const auto status = pQuery(
+    SystemProcessorPerformanceInformation, 
+    infos.data(), byteSize, &returnedSize);
+  if (status < 0) { return {}; }
+  infos.resize(returnedSize / sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION));
+
+  // Kernel time includes idle time.
+  std::vector<std::pair<uint64_t, uint64_t>> coreTimes;
+  coreTimes.reserve(infos.size());
+  for (const auto& info : infos)
+  {
+    coreTimes.emplace_back(
+      uint64_t(info.IdleTime.QuadPart), 
+      uint64_t(info.KernelTime.QuadPart + info.UserTime.QuadPart));
+  }
+
+  std::vector<float> usages(coreTimes.size(), 0.0f);
+  if (coreTimes.size() == this->mLastCoreTimes.size())
+  {
+    for (std::size_t i = 0; i < coreTimes.size(); ++i)
+    {
+      const auto idleDelta = coreTimes[i].first - this->mLastCoreTimes[i].first;
+      const auto totalDelta = coreTimes[i].second - this->mLastCoreTimes[i].second;
+      if (totalDelta == 0) { continue; }
+
+      usages[i] = float(double(totalDelta - (std::min)(idleDelta, totalDelta)) / double(totalDelta) * 100.0);
+    }
+  }
+
+  this->mLastCoreTimes = std::move(coreTimes);
+  return usages;
+}
+
 } /// ::dy namespace
\ No newline at end of file
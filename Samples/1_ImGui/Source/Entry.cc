@@ -95,6 +95,9 @@ int WINAPI WinMain(
   // Create base system.
   platform = std::make_unique<dy::FWindowsPlatform>();
   platform->InitPlatform();
+  // Calibrate profiling clock before the first frame, so the first profiled frame is not stalled.
+  // This thread runs frame loop, so it is also bound as frame thread of profiler here.
+  MTimeChecker::Initialize();
   platform->CreateConsoleWindow();
   auto optRes = CreateMainWindow("D3D11 1_ImGui", 1280, 720);
   assert(optRes.has_value() == true);
@@ -146,19 +149,10 @@ int WINAPI WinMain(
     d3dDc->OMSetBlendState(bBS.GetPtr(), blendFactor, 0xFFFFFFFF);
   }
 
-  // Make timestamp queries (disjoint and start-end queries)
-  // https://docs.microsoft.com/ko-kr/windows/desktop/api/d3d11/nf-d3d11-id3d11device-createquery
-  IComOwner<ID3D11Query> ownDisjointQuery       = nullptr;
-  IComOwner<ID3D11Query> ownGpuStartFrameQuery  = nullptr; 
-  IComOwner<ID3D11Query> ownGpuEndFrameQuery    = nullptr;
   {
     auto bDevice = MD3D11Resources::GetDevice(defaults.mDevice);
     auto d3dDc   = MD3D11Resources::GetDeviceContext(defaults.mDevice);
 
-    ownDisjointQuery       = *FD3D11Factory::CreateTimestampQuery(bDevice.GetRef(), true);
-    ownGpuStartFrameQuery  = *FD3D11Factory::CreateTimestampQuery(bDevice.GetRef(), false);
-    ownGpuEndFrameQuery    = *FD3D11Factory::CreateTimestampQuery(bDevice.GetRef(), false);
-
     // Setup Dear ImGui context
     MGuiManager::Initialize(
       [&]()
@@ -212,9 +206,9 @@ int WINAPI WinMain(
         bgCol = bgModel.mBackgroundColor; 
       }
 
-      TIME_CHECK_D3D11_STALL(gpuTime, "GpuFrame", *ownDisjointQuery.GetPtr(), d3dDc.GetRef());
+      TIME_CHECK_D3D11(gpuTime, "GpuFrame", defaults.mDevice);
       {
-        TIME_CHECK_FRAGMENT(gpuTime, "Overall", *ownGpuStartFrameQuery.GetPtr(), *ownGpuEndFrameQuery.GetPtr());
+        TIME_CHECK_FRAGMENT(gpuTime, "Overall");
 
         d3dDc->ClearRenderTargetView(bRTV.GetPtr(), std::array<FLOAT, 4>{bgCol.X, bgCol.Y, bgCol.Z, 1}.data());
         d3dDc->ClearDepthStencilView(bDSV.GetPtr(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
@@ -227,6 +221,7 @@ int WINAPI WinMain(
   }
 
   MGuiManager::Shutdown();
+  MTimeChecker::ReleaseD3D11Queries();
   {
     const auto flag = MD3D11Resources::RemoveDefaultFrameBufferResouce(*optDefaults);
     assert(flag == true);
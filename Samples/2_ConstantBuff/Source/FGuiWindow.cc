@@ -13,9 +13,32 @@
 
 #include <FGuiWindow.h>
 
+#include <cfloat>
+#include <cstdio>
 #include <imgui.h>
+#include <Profiling/MMetrics.h>
 #include <Profiling/MTimeChecker.h>
-#include <XPlatform.h>
+
+namespace
+{
+
+/// @brief Render sampled history of metric as plot, and the latest value as overlay.
+/// Values are multiplied by scale to be shown as given unit.
+void RenderMetricPlot(const char* metricName, float scale, const char* unit)
+{
+  const auto optId = MMetrics::FindMetric(metricName);
+  if (optId.has_value() == false) { return; }
+
+  auto history = MMetrics::GetHistory(*optId);
+  for (auto& value : history) { value *= scale; }
+  const float latest = history.empty() == true ? 0.0f : history.back();
+
+  char overlay[64];
+  std::snprintf(overlay, sizeof(overlay), "%.2f %s", latest, unit);
+  ImGui::PlotLines(metricName, history.data(), int(history.size()), 0, overlay, 0.0f, FLT_MAX, {0.0f, 40.0f});
+}
+
+} /// ::anonymous namespace
 
 FGuiWindow::FGuiWindow(DModelWindow& mModel)
 {
@@ -41,16 +64,15 @@ void FGuiWindow::Render()
   //! Profiling
   //!
 
-  ImGui::Text("CPU Usage : ");
-  ImGui::SameLine();
-  ImGui::ProgressBar(platform->GetProfilingManager().GetCpuUsage() / 500.0f);
+  // Metrics are sampled by MMetrics sampler, so OS is not called every frame.
+  RenderMetricPlot("CPU Usage", 1.0f, "%");
 
   auto& cpuFrame = MTimeChecker::Get("CpuFrame");
   ImGui::Text("CPU Frame : %.3f ms/frame",      cpuFrame.GetRecent().count() * 1000.0);
   ImGui::Text("CPU Average : %.3f ms/50 frame", cpuFrame.GetAverage().count() * 1000.0);
 
-  const float ramMBUsage = platform->GetProfilingManager().GetRamUsage() / (1024.0 * 1024.0);
-  ImGui::Text("RAM Usage : %.3f MB", ramMBUsage);
+  RenderMetricPlot("RAM Usage", 1.0f / (1024.0f * 1024.0f), "MB");
+  RenderMetricPlot("Draw Calls", 1.0f, "/frame");
 
   const auto& gpuFrame = MTimeChecker::GetGpuD3D11("GpuFrame");
   if (gpuFrame.HasFragment("Overall") == true)
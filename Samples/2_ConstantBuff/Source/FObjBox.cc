@@ -15,6 +15,7 @@
 #include <Graphics/MD3D11Resources.h>
 #include <Resource/D11DefaultHandles.h>
 #include <Math/Utility/XGraphicsMath.h>
+#include <Profiling/MMetrics.h>
 #include <MGuiManager.h>
 #include <FGuiWindow.h>
 #include <XBuffer.h>
@@ -139,4 +140,5 @@ void FObjBox::Render()
   (*this->mDc)->IASetVertexBuffers(0, 1, &pVBuffer, &stride, &offset);
   (*this->mDc)->IASetIndexBuffer((*mIBuffer).GetPtr(), DXGI_FORMAT_R32_UINT, 0);
   (*this->mDc)->DrawIndexed(36, 0, 0);
+  MMetrics::CountDrawCall();
 }
@@ -15,6 +15,7 @@
 #include <Graphics/MD3D11Resources.h>
 #include <Resource/D11DefaultHandles.h>
 #include <Math/Utility/XGraphicsMath.h>
+#include <Profiling/MMetrics.h>
 #include <MGuiManager.h>
 #include <FGuiWindow.h>
 #include <XBuffer.h>
@@ -124,4 +125,5 @@ void FObjTriangle::Render()
   (*this->mDc)->IASetVertexBuffers(0, 1, &pVBuffer, &stride, &offset);
   (*this->mDc)->IASetIndexBuffer((*mIBuffer).GetPtr(), DXGI_FORMAT_R32_UINT, 0);
   (*this->mDc)->DrawIndexed(3, 0, 0);
+  MMetrics::CountDrawCall();
 }
@@ -26,6 +26,7 @@
 #include <ComWrapper/IComOwner.h>
 #include <ComWrapper/IComBorrow.h>
 #include <FD3D11Factory.h>
+#include <Profiling/MMetrics.h>
 #include <Profiling/MTimeChecker.h>
 #include <MGuiManager.h>
 #include <XCBuffer.h>
@@ -33,6 +34,7 @@
 #include <StringUtil/XUtility.h>
 #include <FGuiWindow.h>
 
+#include <FFrameLoop.h>
 #include <FWindowsPlatform.h>
 #include <PLowInputMousePos.h>
 #include <XPlatform.h>
@@ -54,6 +56,12 @@ int WINAPI WinMain(
   // Create base system.
   platform = std::make_unique<dy::FWindowsPlatform>();
   platform->InitPlatform();
+  // Calibrate profiling clock before the first frame, so the first profiled frame is not stalled.
+  // This thread runs frame loop, so it is also bound as frame thread of profiler here.
+  MTimeChecker::Initialize();
+  // Sample metrics on background thread, so GUI reads history instead of calling OS every frame.
+  MMetrics::RegisterDefaultMetrics(platform->GetProfilingManager());
+  MMetrics::StartSampling();
 #if defined(_DEBUG)
   platform->CreateConsoleWindow();
 #endif
@@ -150,16 +158,6 @@ int WINAPI WinMain(
     MD3D11Resources::RemoveBlob(*optPSBlob);
   }
 
-  //!
-  //! Create Queries
-  //!
-
-  // Make timestamp queries (disjoint and start-end queries)
-  // https://docs.microsoft.com/ko-kr/windows/desktop/api/d3d11/nf-d3d11-id3d11device-createquery
-  auto handleDisjoint = *MD3D11Resources::CreateQuerySimple(defaults.mDevice, E11SimpleQueryType::TimeStampDisjoint);
-  auto [handleFrameStart, handleFrameEnd] = *FD3D11Factory::CreateTimestampQueryPair2(defaults.mDevice);
-  auto [handleDrawStart, handleDrawEnd] = *FD3D11Factory::CreateTimestampQueryPair2(defaults.mDevice);
-
   //!
   //! Set initial settings.
   //!
@@ -240,12 +238,6 @@ int WINAPI WinMain(
     auto bVS          = MD3D11Resources::GetVertexShader(handleVS);
     auto bPS          = MD3D11Resources::GetPixelShader(handlePS);
 
-    auto bDisjoint    = MD3D11Resources::GetQuery(handleDisjoint);
-    auto bFrameStart  = MD3D11Resources::GetQuery(handleFrameStart);
-    auto bFrameEnd    = MD3D11Resources::GetQuery(handleFrameEnd);
-    auto bDrawStart   = MD3D11Resources::GetQuery(handleDrawStart);
-    auto bDrawEnd     = MD3D11Resources::GetQuery(handleDrawEnd);
-
     auto bSwapCHain   = MD3D11Resources::GetSwapChain(defaults.mSwapChain);
 
     DObjBox paramTriangle = {&defaults, &hCbObject};
@@ -254,41 +246,53 @@ int WINAPI WinMain(
     DObjCamera paramCamera = {&defaults, &hCbViewProj};
     FObjCamera camera{};      camera.Initialize(&paramCamera);
 
+    // Simulate with fixed step, and cap frame rate not to spin CPU.
+    dy::PFrameLoopDescriptor loopDesc;
+    loopDesc.mMaxFrameRate = 120.0;
+    dy::FFrameLoop frameLoop{loopDesc};
+
     // Loop
     while (platform->CanShutdown() == false)
     {
-      // Update Routine
-      TIME_CHECK_CPU("CpuFrame");
-      platform->PollEvents();
-      MGuiManager::Update();
-
-      triangle.Update(0);
-      camera.Update(0);
-
-      // Render Routine
-      TIME_CHECK_D3D11_STALL(gpuTime, "GpuFrame", bDisjoint.GetRef(), d3dDc.GetRef());
+      frameLoop.BeginFrame();
       {
-        // https://bell0bytes.eu/shader-data/
-        TIME_CHECK_FRAGMENT(gpuTime, "Overall", bFrameStart.GetRef(), bFrameEnd.GetRef());
-
-        d3dDc->ClearRenderTargetView(bRTV.GetPtr(), std::array<FLOAT, 4>{0, 0, 0, 1}.data());
-        d3dDc->ClearDepthStencilView(bDSV.GetPtr(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+        // Update Routine
+        TIME_CHECK_CPU("CpuFrame");
+        platform->PollEvents();
+        MGuiManager::Update();
 
-        d3dDc->VSSetShader(bVS.GetPtr(), nullptr, 0);
-        d3dDc->PSSetShader(bPS.GetPtr(), nullptr, 0);
-
-        // Render objects
+        while (frameLoop.StepFixed() == true)
         {
-          TIME_CHECK_FRAGMENT(gpuTime, "Draw", bDrawStart.GetRef(), bDrawEnd.GetRef());
-          triangle.Render();
-          camera.Render();
+          triangle.Update(frameLoop.GetFixedStep());
+          camera.Update(frameLoop.GetFixedStep());
         }
 
-        // Render GUI items.
-        MGuiManager::Render();
-        // Present the back buffer to the screen.
-        HR(bSwapCHain->Present(0, 0));
+        // Render Routine
+        TIME_CHECK_D3D11(gpuTime, "GpuFrame", defaults.mDevice);
+        {
+          // https://bell0bytes.eu/shader-data/
+          TIME_CHECK_FRAGMENT(gpuTime, "Overall");
+
+          d3dDc->ClearRenderTargetView(bRTV.GetPtr(), std::array<FLOAT, 4>{0, 0, 0, 1}.data());
+          d3dDc->ClearDepthStencilView(bDSV.GetPtr(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+
+          d3dDc->VSSetShader(bVS.GetPtr(), nullptr, 0);
+          d3dDc->PSSetShader(bPS.GetPtr(), nullptr, 0);
+
+          // Render objects
+          {
+            TIME_CHECK_FRAGMENT(gpuTime, "Draw");
+            triangle.Render();
+            camera.Render();
+          }
+
+          // Render GUI items.
+          MGuiManager::Render();
+          // Present the back buffer to the screen.
+          HR(bSwapCHain->Present(0, 0));
+        }
       }
+      frameLoop.EndFrame();
     }
 
     camera.Release(nullptr);
@@ -298,13 +302,8 @@ int WINAPI WinMain(
   MGuiManager::Shutdown();
   
   // Remove all resources.
-  {
-    MD3D11Resources::RemoveQuery(handleFrameStart);
-    MD3D11Resources::RemoveQuery(handleFrameEnd);
-    MD3D11Resources::RemoveQuery(handleDrawStart);
-    MD3D11Resources::RemoveQuery(handleDrawEnd);
-    MD3D11Resources::RemoveQuery(handleDisjoint);
-  }
+  MMetrics::StopSampling();
+  MTimeChecker::ReleaseD3D11Queries();
   {
     const auto flag = MD3D11Resources::RemovePixelShader(handlePS);
     assert(flag == true);
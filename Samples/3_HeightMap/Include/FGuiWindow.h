@@ -26,6 +26,12 @@ public:
 
   std::array<int, 2> mTerrainGrid = {8, 8};
   std::array<int, 2> mTerrainFragment = {2, 2};
+  int mTerrainSeed = 0;
+
+  bool mStreamTerrain = false;
+  float mTravelSpeed = 8.0f;
+  int mStreamRadius = 2;
+  int mStreamBudget = 16;
 };
 
 class FGuiWindow final : public IGuiFrameModel<DModelWindow>
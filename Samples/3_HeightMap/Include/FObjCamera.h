@@ -35,10 +35,23 @@ public:
   void Update(float delta) override final;
   void Render() override final;
 
+  /// @brief Interpolate view between previous and present fixed step state with given alpha [0, 1],
+  /// and update constant buffer. This must be called before rendering objects using view & projection.
+  void Interpolate(float alpha);
+
+  /// @brief Get world position of camera.
+  [[nodiscard]] const DVector3<TReal>& GetPosition() const noexcept;
+
 private:
   DVector3<TReal> mPosition = {0, 0, 10};
   DVector3<TReal> mUp       = {0, 1, 0};
   DVector3<TReal> mLookAt   = {0, 0, 0};
+  /// Orbit position of camera around travelled point.
+  DVector3<TReal> mOrbit    = {0, 0, 10};
+  /// Travelled distance along world X axis while terrain is streamed.
+  TReal mTravel = 0;
+  /// Travelled distance of previous fixed step.
+  TReal mPrevTravel = 0;
 
   DCbViewProj mCbViewProj;
   D11HandleBuffer hCbViewProj = nullptr;
@@ -12,6 +12,9 @@
 /// SOFTWARE.
 ///
 
+#include <atomic>
+#include <future>
+#include <memory>
 #include <optional>
 #include <D3D11.h>
 
@@ -20,9 +23,14 @@
 #include <Resource/DD3D11Handle.h>
 #include <ComWrapper/IComBorrow.h>
 #include <XCBuffer.h>
+#include <MRandomMap.h>
+#include <FTerrainTileCache.h>
 
 using namespace ::dy::math;
 
+class DModelWindow;
+class FObjCamera;
+
 /// @class FObjTerrain
 /// @brief Terrain object
 class FObjTerrain final : public AObject
@@ -37,24 +45,54 @@ public:
   void Update(float delta) override final;
   void Render() override final;
 
+  /// @brief Interpolate rotation between previous and present fixed step state with given alpha [0, 1].
+  /// Render draws interpolated state.
+  void Interpolate(float alpha) noexcept;
+
 private:
+  /// @brief Queue map regeneration to background when terrain settings of model are changed.
+  /// Previous request is cancelled if it is not finished yet.
+  void RequestMeshIfChanged(const DModelWindow& model);
+  /// @brief Replace height buffer, and topology buffers if size is changed, with requested mesh if it is ready.
+  /// Previous mesh is drawn until then.
+  void SwapMeshIfReady();
+  /// @brief Create, recreate or release tile cache by streaming settings of model,
+  /// and stream tiles around camera.
+  void UpdateTileCache(const DModelWindow& model);
+  /// @brief Set object matrix, and draw mesh of given buffers.
+  void DrawMesh(
+    const DVector3<TReal>& position, const DVector3<TReal>& degRotate,
+    ID3D11Buffer* pPositionBuffer, ID3D11Buffer* pHeightBuffer, ID3D11Buffer* pIndexBuffer, UINT indexCount);
+
   DVector3<TReal> mPosition   = {-4, -2, -4};
   DVector3<TReal> mDegRotate  = {90, 0, 0};
+  DVector3<TReal> mPrevDegRotate = {90, 0, 0};
+  DVector3<TReal> mRenderDegRotate = {90, 0, 0};
   DVector3<TReal> mScale      = {1, 1, 1};
 
-  D11HandleBuffer hVBuffer  = nullptr;
-  D11HandleBuffer hIBuffer  = nullptr;
+  D11HandleBuffer hHeightBuffer = nullptr;
   D11HandleBuffer hCbObject = nullptr;
   DCbObject init;
 
   std::optional<IComBorrow<ID3D11DeviceContext>> mDc;
-  std::optional<IComBorrow<ID3D11Buffer>> mVBuffer;
+  std::optional<IComBorrow<ID3D11Buffer>> mPositionBuffer;
+  std::optional<IComBorrow<ID3D11Buffer>> mHeightBuffer;
   std::optional<IComBorrow<ID3D11Buffer>> mIBuffer;
   std::optional<IComBorrow<ID3D11Buffer>> mCbObject;
 
   std::array<int, 2> mTerrainGrid = {0, 0};
   std::array<int, 2> mTerrainFragment = {0, 0};
+  int mTerrainSeed = 0;
+
+  std::future<std::optional<DRandomMapMesh>> mPendingMesh;
+  std::shared_ptr<std::atomic<bool>> mPendingCancelled = nullptr;
+  std::shared_ptr<const DRandomMapTopology> mTopology = nullptr;
+  UINT mIndexCount = 0;
   D11HandleDevice hDevice = nullptr;
+
+  std::optional<FTerrainTileCache> mTileCache;
+  PTerrainTileDescriptor mTileDesc;
+  const FObjCamera* mpCamera = nullptr;
 };
 
 class D11DefaultHandles;
@@ -63,5 +101,7 @@ class DObjTerrain final
 public:
   D11DefaultHandles*  mpData = nullptr;
   D11HandleBuffer*    mpCbObject = nullptr;
+  /// Terrain tiles are streamed around this camera. Can be null.
+  const FObjCamera*   mpCamera = nullptr;
 };
 
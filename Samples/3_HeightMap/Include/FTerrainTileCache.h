@@ -0,0 +1,139 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <D3D11.h>
+#include <Resource/DD3D11Handle.h>
+#include <ComWrapper/IComBorrow.h>
+#include <MRandomMap.h>
+
+/// @struct PTerrainTileDescriptor
+/// @brief Descriptor of terrain tile cache.
+struct PTerrainTileDescriptor final
+{
+  /// Grid cell count of each axis of tile.
+  std::size_t mTileCells = 4;
+  /// Sample count of each axis of each grid cell.
+  std::size_t mFragment = 8;
+  /// Tiles within this distance (in tiles) from focus tile are visible, and requested.
+  int mViewRadius = 2;
+  /// Resident tiles which are not visible are kept until total bytes exceed this budget.
+  std::size_t mMemoryBudget = 64 * 1024 * 1024;
+  /// The maximum number of tiles which are generated at once. Nearer tiles are requested first.
+  std::size_t mMaxPendingTiles = 4;
+  std::uint32_t mSeed = 0;
+};
+
+/// @class FTerrainTileCache
+/// @brief Streams fixed-size tiles of unbounded terrain around focus point.
+///
+/// Visible tiles around focus are generated in background by MRandomMap::RequestTile.
+/// Resident tiles are kept in LRU order, and the least recently visible tiles are evicted 
+/// when resident bytes exceed memory budget. Tiles farther than twice of view radius are evicted immediately, 
+/// and requests of tiles which become invisible are cancelled.
+/// All tiles share one topology, so each tile only owns its height buffer.
+/// This class must be used by render thread.
+class FTerrainTileCache final
+{
+public:
+  using TTileCoord = std::array<int, 2>;
+
+  /// @struct DDrawTile
+  /// @brief Buffers and placement of resident tile to draw.
+  struct DDrawTile final
+  {
+    TTileCoord mCoord;
+    ID3D11Buffer* mPositionBuffer;
+    ID3D11Buffer* mHeightBuffer;
+    ID3D11Buffer* mIndexBuffer;
+    UINT mIndexCount;
+  };
+
+  FTerrainTileCache(const D11HandleDevice& device, const PTerrainTileDescriptor& desc);
+  ~FTerrainTileCache();
+
+  FTerrainTileCache(const FTerrainTileCache&) = delete;
+  FTerrainTileCache& operator=(const FTerrainTileCache&) = delete;
+
+  /// @brief Get size of tile along each axis, in vertex units.
+  [[nodiscard]] float GetTileSize() const noexcept;
+
+  /// @brief Collect finished tiles, evict far or least recently visible tiles, 
+  /// and request missing visible tiles around focus.
+  /// @param focusX Focus position along tile x axis, in vertex units.
+  /// @param focusY Focus position along tile y axis, in vertex units.
+  void Update(float focusX, float focusY);
+
+  /// @brief Call function with each resident visible tile.
+  void ForEachVisibleTile(const std::function<void(const DDrawTile&)>& function);
+
+  /// @brief Get the number of resident tiles.
+  [[nodiscard]] std::size_t GetResidentCount() const noexcept;
+  /// @brief Get the number of tiles being generated.
+  [[nodiscard]] std::size_t GetPendingCount() const noexcept;
+  /// @brief Get GPU bytes of heights of resident tiles. Shared topology is not counted.
+  [[nodiscard]] std::size_t GetResidentBytes() const noexcept;
+
+private:
+  /// @struct DTile
+  /// @brief Resident tile, which has height buffer.
+  struct DTile final
+  {
+    TTileCoord mCoord;
+    D11HandleBuffer hHeightBuffer = nullptr;
+    std::optional<IComBorrow<ID3D11Buffer>> mHeightBuffer;
+    std::optional<IComBorrow<ID3D11Buffer>> mPositionBuffer;
+    std::optional<IComBorrow<ID3D11Buffer>> mIndexBuffer;
+    std::shared_ptr<const DRandomMapTopology> mTopology = nullptr;
+    std::size_t mBytes = 0;
+    std::list<std::uint64_t>::iterator mLruIt;
+  };
+
+  /// @struct DPendingTile
+  /// @brief Tile being generated in background.
+  struct DPendingTile final
+  {
+    std::future<std::optional<DRandomMapMesh>> mMesh;
+    std::shared_ptr<std::atomic<bool>> mCancelled = nullptr;
+  };
+
+  /// @brief Get key of tile coordinate.
+  [[nodiscard]] static std::uint64_t ToKey(const TTileCoord& coord) noexcept;
+  /// @brief Check tile is within distance (in tiles) from focus tile.
+  [[nodiscard]] bool IsWithin(const TTileCoord& coord, int distance) const noexcept;
+
+  /// @brief Create height buffer of finished tile and make it resident.
+  /// @return If buffers of tile can not be created, return false and tile is not added.
+  bool AddResidentTile(const TTileCoord& coord, DRandomMapMesh& mesh);
+  /// @brief Release buffers of resident tile. Iterator is invalidated.
+  void EvictTile(std::unordered_map<std::uint64_t, DTile>::iterator it);
+
+  D11HandleDevice hDevice = nullptr;
+  PTerrainTileDescriptor mDesc;
+  TTileCoord mFocusTile = {0, 0};
+
+  std::unordered_map<std::uint64_t, DTile> mTiles;
+  std::unordered_map<std::uint64_t, DPendingTile> mPendingTiles;
+  /// Keys of resident tiles, from the most recently visible one.
+  std::list<std::uint64_t> mLru;
+  std::size_t mResidentBytes = 0;
+};
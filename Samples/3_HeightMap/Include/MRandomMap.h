@@ -13,31 +13,82 @@
 ///
 
 #include <array>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
-#include <Math/Type/Math/DVector3.h>
-#include <Math/Type/Micellanous/DDynamicGrid2D.h>
+#include <Math/Type/Math/DVector2.h>
 
 using namespace ::dy::math;
 
+/// @struct DRandomMapTopology
+/// @brief Grid positions and indice buffer of map, which only depend on map size.
+/// Topology is shared by all maps of same size, and never modified after creation.
+struct DRandomMapTopology final
+{
+  std::size_t mColumnSize = 0;
+  std::size_t mRowSize = 0;
+  /// Row-major XY position of each vertex.
+  std::vector<DVector2<TReal>> mPositions;
+  std::vector<unsigned> mIndices;
+};
+
+/// @struct DRandomMapMesh
+/// @brief Generated map. Only heights are unique to each map.
+struct DRandomMapMesh final
+{
+  /// Row-major height of each vertex of topology.
+  std::vector<float> mHeights;
+  std::shared_ptr<const DRandomMapTopology> mTopology = nullptr;
+};
+
 /// @class MRandomMap
 /// @brief Random map orginizer.
 class MRandomMap final
 {
 public:
-  static void MakeMap(const std::array<int, 2>& grid, std::size_t fragment);
+  /// @brief Make mesh of grid on calling thread. Rows are generated in parallel,
+  /// but same seed always makes same map regardless of thread count.
+  /// @return Mesh, or nullopt if cancelled is set before generation is finished.
+  [[nodiscard]] static std::optional<DRandomMapMesh> 
+  MakeMap(
+    const std::array<int, 2>& grid, std::size_t fragment, std::uint32_t seed, 
+    const std::atomic<bool>& cancelled);
+
+  /// @brief Queue MakeMap to background worker and return future of result.
+  /// Setting cancelled stops generation at the next row block.
+  [[nodiscard]] static std::future<std::optional<DRandomMapMesh>> 
+  RequestMap(
+    const std::array<int, 2>& grid, std::size_t fragment, std::uint32_t seed, 
+    std::shared_ptr<std::atomic<bool>> cancelled);
+
+  /// @brief Make mesh of one tile of unbounded map on calling thread.
+  /// Tile (x, y) covers grid cells [x * tileCells, (x + 1) * tileCells) of each axis, 
+  /// and has one more sample row and column than its cells, which is the first sample of next tile.
+  /// Gradients of grid nodes are hashed from node position and seed, so adjacent tiles join without seam.
+  /// @return Mesh, or nullopt if cancelled is set before generation is finished.
+  [[nodiscard]] static std::optional<DRandomMapMesh> 
+  MakeTile(
+    const std::array<int, 2>& tile, std::size_t tileCells, std::size_t fragment, std::uint32_t seed, 
+    const std::atomic<bool>& cancelled);
 
-  static const auto& TempGetVertexBuffer()
-  {
-    return mVertexBuffer2;
-  }
+  /// @brief Queue MakeTile to background worker and return future of result.
+  [[nodiscard]] static std::future<std::optional<DRandomMapMesh>> 
+  RequestTile(
+    const std::array<int, 2>& tile, std::size_t tileCells, std::size_t fragment, std::uint32_t seed, 
+    std::shared_ptr<std::atomic<bool>> cancelled);
 
-  static const auto& TempGetIndiceBuffer()
-  {
-    return mIndiceBuffer;
-  }
+  /// @brief Get topology of given size from cache, or build it if there is no map of that size alive.
+  /// This function is thread-safe.
+  [[nodiscard]] static std::shared_ptr<const DRandomMapTopology> 
+  GetTopology(std::size_t columnSize, std::size_t rowSize);
 
 private:
-  static DDynamicGrid2D<float> mHeightMap2;
-  static DDynamicGrid2D<DVector3<TReal>> mVertexBuffer2;
-  static std::vector<unsigned> mIndiceBuffer;
-};
\ No newline at end of file
+  static std::mutex mTopologyMutex;
+  /// Topologies are weakly cached, so topology is released with the last map using it.
+  static std::unordered_map<std::uint64_t, std::weak_ptr<const DRandomMapTopology>> mTopologies;
+};
@@ -0,0 +1,40 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstddef>
+#include <vector>
+#include <Resource/DD3D11Handle.h>
+
+struct DRandomMapTopology;
+
+/// @struct DTopologyBuffers
+/// @brief GPU position and index buffer of one map topology, shared by all terrains and tiles of same size.
+struct DTopologyBuffers final
+{
+  D11HandleBuffer mPositionBuffer = nullptr;
+  D11HandleBuffer mIndexBuffer = nullptr;
+  std::size_t mRefCount = 0;
+};
+
+/// @brief Get buffers of topology, and create them if nothing uses that topology.
+/// Caller must keep topology alive until it releases buffers. Only called by render thread.
+/// If buffers can not be created, return nullptr and topology is not acquired.
+const DTopologyBuffers* AcquireTopologyBuffers(const D11HandleDevice& device, const DRandomMapTopology& topology);
+
+/// @brief Release buffers of topology when the last user of that topology releases it.
+void ReleaseTopologyBuffers(const DRandomMapTopology& topology);
+
+/// @brief Create height vertex buffer, which can be updated by UpdateSubresource.
+/// If buffer can not be created, return null handle.
+D11HandleBuffer CreateHeightBuffer(const D11HandleDevice& device, const std::vector<float>& heights);
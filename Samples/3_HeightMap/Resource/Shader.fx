@@ -17,7 +17,8 @@ cbuffer cbObject : register(b1)
 
 struct VertexIn
 {
-  float3 Pos : POSITION;
+  float2 Pos : POSITION;
+  float Height : HEIGHT;
 };
 
 struct VertexOut
@@ -35,10 +36,10 @@ VertexOut VS(VertexIn vin)
   vout.PosH = 
     mul(
       mul(
-        mul(float4(vin.Pos.xyz * float3(1, 1, 5), 1.0f), mModelMat)
+        mul(float4(float3(vin.Pos, vin.Height) * float3(1, 1, 5), 1.0f), mModelMat)
         , mViewMat)
       , mProjMat);
-  const float gray = (vin.Pos.z + 1.0f) / 2.0f;
+  const float gray = (vin.Height + 1.0f) / 2.0f;
   vout.Color  = float4(gray, gray, gray, 1.0f);
 
   return vout;
@@ -0,0 +1,278 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <FGradientNoiseKernel.h>
+#include <algorithm>
+#include <cassert>
+
+#if NOISE_KERNEL_AVX2 == 1
+#include <immintrin.h>
+#elif NOISE_KERNEL_SSE == 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+
+/// @brief Calculate offset of each sample in one grid cell, along one axis.
+/// Offsets are accumulated as MRandomMap did, so sample positions are not changed.
+std::vector<float> CalculateFragmentOffsets(std::size_t fragment)
+{
+  const float edgeOffset   = 1 / static_cast<float>(fragment * 2);
+  const float centerOffset = 1 / static_cast<float>(fragment);
+
+  std::vector<float> result(fragment);
+  float pos = 0.0f;
+  for (std::size_t i = 0; i < fragment; ++i)
+  {
+    if (i == 0) { pos += edgeOffset; } else { pos += centerOffset; }
+    result[i] = pos;
+  }
+
+  return result;
+}
+
+/// @brief Calculate cell index and deltas to the nearer and farther node of each sample along one axis.
+void CalculateAxis(
+  std::size_t cellCount, std::size_t fragment,
+  std::vector<std::uint32_t>& outCell, std::vector<float>& outDelta0, std::vector<float>& outDelta1)
+{
+  const auto offsets = CalculateFragmentOffsets(fragment);
+  const auto size = cellCount * fragment;
+  outCell.resize(size);
+  outDelta0.resize(size);
+  outDelta1.resize(size);
+
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    const float pos = static_cast<float>(static_cast<std::int32_t>(i / fragment)) + offsets[i % fragment];
+    const auto cell = (std::min)(static_cast<std::int32_t>(pos), static_cast<std::int32_t>(cellCount - 1));
+
+    outCell[i]   = static_cast<std::uint32_t>(cell);
+    outDelta0[i] = pos - static_cast<float>(cell);
+    outDelta1[i] = pos - static_cast<float>(cell + 1);
+  }
+}
+
+/// @struct DRowInput
+/// @brief Pointers and per-row values consumed by row kernels.
+struct DRowInput final
+{
+  const float* mG00X; const float* mG00Y;
+  const float* mG10X; const float* mG10Y;
+  const float* mG01X; const float* mG01Y;
+  const float* mG11X; const float* mG11Y;
+  const float* mDeltaX0;
+  const float* mDeltaX1;
+  float mDeltaY0;
+  float mDeltaY1;
+};
+
+/// @brief Calculate heights of [begin, end) samples of row one by one.
+void CalculateRowScalar(const DRowInput& in, std::size_t begin, std::size_t end, float* out)
+{
+  const float dy0 = in.mDeltaY0;
+  const float dy1 = in.mDeltaY1;
+  for (std::size_t i = begin; i < end; ++i)
+  {
+    const float dx0 = in.mDeltaX0[i];
+    const float dx1 = in.mDeltaX1[i];
+
+    const float n00 = in.mG00X[i] * dx0 + in.mG00Y[i] * dy0;
+    const float n10 = in.mG10X[i] * dx1 + in.mG10Y[i] * dy0;
+    const float x0  = n00 + (n10 - n00) * dx0;
+
+    const float n01 = in.mG01X[i] * dx0 + in.mG01Y[i] * dy1;
+    const float n11 = in.mG11X[i] * dx1 + in.mG11Y[i] * dy1;
+    const float x1  = n01 + (n11 - n01) * dx0;
+
+    out[i] = x0 + (x1 - x0) * dy0;
+  }
+}
+
+#if NOISE_KERNEL_SSE == 1 || NOISE_KERNEL_AVX2 == 1
+/// @brief Calculate heights of row from `begin`, 4 samples per iteration, and return next index to calculate.
+std::size_t CalculateRowSSE(const DRowInput& in, std::size_t begin, std::size_t size, float* out)
+{
+  const __m128 dy0 = _mm_set1_ps(in.mDeltaY0);
+  const __m128 dy1 = _mm_set1_ps(in.mDeltaY1);
+
+  std::size_t i = begin;
+  for (; i + 4 <= size; i += 4)
+  {
+    const __m128 dx0 = _mm_loadu_ps(in.mDeltaX0 + i);
+    const __m128 dx1 = _mm_loadu_ps(in.mDeltaX1 + i);
+
+    const __m128 n00 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in.mG00X + i), dx0), _mm_mul_ps(_mm_loadu_ps(in.mG00Y + i), dy0));
+    const __m128 n10 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in.mG10X + i), dx1), _mm_mul_ps(_mm_loadu_ps(in.mG10Y + i), dy0));
+    const __m128 x0  = _mm_add_ps(n00, _mm_mul_ps(_mm_sub_ps(n10, n00), dx0));
+
+    const __m128 n01 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in.mG01X + i), dx0), _mm_mul_ps(_mm_loadu_ps(in.mG01Y + i), dy1));
+    const __m128 n11 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in.mG11X + i), dx1), _mm_mul_ps(_mm_loadu_ps(in.mG11Y + i), dy1));
+    const __m128 x1  = _mm_add_ps(n01, _mm_mul_ps(_mm_sub_ps(n11, n01), dx0));
+
+    _mm_storeu_ps(out + i, _mm_add_ps(x0, _mm_mul_ps(_mm_sub_ps(x1, x0), dy0)));
+  }
+
+  return i;
+}
+#endif
+
+#if NOISE_KERNEL_AVX2 == 1
+/// @brief Calculate heights of row from `begin`, 8 samples per iteration, and return next index to calculate.
+/// FMA is not used so result is same to other paths.
+std::size_t CalculateRowAVX2(const DRowInput& in, std::size_t begin, std::size_t size, float* out)
+{
+  const __m256 dy0 = _mm256_set1_ps(in.mDeltaY0);
+  const __m256 dy1 = _mm256_set1_ps(in.mDeltaY1);
+
+  std::size_t i = begin;
+  for (; i + 8 <= size; i += 8)
+  {
+    const __m256 dx0 = _mm256_loadu_ps(in.mDeltaX0 + i);
+    const __m256 dx1 = _mm256_loadu_ps(in.mDeltaX1 + i);
+
+    const __m256 n00 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(in.mG00X + i), dx0), _mm256_mul_ps(_mm256_loadu_ps(in.mG00Y + i), dy0));
+    const __m256 n10 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(in.mG10X + i), dx1), _mm256_mul_ps(_mm256_loadu_ps(in.mG10Y + i), dy0));
+    const __m256 x0  = _mm256_add_ps(n00, _mm256_mul_ps(_mm256_sub_ps(n10, n00), dx0));
+
+    const __m256 n01 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(in.mG01X + i), dx0), _mm256_mul_ps(_mm256_loadu_ps(in.mG01Y + i), dy1));
+    const __m256 n11 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(in.mG11X + i), dx1), _mm256_mul_ps(_mm256_loadu_ps(in.mG11Y + i), dy1));
+    const __m256 x1  = _mm256_add_ps(n01, _mm256_mul_ps(_mm256_sub_ps(n11, n01), dx0));
+
+    _mm256_storeu_ps(out + i, _mm256_add_ps(x0, _mm256_mul_ps(_mm256_sub_ps(x1, x0), dy0)));
+  }
+
+  return i;
+}
+#endif
+
+} /// ::anonymous namespace
+
+FGradientNoiseKernel::FGradientNoiseKernel(
+  std::vector<float> gradientX, std::vector<float> gradientY,
+  std::size_t gridX, std::size_t gridY, std::size_t fragment)
+  : mGradientX{std::move(gradientX)},
+    mGradientY{std::move(gradientY)},
+    mGradientStride{gridX + 1}
+{
+  assert(gridX > 0 && gridY > 0 && fragment > 0);
+  assert(this->mGradientX.size() == (gridX + 1) * (gridY + 1));
+  assert(this->mGradientY.size() == this->mGradientX.size());
+
+  CalculateAxis(gridX, fragment, this->mColumnCell, this->mDeltaX0, this->mDeltaX1);
+  CalculateAxis(gridY, fragment, this->mRowCell, this->mDeltaY0, this->mDeltaY1);
+}
+
+std::size_t FGradientNoiseKernel::GetColumnSize() const noexcept
+{
+  return this->mColumnCell.size();
+}
+
+std::size_t FGradientNoiseKernel::GetRowSize() const noexcept
+{
+  return this->mRowCell.size();
+}
+
+void FGradientNoiseKernel::ExpandRowGradients(std::uint32_t cellY, DRowGradients& out) const
+{
+  const auto size = this->GetColumnSize();
+  for (auto* list : {
+    &out.mG00X, &out.mG00Y, &out.mG10X, &out.mG10Y, 
+    &out.mG01X, &out.mG01Y, &out.mG11X, &out.mG11Y })
+  {
+    list->resize(size);
+  }
+
+  const float* gx0 = this->mGradientX.data() + cellY * this->mGradientStride;
+  const float* gy0 = this->mGradientY.data() + cellY * this->mGradientStride;
+  const float* gx1 = gx0 + this->mGradientStride;
+  const float* gy1 = gy0 + this->mGradientStride;
+  for (std::size_t x = 0; x < size; ++x)
+  {
+    const auto cell = this->mColumnCell[x];
+    out.mG00X[x] = gx0[cell];     out.mG00Y[x] = gy0[cell];
+    out.mG10X[x] = gx0[cell + 1]; out.mG10Y[x] = gy0[cell + 1];
+    out.mG01X[x] = gx1[cell];     out.mG01Y[x] = gy1[cell];
+    out.mG11X[x] = gx1[cell + 1]; out.mG11Y[x] = gy1[cell + 1];
+  }
+}
+
+void FGradientNoiseKernel::CalculateRows(
+  std::size_t rowBegin, std::size_t rowEnd, float* outHeights, ENoiseKernelPath path) const
+{
+  assert(rowBegin <= rowEnd && rowEnd <= this->GetRowSize());
+  assert(IsSupported(path) == true);
+
+  // Samples in same cell row share corner gradients, so expand them only when cell row is changed.
+  DRowGradients gradients;
+  std::uint32_t expandedCell = UINT32_MAX;
+
+  const auto size = this->GetColumnSize();
+  for (std::size_t y = rowBegin; y < rowEnd; ++y)
+  {
+    if (const auto cell = this->mRowCell[y]; cell != expandedCell)
+    {
+      this->ExpandRowGradients(cell, gradients);
+      expandedCell = cell;
+    }
+
+    const DRowInput input = 
+    {
+      gradients.mG00X.data(), gradients.mG00Y.data(),
+      gradients.mG10X.data(), gradients.mG10Y.data(),
+      gradients.mG01X.data(), gradients.mG01Y.data(),
+      gradients.mG11X.data(), gradients.mG11Y.data(),
+      this->mDeltaX0.data(), this->mDeltaX1.data(),
+      this->mDeltaY0[y], this->mDeltaY1[y]
+    };
+    float* out = outHeights + (y - rowBegin) * size;
+
+    // Vector path calculates as many samples as it can, and scalar path calculates the remainder.
+    std::size_t done = 0;
+    switch (path)
+    {
+#if NOISE_KERNEL_AVX2 == 1
+    case ENoiseKernelPath::AVX2: 
+    {
+      done = CalculateRowAVX2(input, done, size, out);
+      done = CalculateRowSSE(input, done, size, out);
+    } break;
+#endif
+#if NOISE_KERNEL_SSE == 1 || NOISE_KERNEL_AVX2 == 1
+    case ENoiseKernelPath::SSE: 
+    {
+      done = CalculateRowSSE(input, done, size, out);
+    } break;
+#endif
+    default: break;
+    }
+    CalculateRowScalar(input, done, size, out);
+  }
+}
+
+ENoiseKernelPath FGradientNoiseKernel::GetDefaultPath() noexcept
+{
+  return ENoiseKernelPath::Scalar;
+}
+
+bool FGradientNoiseKernel::IsSupported(ENoiseKernelPath path) noexcept
+{
+  switch (path)
+  {
+  case ENoiseKernelPath::Scalar:  return true;
+  case ENoiseKernelPath::SSE:     return NOISE_KERNEL_SSE == 1 || NOISE_KERNEL_AVX2 == 1;
+  case ENoiseKernelPath::AVX2:    return NOISE_KERNEL_AVX2 == 1;
+  default: return false;
+  }
+}
@@ -13,9 +13,108 @@
 
 #include <FGuiWindow.h>
 
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+#include <string>
 #include <imgui.h>
+#include <Profiling/DProfileScopeTree.h>
+#include <Profiling/MMetrics.h>
 #include <Profiling/MTimeChecker.h>
-#include <XPlatform.h>
+#include <Profiling/MTraceCapture.h>
+#include <Profiling/XCpuClock.h>
+
+namespace
+{
+
+constexpr float kFlameWidth = 400.0f;
+constexpr float kFlameRowHeight = 18.0f;
+
+/// @brief Render node and children of node as nested bars, from (x, depth).
+/// Width of bar is proportional to total time of node.
+/// @return The deepest depth of rendered bars.
+std::size_t RenderFlameNode(
+  const DProfileScopeTree& tree, 
+  std::size_t index, 
+  const ImVec2& origin,
+  float x, 
+  std::size_t depth,
+  float pixelPerSecond)
+{
+  const auto& node = tree[index];
+  const float width = float(node.mTotal.count()) * pixelPerSecond;
+
+  const ImVec2 min = {origin.x + x, origin.y + depth * kFlameRowHeight};
+  const ImVec2 max = {min.x + width, min.y + kFlameRowHeight - 1.0f};
+
+  auto* drawList = ImGui::GetWindowDrawList();
+  drawList->AddRectFilled(min, max, IM_COL32(200, 100 + (depth * 40) % 150, 50, 255));
+  drawList->AddRect(min, max, IM_COL32_BLACK);
+  if (ImGui::CalcTextSize(node.mName.c_str()).x < width)
+  {
+    drawList->AddText({min.x + 2.0f, min.y + 2.0f}, IM_COL32_BLACK, node.mName.c_str());
+  }
+
+  if (ImGui::IsMouseHoveringRect(min, max) == true)
+  {
+    ImGui::SetTooltip("%s\nTotal : %.3f ms\nSelf : %.3f ms\nCalls : %u",
+      node.mName.c_str(), 
+      node.mTotal.count() * 1000.0, 
+      node.mSelf.count() * 1000.0, 
+      node.mCallCount);
+  }
+
+  // Children are placed from left side of parent in insertion order.
+  std::size_t maxDepth = depth;
+  float childX = x;
+  for (const auto childIndex : node.mChildren)
+  {
+    maxDepth = std::max(maxDepth, RenderFlameNode(tree, childIndex, origin, childX, depth + 1, pixelPerSecond));
+    childX += float(tree[childIndex].mTotal.count()) * pixelPerSecond;
+  }
+
+  return maxDepth;
+}
+
+/// @brief Render flame view of scope tree.
+void RenderFlameView(const char* label, const DProfileScopeTree& tree)
+{
+  const auto total = tree.GetTotal().count();
+  ImGui::Text("%s : %.3f ms", label, total * 1000.0);
+  if (total <= 0.0) { return; }
+
+  const ImVec2 origin = ImGui::GetCursorScreenPos();
+  const float pixelPerSecond = kFlameWidth / float(total);
+
+  std::size_t maxDepth = 0;
+  float x = 0.0f;
+  for (const auto rootIndex : tree.GetRoots())
+  {
+    maxDepth = std::max(maxDepth, RenderFlameNode(tree, rootIndex, origin, x, 0, pixelPerSecond));
+    x += float(tree[rootIndex].mTotal.count()) * pixelPerSecond;
+  }
+
+  // Reserve space of rendered bars.
+  ImGui::Dummy({kFlameWidth, (maxDepth + 1) * kFlameRowHeight});
+}
+
+/// @brief Render sampled history of metric as plot, and the latest value as overlay.
+/// Values are multiplied by scale to be shown as given unit.
+void RenderMetricPlot(const char* metricName, float scale, const char* unit)
+{
+  const auto optId = MMetrics::FindMetric(metricName);
+  if (optId.has_value() == false) { return; }
+
+  auto history = MMetrics::GetHistory(*optId);
+  for (auto& value : history) { value *= scale; }
+  const float latest = history.empty() == true ? 0.0f : history.back();
+
+  char overlay[64];
+  std::snprintf(overlay, sizeof(overlay), "%.2f %s", latest, unit);
+  ImGui::PlotLines(metricName, history.data(), int(history.size()), 0, overlay, 0.0f, FLT_MAX, {0.0f, 40.0f});
+}
+
+} /// ::anonymous namespace
 
 FGuiWindow::FGuiWindow(DModelWindow& mModel)
 {
@@ -38,22 +137,76 @@ void FGuiWindow::Render()
   //! Profiling
   //!
 
-  ImGui::Text("CPU Usage : ");
-  ImGui::SameLine();
-  ImGui::ProgressBar(platform->GetProfilingManager().GetCpuUsage() / 500.0f);
+  // Metrics are sampled by MMetrics sampler, so OS is not called every frame.
+  RenderMetricPlot("CPU Usage", 1.0f, "%");
+  if (ImGui::TreeNode("CPU Cores") == true)
+  {
+    for (std::size_t i = 0; ; ++i)
+    {
+      const auto name = "CPU Core " + std::to_string(i);
+      if (MMetrics::FindMetric(name).has_value() == false) { break; }
+      RenderMetricPlot(name.c_str(), 1.0f, "%");
+    }
+    ImGui::TreePop();
+  }
 
   auto& cpuFrame = MTimeChecker::Get("CpuFrame");
   ImGui::Text("CPU Frame : %.3f ms/frame",      cpuFrame.GetRecent().count() * 1000.0);
-  ImGui::Text("CPU Average : %.3f ms/50 frame", cpuFrame.GetAverage().count() * 1000.0);
+  ImGui::Text("CPU Average : %.3f ms/%zu frame", 
+    cpuFrame.GetAverage().count() * 1000.0, 
+    cpuFrame.GetWindowLength());
+  ImGui::Text("CPU p50 %.3f / p95 %.3f / p99 %.3f / max %.3f ms",
+    cpuFrame.GetPercentile(0.50).count() * 1000.0,
+    cpuFrame.GetPercentile(0.95).count() * 1000.0,
+    cpuFrame.GetPercentile(0.99).count() * 1000.0,
+    cpuFrame.GetMax().count() * 1000.0);
+
+  // Hardware counters are only collected when PROFILING_HARDWARE_COUNTERS is 1 on Linux.
+  for (const char* tagName : {"CpuFrame", "MakeMap"})
+  {
+    if (MTimeChecker::Has(tagName) == false) { continue; }
+    const auto& container = MTimeChecker::Get(tagName);
+    if (container.HasCounters() == false) { continue; }
+
+    const auto counters = container.GetAverageCounters();
+    ImGui::Text("%s IPC %.2f / Cache Miss %llu / Branch Miss %llu",
+      tagName,
+      container.GetInstructionsPerCycle(),
+      static_cast<unsigned long long>(counters.mCacheMisses),
+      static_cast<unsigned long long>(counters.mBranchMisses));
+  }
 
-  const float ramMBUsage = platform->GetProfilingManager().GetRamUsage() / (1024.0 * 1024.0);
-  ImGui::Text("RAM Usage : %.3f MB", ramMBUsage);
+  ImGui::Text("Scope Overhead : %.1f ns (%s)", 
+    MTimeChecker::GetScopeOverhead().count() * 1'000'000'000.0,
+    XCpuClock::IsUsingTsc() == true ? "TSC" : "steady_clock");
+
+  RenderMetricPlot("RAM Usage", 1.0f / (1024.0f * 1024.0f), "MB");
+  RenderMetricPlot("Allocated Bytes", 1.0f / (1024.0f * 1024.0f), "MB/s");
+  RenderMetricPlot("Allocations", 1.0f, "/s");
+  RenderMetricPlot("Draw Calls", 1.0f, "/frame");
+  if (ImGui::TreeNode("D3D11 Resources") == true)
+  {
+    for (std::size_t i = 0; i < MMetrics::GetMetricCount(); ++i)
+    {
+      const auto name = MMetrics::GetMetricName(uint32_t(i));
+      if (name.compare(0, 6, "D3D11 ") != 0) { continue; }
+      ImGui::Text("%s : %.0f", name.c_str(), MMetrics::GetLatest(uint32_t(i)));
+    }
+    ImGui::TreePop();
+  }
 
   const auto& gpuFrame = MTimeChecker::GetGpuD3D11("GpuFrame");
   if (gpuFrame.HasFragment("Overall") == true)
   {
-    ImGui::Text("GPU Average : %.3f ms/50 frame", 
-      gpuFrame["Overall"].GetAverage().count() * 1000.0f);
+    const auto& overall = gpuFrame["Overall"];
+    ImGui::Text("GPU Average : %.3f ms/%zu frame", 
+      overall.GetAverage().count() * 1000.0f,
+      overall.GetWindowLength());
+    ImGui::Text("GPU p50 %.3f / p95 %.3f / p99 %.3f / max %.3f ms",
+      overall.GetPercentile(0.50).count() * 1000.0,
+      overall.GetPercentile(0.95).count() * 1000.0,
+      overall.GetPercentile(0.99).count() * 1000.0,
+      overall.GetMax().count() * 1000.0);
   }
   if (gpuFrame.HasFragment("Draw") == true)
   {
@@ -68,6 +221,27 @@ void FGuiWindow::Render()
 
   ImGui::Separator();
 
+  //!
+  //! Scope flame view
+  //!
+
+  RenderFlameView("CPU Scopes", MTimeChecker::GetCpuScopeTree());
+  RenderFlameView("GPU Scopes", gpuFrame.GetScopeTree());
+
+  // Trace capture. Captured file can be opened with about:tracing or Perfetto UI.
+  if (MTraceCapture::IsCapturing() == false)
+  {
+    if (ImGui::Button("Start Trace Capture") == true) { MTraceCapture::StartCapture("trace.json"); }
+  }
+  else
+  {
+    if (ImGui::Button("Stop Trace Capture") == true) { MTraceCapture::StopCapture(); }
+    ImGui::SameLine();
+    ImGui::Text("Capturing into trace.json...");
+  }
+
+  ImGui::Separator();
+
   //!
   //! Draw
   //!
@@ -84,6 +258,19 @@ void FGuiWindow::Render()
   ImGui::Text("Terrain");
   ImGui::SliderInt2("Grid", model.mTerrainGrid.data(), 1, 20);
   ImGui::SliderInt2("Fragment", model.mTerrainFragment.data(), 1, 20);
+  ImGui::InputInt("Seed", &model.mTerrainSeed);
+
+  // Streaming terrain generates tiles around camera, and keeps them within memory budget.
+  ImGui::Checkbox("Stream Tiles", &model.mStreamTerrain);
+  if (model.mStreamTerrain == true)
+  {
+    ImGui::SliderFloat("Travel Speed", &model.mTravelSpeed, 0.0f, 64.0f);
+    ImGui::SliderInt("View Radius", &model.mStreamRadius, 0, 8);
+    ImGui::SliderInt("Budget (MB)", &model.mStreamBudget, 1, 256);
+    RenderMetricPlot("Terrain Tiles", 1.0f, "tiles");
+    RenderMetricPlot("Terrain Pending Tiles", 1.0f, "tiles");
+    RenderMetricPlot("Terrain Tile Memory", 1.0f / (1024.0f * 1024.0f), "MB");
+  }
 
   ImGui::Separator();
 
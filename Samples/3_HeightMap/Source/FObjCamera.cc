@@ -28,6 +28,7 @@
 #include <Graphics/MD3D11Resources.h>
 #include <Resource/D11DefaultHandles.h>
 #include <Math/Utility/XGraphicsMath.h>
+#include <Profiling/MMetrics.h>
 #include <MGuiManager.h>
 #include <FGuiWindow.h>
 
@@ -54,11 +55,31 @@ void FObjCamera::Update(float delta)
   const DVector4<TReal> initPos = {0, 0, model.mDistance, 1};
   const DQuaternion<TReal> initQuat = {{-model.mCamera, 0, 0}, true}; 
   const auto rotatedPos = initQuat.ToMatrix4() * initPos;
-  this->mPosition = { rotatedPos.X, rotatedPos.Y, rotatedPos.Z };
+  this->mOrbit = { rotatedPos.X, rotatedPos.Y, rotatedPos.Z };
+
+  // Camera travels over streamed terrain, and orbits around the travelled point.
+  this->mPrevTravel = this->mTravel;
+  if (model.mStreamTerrain == true) 
+  { 
+    this->mTravel += model.mTravelSpeed * delta; 
+  } 
+  else 
+  { 
+    this->mTravel = 0; this->mPrevTravel = 0; 
+  }
+  this->mLookAt = { this->mTravel, 0, 0 };
+  this->mPosition = { this->mOrbit.X + this->mTravel, this->mOrbit.Y, this->mOrbit.Z };
+}
+
+void FObjCamera::Interpolate(float alpha)
+{
+  const TReal travel = this->mPrevTravel + (this->mTravel - this->mPrevTravel) * alpha;
+  const DVector3<TReal> lookAt = { travel, 0, 0 };
+  const DVector3<TReal> position = { this->mOrbit.X + travel, this->mOrbit.Y, this->mOrbit.Z };
 
   // Update view & projection matrix.
   this->mCbViewProj.mView = 
-    LookAt2<TReal>(EGraphics::DirectX, this->mPosition, this->mLookAt, this->mUp);
+    LookAt2<TReal>(EGraphics::DirectX, position, lookAt, this->mUp);
   this->mCbViewProj.mProj = 
     ProjectionMatrix<TReal>(
       EGraphics::OpenGL, EProjection::Perspective, 
@@ -71,6 +92,11 @@ void FObjCamera::Update(float delta)
   (*this->mDc)->UpdateSubresource((*this->mbViewProj).GetPtr(), 0, nullptr, &this->mCbViewProj, 0, 0);
 }
 
+const DVector3<TReal>& FObjCamera::GetPosition() const noexcept
+{
+  return this->mPosition;
+}
+
 void FObjCamera::Render()
 {
 #if 0
@@ -80,5 +106,6 @@ void FObjCamera::Render()
   (*this->mDc)->IASetVertexBuffers(0, 1, &pVBuffer, &stride, &offset);
   (*this->mDc)->IASetIndexBuffer((*mIBuffer).GetPtr(), DXGI_FORMAT_R32_UINT, 0);
   (*this->mDc)->DrawIndexed(3, 0, 0);
+  MMetrics::CountDrawCall();
 #endif
 }
@@ -12,12 +12,16 @@
 ///
 
 #include <FObjTerrain.h>
+#include <array>
+#include <chrono>
 #include <Graphics/MD3D11Resources.h>
 #include <Resource/D11DefaultHandles.h>
 #include <Math/Utility/XGraphicsMath.h>
+#include <Profiling/MMetrics.h>
 #include <MGuiManager.h>
-#include <MRandomMap.h>
 #include <FGuiWindow.h>
+#include <FObjCamera.h>
+#include <XTerrainBuffers.h>
 
 void FObjTerrain::Initialize(void* pData)
 {
@@ -30,155 +34,193 @@ void FObjTerrain::Initialize(void* pData)
   this->mDc.emplace(MD3D11Resources::GetDeviceContext(defaults.mDevice));
   this->mCbObject.emplace(MD3D11Resources::GetBuffer(this->hCbObject));
   this->hDevice = defaults.mDevice;
+  this->mpCamera = param.mpCamera;
 
   if (MGuiManager::HasSharedModel("Window") == true)
   {
     const auto& model = static_cast<DModelWindow&>(MGuiManager::GetSharedModel("Window"));
-    bool isChanged = false;
-
-    if (this->mTerrainGrid != model.mTerrainGrid)
-    {
-      this->mTerrainGrid = model.mTerrainGrid;
-      isChanged = true;
-    }
-
-    if (this->mTerrainFragment != model.mTerrainFragment)
-    {
-      this->mTerrainFragment = model.mTerrainFragment;
-      isChanged = true;
-    }
-
-    if (isChanged == true)
-    {
-      MRandomMap::MakeMap(this->mTerrainGrid, this->mTerrainFragment[0]);
-      {
-        const auto& buffer = MRandomMap::TempGetVertexBuffer();
-
-        D3D11_BUFFER_DESC vbDesc = {};
-        vbDesc.Usage = D3D11_USAGE_IMMUTABLE;
-        vbDesc.ByteWidth = UINT(sizeof(DVector3<TReal>) * buffer.GetRowSize() * buffer.GetColumnSize());
-        vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        vbDesc.CPUAccessFlags = 0;
-        vbDesc.MiscFlags = 0;
-        vbDesc.StructureByteStride = 0;
-
-        if (this->hVBuffer.IsValid() == true)
-        {
-          MD3D11Resources::RemoveBuffer(this->hVBuffer);
-        }
-        this->hVBuffer = *MD3D11Resources::CreateBuffer(defaults.mDevice, vbDesc, buffer.Data());
-        assert(MD3D11Resources::HasBuffer(hVBuffer) == true);
-        this->mVBuffer.emplace(MD3D11Resources::GetBuffer(this->hVBuffer));
-      }
-
-      {
-        const auto& buffer = MRandomMap::TempGetIndiceBuffer();
-
-        D3D11_BUFFER_DESC ibDesc;
-        ibDesc.Usage = D3D11_USAGE_IMMUTABLE;
-        ibDesc.ByteWidth = UINT(buffer.size() * sizeof(TU32));
-        ibDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-        ibDesc.CPUAccessFlags = 0;
-        ibDesc.MiscFlags = 0;
-        ibDesc.StructureByteStride = 0;
-
-        if (this->hIBuffer.IsValid() == true)
-        {
-          MD3D11Resources::RemoveBuffer(this->hIBuffer);
-        }
-        this->hIBuffer = *MD3D11Resources::CreateBuffer(defaults.mDevice, ibDesc, buffer.data());
-        assert(MD3D11Resources::HasBuffer(hIBuffer) == true);
-        this->mIBuffer.emplace(MD3D11Resources::GetBuffer(this->hIBuffer));
-      }
-    }
+    this->RequestMeshIfChanged(model);
   }
 }
 
 void FObjTerrain::Release(void* pData)
 {
-  this->mVBuffer = std::nullopt;
+  this->mTileCache.reset();
+
+  // Wait cancelled job, not to leave job running after terrain is released.
+  if (this->mPendingMesh.valid() == true)
+  {
+    this->mPendingCancelled->store(true);
+    this->mPendingMesh.wait();
+    this->mPendingMesh = {};
+  }
+
+  this->mHeightBuffer = std::nullopt;
+  this->mPositionBuffer = std::nullopt;
   this->mIBuffer = std::nullopt;
 
+  if (this->hHeightBuffer.IsValid() == true)
   {
-    const auto flag = MD3D11Resources::RemoveBuffer(this->hIBuffer);
+    const auto flag = MD3D11Resources::RemoveBuffer(this->hHeightBuffer);
     assert(flag == true);
   }
+  if (this->mTopology != nullptr)
   {
-    const auto flag = MD3D11Resources::RemoveBuffer(this->hVBuffer);
-    assert(flag == true);
+    ReleaseTopologyBuffers(*this->mTopology);
+    this->mTopology = nullptr;
   }
 }
 
 void FObjTerrain::Update(float delta)
 {
+  // Swap mesh before checking new request, so mesh is replaced only at frame boundary.
+  this->SwapMeshIfReady();
+
   if (MGuiManager::HasSharedModel("Window") == true)
   {
-    auto& model = static_cast<DModelWindow&>(MGuiManager::GetSharedModel("Window"));
-    bool isChanged = false;
+    const auto& model = static_cast<DModelWindow&>(MGuiManager::GetSharedModel("Window"));
+    this->RequestMeshIfChanged(model);
+    this->UpdateTileCache(model);
+  }
+
+  this->mPrevDegRotate = this->mDegRotate;
+  this->mDegRotate.Y += delta * 30;
+}
+
+void FObjTerrain::Interpolate(float alpha) noexcept
+{
+  this->mRenderDegRotate = this->mDegRotate;
+  this->mRenderDegRotate.Y = this->mPrevDegRotate.Y + (this->mDegRotate.Y - this->mPrevDegRotate.Y) * alpha;
+}
+
+void FObjTerrain::UpdateTileCache(const DModelWindow& model)
+{
+  if (model.mStreamTerrain == false)
+  {
+    this->mTileCache.reset();
+    return;
+  }
+
+  PTerrainTileDescriptor desc;
+  desc.mViewRadius = model.mStreamRadius;
+  desc.mMemoryBudget = std::size_t(model.mStreamBudget) * 1024 * 1024;
+  desc.mSeed = std::uint32_t(model.mTerrainSeed);
+
+  // Tiles of previous settings are not valid anymore, so cache is recreated.
+  if (this->mTileCache.has_value() == false
+  ||  this->mTileDesc.mViewRadius != desc.mViewRadius
+  ||  this->mTileDesc.mMemoryBudget != desc.mMemoryBudget
+  ||  this->mTileDesc.mSeed != desc.mSeed)
+  {
+    this->mTileCache.reset();
+    this->mTileCache.emplace(this->hDevice, desc);
+    this->mTileDesc = desc;
+  }
+
+  // Tiles are streamed around ground point of camera.
+  if (this->mpCamera != nullptr)
+  {
+    const auto& cameraPosition = this->mpCamera->GetPosition();
+    this->mTileCache->Update(cameraPosition.X, cameraPosition.Z);
+  }
+  else
+  {
+    this->mTileCache->Update(0, 0);
+  }
+}
+
+void FObjTerrain::RequestMeshIfChanged(const DModelWindow& model)
+{
+  bool isChanged = false;
+
+  if (this->mTerrainGrid != model.mTerrainGrid)
+  {
+    this->mTerrainGrid = model.mTerrainGrid;
+    isChanged = true;
+  }
+
+  if (this->mTerrainFragment != model.mTerrainFragment)
+  {
+    this->mTerrainFragment = model.mTerrainFragment;
+    isChanged = true;
+  }
+
+  if (this->mTerrainSeed != model.mTerrainSeed)
+  {
+    this->mTerrainSeed = model.mTerrainSeed;
+    isChanged = true;
+  }
+
+  if (isChanged == false) { return; }
+
+  // Cancel previous request which is not finished yet.
+  // Its future is dropped, and result is not used even if job has already finished.
+  if (this->mPendingCancelled != nullptr)
+  {
+    this->mPendingCancelled->store(true);
+  }
+
+  this->mPendingCancelled = std::make_shared<std::atomic<bool>>(false);
+  this->mPendingMesh = MRandomMap::RequestMap(
+    this->mTerrainGrid, this->mTerrainFragment[0], std::uint32_t(this->mTerrainSeed),
+    this->mPendingCancelled);
+}
 
-    if (this->mTerrainGrid != model.mTerrainGrid)
+void FObjTerrain::SwapMeshIfReady()
+{
+  if (this->mPendingMesh.valid() == false) { return; }
+  if (this->mPendingMesh.wait_for(std::chrono::seconds(0)) != std::future_status::ready) { return; }
+
+  auto optMesh = this->mPendingMesh.get();
+  this->mPendingCancelled = nullptr;
+  if (optMesh.has_value() == false) { return; }
+
+  // Previous buffers are drawn until here.
+  auto& mesh = *optMesh;
+  const auto& topology = *mesh.mTopology;
+
+  // Same size keeps same topology, so only heights are uploaded into existing height buffer.
+  if (this->mTopology == mesh.mTopology)
+  {
+    (*this->mDc)->UpdateSubresource((*this->mHeightBuffer).GetPtr(), 0, nullptr, mesh.mHeights.data(), 0, 0);
+  }
+  else
+  {
+    // Acquire new topology before releasing previous one, so shared buffers are not recreated.
+    // When buffers can not be created, previous mesh is kept and same settings are requested again.
+    const auto hNewHeightBuffer = CreateHeightBuffer(this->hDevice, mesh.mHeights);
+    const auto* pBuffers = hNewHeightBuffer.IsValid() == true 
+      ? AcquireTopologyBuffers(this->hDevice, topology) 
+      : nullptr;
+    if (pBuffers == nullptr)
     {
-      this->mTerrainGrid = model.mTerrainGrid;
-      isChanged = true;
+      MD3D11Resources::RemoveBuffer(hNewHeightBuffer);
+      this->mTerrainGrid = {0, 0};
+      return;
     }
 
-    if (this->mTerrainFragment != model.mTerrainFragment)
+    this->mPositionBuffer.emplace(MD3D11Resources::GetBuffer(pBuffers->mPositionBuffer));
+    this->mIBuffer.emplace(MD3D11Resources::GetBuffer(pBuffers->mIndexBuffer));
+    if (this->mTopology != nullptr)
     {
-      this->mTerrainFragment = model.mTerrainFragment;
-      isChanged = true;
+      ReleaseTopologyBuffers(*this->mTopology);
     }
+    this->mTopology = mesh.mTopology;
 
-    if (isChanged == true)
+    if (this->hHeightBuffer.IsValid() == true)
     {
-      MRandomMap::MakeMap(this->mTerrainGrid, this->mTerrainFragment[0]);
-      {
-        const auto& buffer = MRandomMap::TempGetVertexBuffer();
-
-        D3D11_BUFFER_DESC vbDesc = {};
-        vbDesc.Usage = D3D11_USAGE_IMMUTABLE;
-        vbDesc.ByteWidth = UINT(sizeof(DVector3<TReal>) * buffer.GetRowSize() * buffer.GetColumnSize());
-        vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        vbDesc.CPUAccessFlags = 0;
-        vbDesc.MiscFlags = 0;
-        vbDesc.StructureByteStride = 0;
-
-        if (this->hVBuffer.IsValid() == true)
-        {
-          this->mVBuffer = std::nullopt;
-          MD3D11Resources::RemoveBuffer(this->hVBuffer);
-        }
-        this->hVBuffer = *MD3D11Resources::CreateBuffer(this->hDevice, vbDesc, buffer.Data());
-        assert(MD3D11Resources::HasBuffer(hVBuffer) == true);
-        this->mVBuffer.emplace(MD3D11Resources::GetBuffer(this->hVBuffer));
-      }
-
-      {
-        const auto& buffer = MRandomMap::TempGetIndiceBuffer();
-
-        D3D11_BUFFER_DESC ibDesc;
-        ibDesc.Usage = D3D11_USAGE_IMMUTABLE;
-        ibDesc.ByteWidth = UINT(buffer.size() * sizeof(TU32));
-        ibDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-        ibDesc.CPUAccessFlags = 0;
-        ibDesc.MiscFlags = 0;
-        ibDesc.StructureByteStride = 0;
-
-        if (this->hIBuffer.IsValid() == true)
-        {
-          this->mIBuffer = std::nullopt;
-          MD3D11Resources::RemoveBuffer(this->hIBuffer);
-        }
-        this->hIBuffer = *MD3D11Resources::CreateBuffer(this->hDevice, ibDesc, buffer.data());
-        assert(MD3D11Resources::HasBuffer(hIBuffer) == true);
-        this->mIBuffer.emplace(MD3D11Resources::GetBuffer(this->hIBuffer));
-      }
+      this->mHeightBuffer = std::nullopt;
+      MD3D11Resources::RemoveBuffer(this->hHeightBuffer);
     }
-
-    this->mPosition.X = -model.mTerrainGrid[0] * 0.5f;
-    this->mPosition.Z = -model.mTerrainGrid[1] * 0.5f;
+    this->hHeightBuffer = hNewHeightBuffer;
+    this->mHeightBuffer.emplace(MD3D11Resources::GetBuffer(this->hHeightBuffer));
   }
 
-  mDegRotate.Y += delta * 30;
+  this->mIndexCount = UINT(topology.mIndices.size());
+
+  // Only the latest request can be ready, so current grid is grid of new mesh.
+  this->mPosition.X = -this->mTerrainGrid[0] * 0.5f;
+  this->mPosition.Z = -this->mTerrainGrid[1] * 0.5f;
 }
 
 void FObjTerrain::Render()
@@ -186,21 +228,50 @@ void FObjTerrain::Render()
   assert(this->mCbObject.has_value() == true);
   assert(this->mDc.has_value() == true);
 
+  // Tiles are placed flat on world XZ plane by tile coordinate, and do not rotate.
+  if (this->mTileCache.has_value() == true)
+  {
+    const float tileSize = this->mTileCache->GetTileSize();
+    this->mTileCache->ForEachVisibleTile([this, tileSize](const FTerrainTileCache::DDrawTile& tile)
+    {
+      this->DrawMesh(
+        DVector3<TReal>{tile.mCoord[0] * tileSize, this->mPosition.Y, tile.mCoord[1] * tileSize},
+        DVector3<TReal>{90, 0, 0},
+        tile.mPositionBuffer, tile.mHeightBuffer, tile.mIndexBuffer, tile.mIndexCount);
+    });
+    return;
+  }
+
+  // Nothing to draw until the first requested mesh is ready.
+  if (this->mHeightBuffer.has_value() == false) { return; }
+
+  this->DrawMesh(
+    this->mPosition, this->mRenderDegRotate, 
+    (*this->mPositionBuffer).GetPtr(), (*this->mHeightBuffer).GetPtr(), (*this->mIBuffer).GetPtr(), 
+    this->mIndexCount);
+}
+
+void FObjTerrain::DrawMesh(
+  const DVector3<TReal>& position, const DVector3<TReal>& degRotate,
+  ID3D11Buffer* pPositionBuffer, ID3D11Buffer* pHeightBuffer, ID3D11Buffer* pIndexBuffer, UINT indexCount)
+{
   // Update object matrix
   {
     using namespace ::dy::math;
     init.mModel = CreateModelMatrix<TReal>(
       EGraphics::DirectX, 
-      this->mPosition, this->mDegRotate, this->mScale, 
+      position, degRotate, this->mScale, 
       true);
   }
   (*this->mDc)->UpdateSubresource((*this->mCbObject).GetPtr(), 0, nullptr, &this->init, 0, 0);
 
-  // Set Vertex, Index and draw.
-  auto* pVBuffer = (*mVBuffer).GetPtr();
-  UINT stride    = sizeof(DVector3<TReal>); UINT offset = 0;
+  // Set Vertex, Index and draw. XY position and height are separate streams.
+  std::array<ID3D11Buffer*, 2> pVBuffers = {pPositionBuffer, pHeightBuffer};
+  std::array<UINT, 2> strides = {sizeof(DVector2<TReal>), sizeof(float)}; 
+  std::array<UINT, 2> offsets = {0, 0};
 
-  (*this->mDc)->IASetVertexBuffers(0, 1, &pVBuffer, &stride, &offset);
-  (*this->mDc)->IASetIndexBuffer((*mIBuffer).GetPtr(), DXGI_FORMAT_R32_UINT, 0);
-  (*this->mDc)->DrawIndexed(UINT(MRandomMap::TempGetIndiceBuffer().size()), 0, 0);
+  (*this->mDc)->IASetVertexBuffers(0, UINT(pVBuffers.size()), pVBuffers.data(), strides.data(), offsets.data());
+  (*this->mDc)->IASetIndexBuffer(pIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+  (*this->mDc)->DrawIndexed(indexCount, 0, 0);
+  MMetrics::CountDrawCall();
 }
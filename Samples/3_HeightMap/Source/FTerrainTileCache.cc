@@ -0,0 +1,262 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <FTerrainTileCache.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <Graphics/MD3D11Resources.h>
+#include <Profiling/MMetrics.h>
+#include <XTerrainBuffers.h>
+
+namespace
+{
+
+/// @struct DTileMetrics
+/// @brief Metric ids of tile cache.
+struct DTileMetrics final
+{
+  uint32_t mResident;
+  uint32_t mPending;
+  uint32_t mBytes;
+};
+
+/// @brief Get metric ids of tile cache. Metrics are registered at first call.
+const DTileMetrics& GetTileMetrics()
+{
+  static const DTileMetrics metrics = 
+  {
+    MMetrics::RegisterMetric("Terrain Tiles", EMetricKind::Gauge),
+    MMetrics::RegisterMetric("Terrain Pending Tiles", EMetricKind::Gauge),
+    MMetrics::RegisterMetric("Terrain Tile Memory", EMetricKind::Gauge),
+  };
+  return metrics;
+}
+
+} /// ::anonymous namespace
+
+FTerrainTileCache::FTerrainTileCache(const D11HandleDevice& device, const PTerrainTileDescriptor& desc)
+  : hDevice{device},
+    mDesc{desc}
+{
+  assert(desc.mTileCells > 0 && desc.mFragment > 0);
+  assert(desc.mViewRadius >= 0);
+  assert(desc.mMaxPendingTiles > 0);
+}
+
+FTerrainTileCache::~FTerrainTileCache()
+{
+  // Futures of promise do not block when dropped, so pending tiles are just cancelled.
+  for (auto& [key, pending] : this->mPendingTiles) { pending.mCancelled->store(true); }
+  this->mPendingTiles.clear();
+
+  while (this->mTiles.empty() == false) { this->EvictTile(this->mTiles.begin()); }
+}
+
+float FTerrainTileCache::GetTileSize() const noexcept
+{
+  // The last sample row and column of tile is the first one of next tile.
+  return float(this->mDesc.mTileCells * this->mDesc.mFragment);
+}
+
+void FTerrainTileCache::Update(float focusX, float focusY)
+{
+  const float tileSize = this->GetTileSize();
+  this->mFocusTile = 
+  {
+    static_cast<int>(std::floor(focusX / tileSize)), 
+    static_cast<int>(std::floor(focusY / tileSize))
+  };
+  const int radius = this->mDesc.mViewRadius;
+
+  // Collect finished tiles, and cancel tiles which became invisible before they are finished.
+  for (auto it = this->mPendingTiles.begin(); it != this->mPendingTiles.end();)
+  {
+    auto& pending = it->second;
+    const TTileCoord coord = {int(std::int32_t(it->first >> 32)), int(std::int32_t(it->first))};
+    if (this->IsWithin(coord, radius) == false)
+    {
+      pending.mCancelled->store(true);
+      it = this->mPendingTiles.erase(it);
+      continue;
+    }
+
+    if (pending.mMesh.wait_for(std::chrono::seconds(0)) != std::future_status::ready) { ++it; continue; }
+
+    if (auto optMesh = pending.mMesh.get(); optMesh.has_value() == true)
+    {
+      this->AddResidentTile(coord, *optMesh);
+    }
+    it = this->mPendingTiles.erase(it);
+  }
+
+  // Mark visible tiles as the most recently used, and find missing visible tiles.
+  std::vector<TTileCoord> missingTiles;
+  for (int y = this->mFocusTile[1] - radius; y <= this->mFocusTile[1] + radius; ++y)
+  {
+    for (int x = this->mFocusTile[0] - radius; x <= this->mFocusTile[0] + radius; ++x)
+    {
+      const auto key = ToKey({x, y});
+      if (auto it = this->mTiles.find(key); it != this->mTiles.end())
+      {
+        this->mLru.splice(this->mLru.begin(), this->mLru, it->second.mLruIt);
+      }
+      else if (this->mPendingTiles.find(key) == this->mPendingTiles.end())
+      {
+        missingTiles.push_back({x, y});
+      }
+    }
+  }
+
+  // Evict far tiles, and then the least recently visible tiles until resident bytes are within budget.
+  // Visible tiles are at the front of LRU, so they are not evicted even if budget is exceeded.
+  for (auto it = this->mTiles.begin(); it != this->mTiles.end();)
+  {
+    auto next = std::next(it);
+    if (this->IsWithin(it->second.mCoord, radius * 2) == false) { this->EvictTile(it); }
+    it = next;
+  }
+  while (this->mResidentBytes > this->mDesc.mMemoryBudget && this->mLru.empty() == false)
+  {
+    const auto it = this->mTiles.find(this->mLru.back());
+    if (this->IsWithin(it->second.mCoord, radius) == true) { break; }
+    this->EvictTile(it);
+  }
+
+  // Request the nearest missing tiles first.
+  const auto focus = this->mFocusTile;
+  std::sort(missingTiles.begin(), missingTiles.end(), [focus](const TTileCoord& lhs, const TTileCoord& rhs)
+  {
+    const auto Distance = [focus](const TTileCoord& coord) 
+    { 
+      const int dx = coord[0] - focus[0];
+      const int dy = coord[1] - focus[1];
+      return dx * dx + dy * dy;
+    };
+    return Distance(lhs) != Distance(rhs) ? Distance(lhs) < Distance(rhs) : lhs < rhs;
+  });
+  for (const auto& coord : missingTiles)
+  {
+    if (this->mPendingTiles.size() >= this->mDesc.mMaxPendingTiles) { break; }
+
+    DPendingTile pending;
+    pending.mCancelled = std::make_shared<std::atomic<bool>>(false);
+    pending.mMesh = MRandomMap::RequestTile(
+      coord, this->mDesc.mTileCells, this->mDesc.mFragment, this->mDesc.mSeed, 
+      pending.mCancelled);
+    this->mPendingTiles.emplace(ToKey(coord), std::move(pending));
+  }
+
+  const auto& metrics = GetTileMetrics();
+  MMetrics::SetGauge(metrics.mResident, double(this->GetResidentCount()));
+  MMetrics::SetGauge(metrics.mPending, double(this->GetPendingCount()));
+  MMetrics::SetGauge(metrics.mBytes, double(this->GetResidentBytes()));
+}
+
+void FTerrainTileCache::ForEachVisibleTile(const std::function<void(const DDrawTile&)>& function)
+{
+  const int radius = this->mDesc.mViewRadius;
+  for (int y = this->mFocusTile[1] - radius; y <= this->mFocusTile[1] + radius; ++y)
+  {
+    for (int x = this->mFocusTile[0] - radius; x <= this->mFocusTile[0] + radius; ++x)
+    {
+      auto it = this->mTiles.find(ToKey({x, y}));
+      if (it == this->mTiles.end()) { continue; }
+
+      auto& tile = it->second;
+      function(DDrawTile
+      {
+        tile.mCoord,
+        (*tile.mPositionBuffer).GetPtr(),
+        (*tile.mHeightBuffer).GetPtr(),
+        (*tile.mIndexBuffer).GetPtr(),
+        UINT(tile.mTopology->mIndices.size())
+      });
+    }
+  }
+}
+
+std::size_t FTerrainTileCache::GetResidentCount() const noexcept
+{
+  return this->mTiles.size();
+}
+
+std::size_t FTerrainTileCache::GetPendingCount() const noexcept
+{
+  return this->mPendingTiles.size();
+}
+
+std::size_t FTerrainTileCache::GetResidentBytes() const noexcept
+{
+  return this->mResidentBytes;
+}
+
+std::uint64_t FTerrainTileCache::ToKey(const TTileCoord& coord) noexcept
+{
+  return (std::uint64_t(std::uint32_t(coord[0])) << 32) | std::uint64_t(std::uint32_t(coord[1]));
+}
+
+bool FTerrainTileCache::IsWithin(const TTileCoord& coord, int distance) const noexcept
+{
+  return std::abs(coord[0] - this->mFocusTile[0]) <= distance 
+      && std::abs(coord[1] - this->mFocusTile[1]) <= distance;
+}
+
+bool FTerrainTileCache::AddResidentTile(const TTileCoord& coord, DRandomMapMesh& mesh)
+{
+  const auto key = ToKey(coord);
+  assert(this->mTiles.find(key) == this->mTiles.end());
+
+  // Buffers can not be created when device is removed. Tile is requested again as missing tile.
+  const auto hHeightBuffer = CreateHeightBuffer(this->hDevice, mesh.mHeights);
+  if (hHeightBuffer.IsValid() == false) { return false; }
+
+  const auto* pBuffers = AcquireTopologyBuffers(this->hDevice, *mesh.mTopology);
+  if (pBuffers == nullptr)
+  {
+    MD3D11Resources::RemoveBuffer(hHeightBuffer);
+    return false;
+  }
+
+  auto& tile = this->mTiles[key];
+  tile.mCoord = coord;
+  tile.hHeightBuffer = hHeightBuffer;
+  tile.mHeightBuffer.emplace(MD3D11Resources::GetBuffer(tile.hHeightBuffer));
+  tile.mPositionBuffer.emplace(MD3D11Resources::GetBuffer(pBuffers->mPositionBuffer));
+  tile.mIndexBuffer.emplace(MD3D11Resources::GetBuffer(pBuffers->mIndexBuffer));
+  tile.mTopology = std::move(mesh.mTopology);
+
+  tile.mBytes = sizeof(float) * mesh.mHeights.size();
+  this->mResidentBytes += tile.mBytes;
+
+  this->mLru.push_front(key);
+  tile.mLruIt = this->mLru.begin();
+  return true;
+}
+
+void FTerrainTileCache::EvictTile(std::unordered_map<std::uint64_t, DTile>::iterator it)
+{
+  auto& tile = it->second;
+  tile.mHeightBuffer = std::nullopt;
+  tile.mPositionBuffer = std::nullopt;
+  tile.mIndexBuffer = std::nullopt;
+
+  MD3D11Resources::RemoveBuffer(tile.hHeightBuffer);
+  ReleaseTopologyBuffers(*tile.mTopology);
+
+  this->mResidentBytes -= tile.mBytes;
+  this->mLru.erase(tile.mLruIt);
+  this->mTiles.erase(it);
+}
@@ -12,165 +12,269 @@
 ///
 
 #include <MRandomMap.h>
+#include <algorithm>
 #include <cmath>
-#include <Math/Utility/XRandom.h>
-#include <Math/Utility/XLinearMath.h>
+#include <random>
+#include <thread>
+#include <FGradientNoiseKernel.h>
 #include <Expr/TZip.h>
+#include <Profiling/MTimeChecker.h>
+#include <Thread/FWorkerPool.h>
 
 namespace
 {
 
-std::vector<std::pair<DVector2<TI32>, DVector2<TReal>>>
-CalculateOffset(std::size_t fragmentNum);
+/// @brief Get worker pool of map generation. Pool is created when map is made at first.
+/// Pool has one worker at least, so requested map is generated even on single core.
+FWorkerPool& GetWorkerPool()
+{
+  static FWorkerPool pool{(std::max)(std::thread::hardware_concurrency(), 2u) - 1};
+  return pool;
+}
 
-/// @brief Create Gradient 2D grid map with given grid count.
-DDynamicGrid2D<DVector2<TReal>> 
-Create2DGradientMap(const std::array<int, 2>& grid)
+/// @brief Get row count of each parallel block.
+/// Blocks are smaller than even split, so faster threads can take more blocks.
+std::size_t GetRowBlockSize(std::size_t rowCount)
 {
-  DDynamicGrid2D<DVector2<TReal>> gradientMap = 
-    { std::size_t(grid[0] + 1), std::size_t(grid[1] + 1) };
+  const auto threadCount = GetWorkerPool().GetWorkerCount() + 1;
+  return (std::max)(std::size_t(1), rowCount / (threadCount * 4));
+}
 
-  for (auto& row : gradientMap)
+/// @brief Create unit-length random gradients of (grid[0] + 1) * (grid[1] + 1) nodes from seed.
+/// Gradients are split into x and y component lists, row-major.
+/// Gradients are created on calling thread in fixed order, so same seed always gives same gradients.
+std::pair<std::vector<float>, std::vector<float>> 
+CreateGradients(const std::array<int, 2>& grid, std::uint32_t seed)
+{
+  const auto count = std::size_t(grid[0] + 1) * std::size_t(grid[1] + 1);
+
+  std::mt19937 engine{seed};
+  std::uniform_real_distribution<float> angleDist{0.0f, 6.28318530718f};
+
+  std::pair<std::vector<float>, std::vector<float>> result;
+  result.first.resize(count);
+  result.second.resize(count);
+  for (std::size_t i = 0; i < count; ++i)
   {
-    for (auto& item : row)
-    {
-      item = RandomVector2Length<TReal>(1.0f);
+    const float angle = angleDist(engine);
+    result.first[i]  = std::cos(angle);
+    result.second[i] = std::sin(angle);
+  }
+
+  return result;
+}
+
+/// @brief Get unit-length gradient of grid node (x, y) from seed.
+/// Same node always has same gradient, regardless of which tile requests it.
+std::pair<float, float> GetNodeGradient(std::int32_t x, std::int32_t y, std::uint32_t seed)
+{
+  // https://nullprogram.com/blog/2018/07/31/
+  std::uint32_t hash = seed ^ (std::uint32_t(x) * 0x8da6b343u) ^ (std::uint32_t(y) * 0xd8163841u);
+  hash = (hash ^ (hash >> 16)) * 0x7feb352du;
+  hash = (hash ^ (hash >> 15)) * 0x846ca68bu;
+  hash = hash ^ (hash >> 16);
+
+  const float angle = float(hash) * (6.28318530718f / 4294967296.0f);
+  return {std::cos(angle), std::sin(angle)};
+}
+
+/// @brief Queue generation job which sets result to promise, and return future of result.
+template <typename TFunction>
+std::future<std::optional<DRandomMapMesh>> 
+EnqueueMeshJob(std::shared_ptr<std::atomic<bool>> cancelled, TFunction&& function)
+{
+  // FWorkerPool takes copyable task, so promise is shared.
+  auto promise = std::make_shared<std::promise<std::optional<DRandomMapMesh>>>();
+  auto result = promise->get_future();
+
+  GetWorkerPool().Enqueue(
+  [promise, cancelled = std::move(cancelled), function = std::forward<TFunction>(function)]
+  {
+    if (cancelled->load() == true) 
+    { 
+      promise->set_value(std::nullopt); 
+      return;
     }
-  }  
+    promise->set_value(function(*cancelled));
+  });
 
-  return std::move(gradientMap);
+  return result;
 }
 
-/// @brief
-DDynamicGrid2D<DVector2<TReal>>
-Create2DCenterPointMap(
-  const DDynamicGrid2D<DVector2<TReal>>& gradient, 
-  const std::array<int, 2>& grid, std::size_t fragment)
+} /// ::anonymous namespace
+
+std::optional<DRandomMapMesh> 
+MRandomMap::MakeMap(
+  const std::array<int, 2>& grid, std::size_t fragment, std::uint32_t seed, 
+  const std::atomic<bool>& cancelled)
 {
-  DDynamicGrid2D<DVector2<TReal>> centerPointMap = 
-  { 
-    std::size_t(grid[0] * fragment), 
-    std::size_t(grid[1] * fragment) 
+  TIME_CHECK_CPU("MakeMap");
+
+  // Get random gradient value.
+  auto [gradientX, gradientY] = CreateGradients(grid, seed);
+  const FGradientNoiseKernel kernel = 
+  {
+    std::move(gradientX), std::move(gradientY), 
+    std::size_t(grid[0]), std::size_t(grid[1]), fragment
   };
 
-  const auto col = gradient.GetColumnSize() - 1;
-  const auto row = gradient.GetRowSize() - 1;
-  for (std::size_t y = 0; y < row; ++y)
+  const auto colSize = kernel.GetColumnSize();
+  const auto rowSize = kernel.GetRowSize();
+
+  // Get height of each fragment sample.
+  // Each block only writes its own rows, so result does not depend on thread count.
+  // Cancelled blocks are skipped, and result is discarded after all blocks are returned.
+  DRandomMapMesh mesh;
+  mesh.mHeights.resize(colSize * rowSize);
+  GetWorkerPool().ParallelFor(rowSize, GetRowBlockSize(rowSize), 
+  [&kernel, &mesh, &cancelled, colSize](std::size_t begin, std::size_t end)
   {
-    const auto iY = fragment * y;
-    for (std::size_t x = 0; x < col; ++x)
-    {
-      const auto iX = fragment * x;
-      for (const auto& [pos, offset] : CalculateOffset(fragment))
-      {
-        centerPointMap[iY + pos.Y][iX + pos.X] = DVector2<TI32>{TI32(x), TI32(y)} + offset;
-      }
-    }
-  }
+    if (cancelled.load(std::memory_order_relaxed) == true) { return; }
+    kernel.CalculateRows(begin, end, mesh.mHeights.data() + begin * colSize);
+  });
+  if (cancelled.load() == true) { return std::nullopt; }
 
-  return std::move(centerPointMap);
+  mesh.mTopology = GetTopology(colSize, rowSize);
+  return mesh;
 }
 
-/// @brief Calculate offset of each vertex that has height on each grid.
-/// Result vector has a pair of relative index and offset item.
-std::vector<std::pair<DVector2<TI32>, DVector2<TReal>>>
-CalculateOffset(std::size_t fragmentNum)
+std::future<std::optional<DRandomMapMesh>> 
+MRandomMap::RequestMap(
+  const std::array<int, 2>& grid, std::size_t fragment, std::uint32_t seed, 
+  std::shared_ptr<std::atomic<bool>> cancelled)
 {
-  const TReal edgeOffset    = 1 / static_cast<TReal>(fragmentNum * 2);
-  const TReal centerOffset  = 1 / static_cast<TReal>(fragmentNum);
+  return EnqueueMeshJob(std::move(cancelled), [grid, fragment, seed](const std::atomic<bool>& cancelled)
+  {
+    return MakeMap(grid, fragment, seed, cancelled);
+  });
+}
 
-  std::vector<std::pair<DVector2<TI32>, DVector2<TReal>>> result = {};
-  TReal yPos = 0.0f;
-  for (decltype(fragmentNum) y = 0; y < fragmentNum; ++y)
+std::optional<DRandomMapMesh> 
+MRandomMap::MakeTile(
+  const std::array<int, 2>& tile, std::size_t tileCells, std::size_t fragment, std::uint32_t seed, 
+  const std::atomic<bool>& cancelled)
+{
+  TIME_CHECK_CPU("MakeTile");
+
+  // Kernel covers one more cell of each axis to calculate the first sample row and column of next tile.
+  const auto cells = tileCells + 1;
+  const auto nodes = cells + 1;
+  std::vector<float> gradientX(nodes * nodes);
+  std::vector<float> gradientY(nodes * nodes);
+  for (std::size_t y = 0; y < nodes; ++y)
   {
-    if (y == 0) { yPos += edgeOffset; } else { yPos += centerOffset; }
-    TReal xPos = 0.0f;
-    for (decltype(fragmentNum) x = 0; x < fragmentNum; ++x)
+    for (std::size_t x = 0; x < nodes; ++x)
     {
-      if (x == 0) { xPos += edgeOffset; } else { xPos += centerOffset; }
-      result.emplace_back(
-        DVector2<TI32>{(TI32)x, (TI32)y}, 
-        DVector2<TReal>{xPos, yPos}
-      );
+      const auto [gx, gy] = GetNodeGradient(
+        std::int32_t(tile[0] * std::int64_t(tileCells) + std::int64_t(x)), 
+        std::int32_t(tile[1] * std::int64_t(tileCells) + std::int64_t(y)), 
+        seed);
+      gradientX[y * nodes + x] = gx;
+      gradientY[y * nodes + x] = gy;
     }
   }
+  const FGradientNoiseKernel kernel = {std::move(gradientX), std::move(gradientY), cells, cells, fragment};
 
-  return result;
-}
+  // Tiles are small and many tiles are generated at once, so rows are not split into blocks.
+  const auto size = tileCells * fragment + 1;
+  std::vector<float> rows(size * kernel.GetColumnSize());
+  kernel.CalculateRows(0, size, rows.data());
+  if (cancelled.load() == true) { return std::nullopt; }
+
+  DRandomMapMesh mesh;
+  mesh.mHeights.resize(size * size);
+  for (std::size_t y = 0; y < size; ++y)
+  {
+    const float* row = rows.data() + y * kernel.GetColumnSize();
+    std::copy(row, row + size, mesh.mHeights.data() + y * size);
+  }
 
+  mesh.mTopology = GetTopology(size, size);
+  return mesh;
 }
 
-void MRandomMap::MakeMap(const std::array<int, 2>& grid, std::size_t fragment)
+std::future<std::optional<DRandomMapMesh>> 
+MRandomMap::RequestTile(
+  const std::array<int, 2>& tile, std::size_t tileCells, std::size_t fragment, std::uint32_t seed, 
+  std::shared_ptr<std::atomic<bool>> cancelled)
 {
-  // Get random gradient value.
-  auto gradientMap = Create2DGradientMap(grid);
-
-  // Get height value of center-point of each grid cell. Make center-point map.
-  DDynamicGrid2D<DVector2<TReal>> centerPointMap = Create2DCenterPointMap(gradientMap, grid, fragment);
-  
-  // Get Height map from center-point map using linear interpolation.
-  auto DotGridGradient = [&](const DVector2<TReal>& centerPoint, const DVector2<TI32>& index) -> TReal
+  return EnqueueMeshJob(std::move(cancelled), [tile, tileCells, fragment, seed](const std::atomic<bool>& cancelled)
   {
-    const DVector2<TReal> delta = centerPoint - index;
-    return Dot(gradientMap.Get(index.X, index.Y), delta);
-  };
+    return MakeTile(tile, tileCells, fragment, seed, cancelled);
+  });
+}
 
-  // Calculate heights
-  mHeightMap2.Resize(centerPointMap.GetColumnSize(), centerPointMap.GetRowSize());
-  for (std::size_t y = 0, ySize = mHeightMap2.GetRowSize(); y < ySize; ++y)
+std::shared_ptr<const DRandomMapTopology> 
+MRandomMap::GetTopology(std::size_t columnSize, std::size_t rowSize)
+{
+  const auto key = (std::uint64_t(columnSize) << 32) | std::uint64_t(rowSize);
   {
-    for (std::size_t x = 0, xSize = mHeightMap2.GetColumnSize(); x < xSize; ++x)
+    std::lock_guard<std::mutex> lock{mTopologyMutex};
+    if (auto it = mTopologies.find(key); it != mTopologies.end())
     {
-      // Get values 
-      const auto& centerPoint = centerPointMap.Get(x, y);
-      const DVector2<TI32> _0 = {static_cast<TI32>(centerPoint.X), static_cast<TI32>(centerPoint.Y)};
-      const DVector2<TI32> _1 = _0 + DVector2<TI32>{1};
-      const DVector2<TReal> weight = centerPoint - _0;
-
-      // Get node's point.
-      const TReal n00 = DotGridGradient(centerPoint, _0);
-      const TReal n10 = DotGridGradient(centerPoint, {_1.X, _0.Y});
-      const TReal x0 = Lerp(n00, n10, weight.X);
-
-      const TReal n01 = DotGridGradient(centerPoint, {_0.X, _1.Y});
-      const TReal n11 = DotGridGradient(centerPoint, _1);
-      const TReal x1 = Lerp(n01, n11, weight.X);
-
-      mHeightMap2.Set(x, y, Lerp(x0, x1, weight.Y));
+      if (auto topology = it->second.lock(); topology != nullptr) { return topology; }
     }
   }
 
-  // Set buffer with height-map.
-  mVertexBuffer2.Resize(mHeightMap2.GetColumnSize(), mHeightMap2.GetRowSize());
-  for (std::size_t y = 0; y < mVertexBuffer2.GetRowSize(); ++y)
+  // Build topology without lock, so requests of other size are not blocked.
+  TIME_CHECK_CPU("MakeTopology");
+  auto topology = std::make_shared<DRandomMapTopology>();
+  topology->mColumnSize = columnSize;
+  topology->mRowSize = rowSize;
+  topology->mPositions.resize(columnSize * rowSize);
+
+  auto& pool = GetWorkerPool();
+  pool.ParallelFor(rowSize, GetRowBlockSize(rowSize), [&topology, columnSize](std::size_t begin, std::size_t end)
   {
-    for (std::size_t x = 0; x < mVertexBuffer2.GetColumnSize(); ++x)
+    for (std::size_t y = begin; y < end; ++y)
     {
-      mVertexBuffer2.Set(
-        x, y, 
-        DVector3<TReal>{static_cast<TReal>(x), static_cast<TReal>(y), mHeightMap2.Get(x, y)}
-      );
+      auto* positions = topology->mPositions.data() + y * columnSize;
+      for (std::size_t x = 0; x < columnSize; ++x)
+      {
+        positions[x] = DVector2<TReal>{static_cast<TReal>(x), static_cast<TReal>(y)};
+      }
     }
-  }
+  });
 
-  // Set indice buffer index.
-  const auto rowLen = static_cast<TU32>(mVertexBuffer2.GetColumnSize());
-  for (std::size_t y = 0; y < mVertexBuffer2.GetRowSize() - 1; ++y)
+  // Set indice buffer index. Each quad row has fixed range in buffer.
+  const auto quadColSize = columnSize - 1;
+  const auto quadRowSize = rowSize - 1;
+  topology->mIndices.resize(quadColSize * quadRowSize * 6);
+  pool.ParallelFor(quadRowSize, GetRowBlockSize(quadRowSize), 
+  [&topology, columnSize, quadColSize](std::size_t begin, std::size_t end)
   {
-    for (std::size_t x = 0; x < mVertexBuffer2.GetColumnSize() - 1; ++x)
+    const auto rowLen = static_cast<TU32>(columnSize);
+    for (std::size_t y = begin; y < end; ++y)
     {
-      const unsigned i = (unsigned)(x + y * rowLen);
-      mIndiceBuffer.emplace_back(i);
-      mIndiceBuffer.emplace_back(i + rowLen);
-      mIndiceBuffer.emplace_back(i + 1);
-
-      mIndiceBuffer.emplace_back(i + 1);
-      mIndiceBuffer.emplace_back(i + rowLen);
-      mIndiceBuffer.emplace_back(i + rowLen + 1);
+      unsigned* indices = topology->mIndices.data() + y * quadColSize * 6;
+      for (std::size_t x = 0; x < quadColSize; ++x, indices += 6)
+      {
+        const unsigned i = (unsigned)(x + y * rowLen);
+        indices[0] = i;
+        indices[1] = i + rowLen;
+        indices[2] = i + 1;
+
+        indices[3] = i + 1;
+        indices[4] = i + rowLen;
+        indices[5] = i + rowLen + 1;
+      }
     }
+  });
+
+  // Other thread may have built same topology meanwhile. Use the cached one to share single instance.
+  std::lock_guard<std::mutex> lock{mTopologyMutex};
+  auto& cached = mTopologies[key];
+  if (auto existing = cached.lock(); existing != nullptr) { return existing; }
+
+  // Remove entries of released topologies, not to grow cache with every size visited.
+  for (auto it = mTopologies.begin(); it != mTopologies.end();)
+  {
+    if (it->second.expired() == true && it->first != key) { it = mTopologies.erase(it); } else { ++it; }
   }
+
+  cached = topology;
+  return topology;
 }
 
-DDynamicGrid2D<float> MRandomMap::mHeightMap2 = {8 * 2, 8 * 2};
-DDynamicGrid2D<DVector3<TReal>> MRandomMap::mVertexBuffer2 = {8 * 2, 8 * 2};
-std::vector<unsigned> MRandomMap::mIndiceBuffer;
+std::mutex MRandomMap::mTopologyMutex;
+std::unordered_map<std::uint64_t, std::weak_ptr<const DRandomMapTopology>> MRandomMap::mTopologies;
@@ -25,8 +25,11 @@
 #include <StringUtil/XUtility.h>
 #include <Math/Utility/XGraphicsMath.h>
 #include <Graphics/MD3D11Resources.h>
+#include <Profiling/MMetrics.h>
 #include <Profiling/MTimeChecker.h>
+#include <Profiling/MTraceCapture.h>
 #include <PLowInputMousePos.h>
+#include <FFrameLoop.h>
 #include <FWindowsPlatform.h>
 
 #include <HelperMacro.h>
@@ -54,6 +57,12 @@ int WINAPI WinMain(
   // Create base system.
   platform = std::make_unique<dy::FWindowsPlatform>();
   platform->InitPlatform();
+  // Calibrate profiling clock before the first frame, so the first profiled frame is not stalled.
+  // This thread runs frame loop, so it is also bound as frame thread of profiler here.
+  MTimeChecker::Initialize();
+  // Sample metrics on background thread, so GUI reads history instead of calling OS every frame.
+  MMetrics::RegisterDefaultMetrics(platform->GetProfilingManager());
+  MMetrics::StartSampling();
 #if defined(_DEBUG)
   platform->CreateConsoleWindow();
 #endif
@@ -121,10 +130,12 @@ int WINAPI WinMain(
 
     // Create Vertex shader input layout.
     // https://docs.microsoft.com/en-us/windows/desktop/api/d3d11/ns-d3d11-d3d11_input_element_desc
-    std::array<D3D11_INPUT_ELEMENT_DESC, 1> vertexDesc =
+    // Grid position is shared by terrains of same size (slot 0), and height is per terrain (slot 1).
+    std::array<D3D11_INPUT_ELEMENT_DESC, 2> vertexDesc =
     {
       decltype(vertexDesc)::value_type
-      {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA , 0},
+      {"POSITION", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA , 0},
+      {"HEIGHT", 0, DXGI_FORMAT_R32_FLOAT, 1, 0, D3D11_INPUT_PER_VERTEX_DATA , 0},
     };
 
     const auto optIL = MD3D11Resources::CreateInputLayout(
@@ -149,16 +160,6 @@ int WINAPI WinMain(
     MD3D11Resources::RemoveBlob(*optPSBlob);
   }
 
-  //!
-  //! Create Queries
-  //!
-
-  // Make timestamp queries (disjoint and start-end queries)
-  // https://docs.microsoft.com/ko-kr/windows/desktop/api/d3d11/nf-d3d11-id3d11device-createquery
-  auto handleDisjoint = *MD3D11Resources::CreateQuerySimple(defaults.mDevice, E11SimpleQueryType::TimeStampDisjoint);
-  auto [handleFrameStart, handleFrameEnd] = *FD3D11Factory::CreateTimestampQueryPair2(defaults.mDevice);
-  auto [handleDrawStart, handleDrawEnd] = *FD3D11Factory::CreateTimestampQueryPair2(defaults.mDevice);
-
   //!
   //! Set initial settings.
   //!
@@ -239,56 +240,65 @@ int WINAPI WinMain(
     auto bVS          = MD3D11Resources::GetVertexShader(handleVS);
     auto bPS          = MD3D11Resources::GetPixelShader(handlePS);
 
-    auto bDisjoint    = MD3D11Resources::GetQuery(handleDisjoint);
-    auto bFrameStart  = MD3D11Resources::GetQuery(handleFrameStart);
-    auto bFrameEnd    = MD3D11Resources::GetQuery(handleFrameEnd);
-    auto bDrawStart   = MD3D11Resources::GetQuery(handleDrawStart);
-    auto bDrawEnd     = MD3D11Resources::GetQuery(handleDrawEnd);
-
     auto bSwapCHain   = MD3D11Resources::GetSwapChain(defaults.mSwapChain);
 
-    DObjTerrain paramTerrain = {&defaults, &hCbObject};
-    FObjTerrain terrain{}; terrain.Initialize(&paramTerrain);
-
     DObjCamera paramCamera = {&defaults, &hCbViewProj};
     FObjCamera camera{};
     camera.Initialize(&paramCamera);
 
+    DObjTerrain paramTerrain = {&defaults, &hCbObject, &camera};
+    FObjTerrain terrain{}; terrain.Initialize(&paramTerrain);
+
+    // Simulate with fixed step, and cap frame rate not to spin CPU.
+    dy::PFrameLoopDescriptor loopDesc;
+    loopDesc.mMaxFrameRate = 120.0;
+    dy::FFrameLoop frameLoop{loopDesc};
+
     // Loop
     while (platform->CanShutdown() == false)
     {
-      // Update Routine
-      TIME_CHECK_CPU("CpuFrame");
-      platform->PollEvents();
-      MGuiManager::Update();
-
-      camera.Update(0.016f);
-      terrain.Update(0.0f);
-
-      // Render Routine
-      TIME_CHECK_D3D11_STALL(gpuTime, "GpuFrame", bDisjoint.GetRef(), d3dDc.GetRef());
+      frameLoop.BeginFrame();
       {
-        // https://bell0bytes.eu/shader-data/
-        TIME_CHECK_FRAGMENT(gpuTime, "Overall", bFrameStart.GetRef(), bFrameEnd.GetRef());
-
-        d3dDc->ClearRenderTargetView(bRTV.GetPtr(), std::array<FLOAT, 4>{0, 0, 0, 1}.data());
-        d3dDc->ClearDepthStencilView(bDSV.GetPtr(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
-
-        d3dDc->VSSetShader(bVS.GetPtr(), nullptr, 0);
-        d3dDc->PSSetShader(bPS.GetPtr(), nullptr, 0);
+        // Update Routine
+        TIME_CHECK_CPU("CpuFrame");
+        platform->PollEvents();
+        MGuiManager::Update();
 
-        // Render objects
+        while (frameLoop.StepFixed() == true)
         {
-          TIME_CHECK_FRAGMENT(gpuTime, "Draw", bDrawStart.GetRef(), bDrawEnd.GetRef());
-          terrain.Render();
-          camera.Render();
+          camera.Update(frameLoop.GetFixedStep());
+          terrain.Update(frameLoop.GetFixedStep());
         }
 
-        // Render GUI items.
-        MGuiManager::Render();
-        // Present the back buffer to the screen.
-        HR(bSwapCHain->Present(0, 0));
+        // Render Routine
+        TIME_CHECK_D3D11(gpuTime, "GpuFrame", defaults.mDevice);
+        {
+          // https://bell0bytes.eu/shader-data/
+          TIME_CHECK_FRAGMENT(gpuTime, "Overall");
+
+          d3dDc->ClearRenderTargetView(bRTV.GetPtr(), std::array<FLOAT, 4>{0, 0, 0, 1}.data());
+          d3dDc->ClearDepthStencilView(bDSV.GetPtr(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+
+          d3dDc->VSSetShader(bVS.GetPtr(), nullptr, 0);
+          d3dDc->PSSetShader(bPS.GetPtr(), nullptr, 0);
+
+          // Render objects with state interpolated between fixed steps.
+          {
+            TIME_CHECK_FRAGMENT(gpuTime, "Draw");
+            const float alpha = frameLoop.GetAlpha();
+            camera.Interpolate(alpha);
+            terrain.Interpolate(alpha);
+            terrain.Render();
+            camera.Render();
+          }
+
+          // Render GUI items.
+          MGuiManager::Render();
+          // Present the back buffer to the screen.
+          HR(bSwapCHain->Present(0, 0));
+        }
       }
+      frameLoop.EndFrame();
     }
 
     camera.Release(nullptr);
@@ -298,13 +308,9 @@ int WINAPI WinMain(
   MGuiManager::Shutdown();
   
   // Remove all resources.
-  {
-    MD3D11Resources::RemoveQuery(handleFrameStart);
-    MD3D11Resources::RemoveQuery(handleFrameEnd);
-    MD3D11Resources::RemoveQuery(handleDrawStart);
-    MD3D11Resources::RemoveQuery(handleDrawEnd);
-    MD3D11Resources::RemoveQuery(handleDisjoint);
-  }
+  MMetrics::StopSampling();
+  MTraceCapture::StopCapture();
+  MTimeChecker::ReleaseD3D11Queries();
   {
     const auto flag = MD3D11Resources::RemovePixelShader(handlePS);
     assert(flag == true);
@@ -0,0 +1,92 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <XTerrainBuffers.h>
+#include <cassert>
+#include <map>
+#include <D3D11.h>
+#include <Graphics/MD3D11Resources.h>
+#include <MRandomMap.h>
+
+namespace
+{
+
+/// Topology buffers of each topology. Only accessed by render thread.
+std::map<const DRandomMapTopology*, DTopologyBuffers> sTopologyBuffers;
+
+/// @brief Create buffer with initial data.
+D11HandleBuffer CreateVertexBuffer(
+  const D11HandleDevice& device, D3D11_USAGE usage, UINT bindFlags, const void* data, std::size_t byteSize)
+{
+  D3D11_BUFFER_DESC desc = {};
+  desc.Usage = usage;
+  desc.ByteWidth = UINT(byteSize);
+  desc.BindFlags = bindFlags;
+  desc.CPUAccessFlags = 0;
+  desc.MiscFlags = 0;
+  desc.StructureByteStride = 0;
+
+  // Creation fails when device is removed, so null handle is returned and callers check it.
+  const auto optHandle = MD3D11Resources::CreateBuffer(device, desc, data);
+  if (optHandle.has_value() == false) { return nullptr; }
+  return *optHandle;
+}
+
+} /// ::anonymous namespace
+
+const DTopologyBuffers* AcquireTopologyBuffers(const D11HandleDevice& device, const DRandomMapTopology& topology)
+{
+  auto& buffers = sTopologyBuffers[&topology];
+  if (buffers.mRefCount == 0)
+  {
+    buffers.mPositionBuffer = CreateVertexBuffer(
+      device, D3D11_USAGE_IMMUTABLE, D3D11_BIND_VERTEX_BUFFER, 
+      topology.mPositions.data(), sizeof(DVector2<TReal>) * topology.mPositions.size());
+    buffers.mIndexBuffer = CreateVertexBuffer(
+      device, D3D11_USAGE_IMMUTABLE, D3D11_BIND_INDEX_BUFFER, 
+      topology.mIndices.data(), sizeof(TU32) * topology.mIndices.size());
+
+    if (buffers.mPositionBuffer.IsValid() == false || buffers.mIndexBuffer.IsValid() == false)
+    {
+      MD3D11Resources::RemoveBuffer(buffers.mPositionBuffer);
+      MD3D11Resources::RemoveBuffer(buffers.mIndexBuffer);
+      sTopologyBuffers.erase(&topology);
+      return nullptr;
+    }
+  }
+
+  buffers.mRefCount += 1;
+  return &buffers;
+}
+
+void ReleaseTopologyBuffers(const DRandomMapTopology& topology)
+{
+  const auto it = sTopologyBuffers.find(&topology);
+  assert(it != sTopologyBuffers.end());
+
+  auto& buffers = it->second;
+  buffers.mRefCount -= 1;
+  if (buffers.mRefCount > 0) { return; }
+
+  MD3D11Resources::RemoveBuffer(buffers.mPositionBuffer);
+  MD3D11Resources::RemoveBuffer(buffers.mIndexBuffer);
+  sTopologyBuffers.erase(it);
+}
+
+D11HandleBuffer CreateHeightBuffer(const D11HandleDevice& device, const std::vector<float>& heights)
+{
+  // Height buffer is updated when map is regenerated, so it is not immutable.
+  return CreateVertexBuffer(
+    device, D3D11_USAGE_DEFAULT, D3D11_BIND_VERTEX_BUFFER, 
+    heights.data(), sizeof(float) * heights.size());
+}
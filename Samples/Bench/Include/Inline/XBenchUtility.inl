@@ -0,0 +1,66 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+template <typename TFunction>
+DBenchResult MeasureBench(std::size_t iterations, std::size_t runs, TFunction&& function)
+{
+  using TClock = std::chrono::steady_clock;
+
+  for (std::size_t i = 0; i < iterations; ++i) { function(i); }
+
+  std::vector<double> times;
+  times.reserve(runs);
+  for (std::size_t run = 0; run < runs; ++run)
+  {
+    const auto start = TClock::now();
+    for (std::size_t i = 0; i < iterations; ++i) { function(i); }
+    const auto elapsed = std::chrono::duration<double, std::nano>(TClock::now() - start).count();
+    times.push_back(elapsed / double(iterations));
+  }
+
+  std::sort(times.begin(), times.end());
+  DBenchResult result;
+  result.mMedianNs = times[times.size() / 2];
+  result.mMinNs = times.front();
+  result.mMaxNs = times.back();
+  return result;
+}
+
+template <typename TType>
+void DoNotOptimize(const TType& value) noexcept
+{
+#if defined(_MSC_VER)
+  static volatile const void* sink = nullptr;
+  sink = &value;
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+inline void PrintBenchHeader(const char* title, const char* column)
+{
+  std::printf("\n%s\n\n", title);
+  std::printf("| %s | median ns | min ns | max ns |\n", column);
+  std::printf("|---|---:|---:|---:|\n");
+}
+
+inline void PrintBenchRow(const char* name, const DBenchResult& result)
+{
+  std::printf("| %s | %.1f | %.1f | %.1f |\n", name, result.mMedianNs, result.mMinNs, result.mMaxNs);
+}
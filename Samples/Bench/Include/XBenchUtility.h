@@ -0,0 +1,43 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstddef>
+#include <cstdint>
+
+/// @struct DBenchResult
+/// @brief Measured time of benchmark runs as nanoseconds per iteration.
+struct DBenchResult final
+{
+  double mMedianNs = 0.0;
+  double mMinNs = 0.0;
+  double mMaxNs = 0.0;
+};
+
+/// @brief Call function `iterations` times per run for `runs` runs, 
+/// and return nanoseconds per iteration of runs. Function gets index of iteration.
+/// One warm-up run is not measured.
+template <typename TFunction>
+DBenchResult MeasureBench(std::size_t iterations, std::size_t runs, TFunction&& function);
+
+/// @brief Prevent compiler from removing computation of given value.
+template <typename TType>
+void DoNotOptimize(const TType& value) noexcept;
+
+/// @brief Print header row of result table with given columns.
+void PrintBenchHeader(const char* title, const char* column);
+
+/// @brief Print result row as "| name | median | min | max |" nanoseconds.
+void PrintBenchRow(const char* name, const DBenchResult& result);
+
+#include <Inline/XBenchUtility.inl>
@@ -0,0 +1,139 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <d3d11.h>
+
+#include <ComWrapper/IComOwner.h>
+#include <Mock/FMockCommandLog.h>
+#include <Mock/FMockD3D11Factory.h>
+#include <XBenchUtility.h>
+
+namespace
+{
+
+constexpr size_t kBorrowCount = 2'000'000;
+
+/// @class FLockedBorrowCounter
+/// @brief Borrow tracking of XComCounter before it became lock-free.
+/// Counter is updated by separate load and store, and each borrow is registered to vector under mutex.
+class FLockedBorrowCounter final
+{
+public:
+  void syncPush(const void* pBorrow)
+  {
+    const auto counter = this->mCounter.load(std::memory_order_acquire);
+    this->mCounter.store(counter + 1, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(this->mMutexBorrows);
+    this->mBorrows.emplace_back(pBorrow);
+  }
+
+  void syncPop(const void* pBorrow)
+  {
+    const auto counter = this->mCounter.load(std::memory_order_acquire);
+    this->mCounter.store(counter - 1, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(this->mMutexBorrows);
+    const auto it = std::find(this->mBorrows.begin(), this->mBorrows.end(), pBorrow);
+    this->mBorrows.erase(it);
+  }
+
+private:
+  std::atomic<uint32_t> mCounter = 0;
+  std::mutex mMutexBorrows;
+  std::vector<const void*> mBorrows;
+};
+
+/// @brief Run `threadCount` threads which borrow and release the same owner `kBorrowCount` times in total.
+/// @return Wall time per borrow as nanoseconds.
+template <typename TFunction>
+double RunBorrows(size_t threadCount, TFunction&& function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([&]
+    {
+      const size_t count = kBorrowCount / threadCount;
+      for (size_t i = 0; i < count; ++i) { function(); }
+    });
+  }
+  for (auto& thread : threads) { thread.join(); }
+
+  const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  return elapsed / double(kBorrowCount);
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  FMockCommandLog deviceLog;
+  FMockCommandLog contextLog;
+  ID3D11Device* pDevice = nullptr;
+  ID3D11DeviceContext* pDc = nullptr;
+  if (FAILED(FMockD3D11Factory::CreateDevice(deviceLog, contextLog, &pDevice, &pDc))) { return 1; }
+
+  D3D11_BUFFER_DESC desc = {};
+  desc.ByteWidth = 64;
+  desc.Usage = D3D11_USAGE_DEFAULT;
+  desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+  ID3D11Buffer* pBuffer = nullptr;
+  if (FAILED(pDevice->CreateBuffer(&desc, nullptr, &pBuffer))) { return 1; }
+
+  // Every thread borrows the same owner, as render and loader threads borrow the same shared resource.
+  IComOwner<ID3D11Buffer, XComChecked> owner{pBuffer};
+  FLockedBorrowCounter lockedCounter;
+  // Some borrows are alive for long time, such as borrows stored in object of sample.
+  std::vector<IComBorrow<ID3D11Buffer, XComChecked>> longBorrows;
+  for (size_t i = 0; i < 64; ++i) 
+  { 
+    longBorrows.emplace_back(owner.GetBorrow()); 
+    lockedCounter.syncPush(&longBorrows.back());
+  }
+
+  std::printf("Borrow and release of one shared owner, %zu borrows in total, %u hardware threads\n", 
+    kBorrowCount, std::thread::hardware_concurrency());
+  std::printf("\n| threads | lock-free ns/borrow | mutex ns/borrow |\n");
+  std::printf("|---:|---:|---:|\n");
+  for (const size_t threadCount : {1, 2, 4, 8, 16, 32, 64})
+  {
+    const double lockFree = RunBorrows(threadCount, [&]
+    {
+      auto borrow = owner.GetBorrow();
+      DoNotOptimize(borrow.GetPtr());
+    });
+    const double locked = RunBorrows(threadCount, [&]
+    {
+      int borrow = 0;
+      lockedCounter.syncPush(&borrow);
+      DoNotOptimize(borrow);
+      lockedCounter.syncPop(&borrow);
+    });
+    std::printf("| %zu | %.1f | %.1f |\n", threadCount, lockFree, locked);
+  }
+
+  longBorrows.clear();
+  owner.Release();
+  pDc->Release();
+  pDevice->Release();
+  return 0;
+}
@@ -0,0 +1,89 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdio>
+#include <d3d11.h>
+
+#include <ComWrapper/IComOwner.h>
+#include <Mock/FMockCommandLog.h>
+#include <Mock/FMockD3D11Factory.h>
+#include <XBenchUtility.h>
+
+namespace
+{
+
+constexpr size_t kIterationCount = 10'000'000;
+constexpr size_t kRunCount = 5;
+
+/// @brief Measure borrow operations of given policy. 
+/// Both policies are instantiated explicitly, so COMWRAPPER_CHECKED does not change this bench.
+template <typename TPolicy>
+void RunPolicy(ID3D11Buffer& buffer, const char* policyName)
+{
+  buffer.AddRef();
+  IComOwner<ID3D11Buffer, TPolicy> owner{&buffer};
+  auto storedBorrow = owner.GetBorrow();
+
+  char name[64];
+  std::snprintf(name, sizeof(name), "GetBorrow + release, %s", policyName);
+  PrintBenchRow(name, MeasureBench(kIterationCount, kRunCount, [&](size_t)
+  {
+    auto borrow = owner.GetBorrow();
+    DoNotOptimize(borrow.GetPtr());
+  }));
+
+  // Borrow is passed by value into function of object.
+  std::snprintf(name, sizeof(name), "copy + release, %s", policyName);
+  PrintBenchRow(name, MeasureBench(kIterationCount, kRunCount, [&](size_t)
+  {
+    auto borrow = storedBorrow;
+    DoNotOptimize(borrow.GetPtr());
+  }));
+
+  // Stored borrow is used in each draw call.
+  std::snprintf(name, sizeof(name), "IsValid + GetPtr, %s", policyName);
+  PrintBenchRow(name, MeasureBench(kIterationCount, kRunCount, [&](size_t)
+  {
+    DoNotOptimize(storedBorrow.IsValid());
+    DoNotOptimize(storedBorrow.GetPtr());
+  }));
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  FMockCommandLog deviceLog;
+  FMockCommandLog contextLog;
+  ID3D11Device* pDevice = nullptr;
+  ID3D11DeviceContext* pDc = nullptr;
+  if (FAILED(FMockD3D11Factory::CreateDevice(deviceLog, contextLog, &pDevice, &pDc))) { return 1; }
+
+  D3D11_BUFFER_DESC desc = {};
+  desc.ByteWidth = 64;
+  desc.Usage = D3D11_USAGE_DEFAULT;
+  desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+  ID3D11Buffer* pBuffer = nullptr;
+  if (FAILED(pDevice->CreateBuffer(&desc, nullptr, &pBuffer))) { return 1; }
+
+  std::printf("sizeof IComBorrow : checked %zu bytes, unchecked %zu bytes\n", 
+    sizeof(IComBorrow<ID3D11Buffer, XComChecked>), sizeof(IComBorrow<ID3D11Buffer, XComUnchecked>));
+  PrintBenchHeader("COM wrapper policy, per operation", "operation");
+  RunPolicy<XComChecked>(*pBuffer, "checked");
+  RunPolicy<XComUnchecked>(*pBuffer, "unchecked");
+
+  pBuffer->Release();
+  pDc->Release();
+  pDevice->Release();
+  return 0;
+}
@@ -0,0 +1,146 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <d3d11.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <ComWrapper/IComOwner.h>
+#include <Mock/FMockCommandLog.h>
+#include <Mock/FMockD3D11Factory.h>
+#include <XBenchUtility.h>
+
+namespace
+{
+
+constexpr size_t kWrapperCount = 100'000;
+
+/// @brief The number of calls and requested bytes of global operator new.
+size_t sNewCount = 0;
+size_t sNewBytes = 0;
+
+/// @struct DHeapSample
+/// @brief Heap statistics at one point.
+struct DHeapSample final
+{
+  size_t mNewCount = 0;
+  size_t mNewBytes = 0;
+  /// @brief Bytes in use of malloc heap. 0 when not supported.
+  size_t mHeapBytes = 0;
+  DComPoolStatistics mPool;
+  std::chrono::steady_clock::time_point mTime;
+};
+
+DHeapSample SampleHeap()
+{
+  DHeapSample sample;
+  sample.mNewCount = sNewCount;
+  sample.mNewBytes = sNewBytes;
+#if defined(__GLIBC__)
+  sample.mHeapBytes = mallinfo2().uordblks;
+#endif
+  sample.mPool = XComBlockPoolBase::GetTotalStatistics();
+  sample.mTime = std::chrono::steady_clock::now();
+  return sample;
+}
+
+void PrintPhase(const char* name, const DHeapSample& begin, const DHeapSample& end)
+{
+  const auto elapsed = std::chrono::duration<double, std::nano>(end.mTime - begin.mTime).count();
+  std::printf("| %s | %zu | %zu | %lld | %llu | %.1f |\n", 
+    name, 
+    end.mNewCount - begin.mNewCount, 
+    end.mNewBytes - begin.mNewBytes,
+    static_cast<long long>(end.mHeapBytes) - static_cast<long long>(begin.mHeapBytes),
+    static_cast<unsigned long long>(end.mPool.mChunkAllocations - begin.mPool.mChunkAllocations),
+    elapsed / double(kWrapperCount));
+}
+
+} /// ::anonymous namespace
+
+/// Count heap allocations of whole program. Control blocks are allocated by operator new when not pooled, 
+/// and pool allocates its chunks by operator new.
+void* operator new(std::size_t size)
+{
+  sNewCount += 1;
+  sNewBytes += size;
+  if (void* pMemory = std::malloc(size == 0 ? 1 : size); pMemory != nullptr) { return pMemory; }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pMemory) noexcept
+{
+  std::free(pMemory);
+}
+
+void operator delete(void* pMemory, std::size_t) noexcept
+{
+  std::free(pMemory);
+}
+
+int main()
+{
+  FMockCommandLog deviceLog;
+  FMockCommandLog contextLog;
+  deviceLog.SetRecording(false);
+  ID3D11Device* pDevice = nullptr;
+  ID3D11DeviceContext* pDc = nullptr;
+  if (FAILED(FMockD3D11Factory::CreateDevice(deviceLog, contextLog, &pDevice, &pDc))) { return 1; }
+
+  // Mock buffers are created before measurement. Each buffer has one more reference, 
+  // so buffers are alive after owners are released and can be wrapped again.
+  D3D11_BUFFER_DESC desc = {};
+  desc.ByteWidth = 64;
+  desc.Usage = D3D11_USAGE_DEFAULT;
+  desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+  std::vector<ID3D11Buffer*> buffers(kWrapperCount, nullptr);
+  for (auto& pBuffer : buffers)
+  {
+    if (FAILED(pDevice->CreateBuffer(&desc, nullptr, &pBuffer))) { return 1; }
+  }
+
+  std::vector<IComOwner<ID3D11Buffer, XComChecked>> owners;
+  owners.reserve(kWrapperCount);
+
+  std::printf("%zu checked COM wrappers of mock buffer, control block pool %s, control block %zu bytes\n", 
+    kWrapperCount, COMWRAPPER_POOLED == 1 ? "enabled" : "disabled", sizeof(__IComOwner<ID3D11Buffer>));
+  std::printf("\n| phase | operator new calls | operator new bytes | heap in use delta bytes | pool chunks | ns/wrapper |\n");
+  std::printf("|---|---:|---:|---:|---:|---:|\n");
+  for (const char* phase : {"create", "create again"})
+  {
+    const auto createBegin = SampleHeap();
+    for (auto* pBuffer : buffers)
+    {
+      pBuffer->AddRef();
+      owners.emplace_back(pBuffer);
+    }
+    const auto createEnd = SampleHeap();
+    PrintPhase(phase, createBegin, createEnd);
+
+    const auto releaseBegin = SampleHeap();
+    owners.clear();
+    const auto releaseEnd = SampleHeap();
+    PrintPhase("release", releaseBegin, releaseEnd);
+  }
+
+  for (auto* pBuffer : buffers) { pBuffer->Release(); }
+  pDc->Release();
+  pDevice->Release();
+  return 0;
+}
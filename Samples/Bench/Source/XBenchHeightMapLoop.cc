@@ -0,0 +1,284 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <array>
+#include <cstdio>
+#include <vector>
+#include <d3d11.h>
+
+#include <FFrameLoop.h>
+#include <Mock/FMockCommandLog.h>
+#include <Mock/FMockD3D11Factory.h>
+#include <XBenchUtility.h>
+
+namespace
+{
+
+/// Tile of 3_HeightMap has 4 cells and 8 fragments for each axis. (PTerrainTileDescriptor)
+constexpr UINT kTileSamples = 4 * 8;
+constexpr UINT kTileVertexCount = (kTileSamples + 1) * (kTileSamples + 1);
+constexpr UINT kTileIndexCount = kTileSamples * kTileSamples * 6;
+/// GPU time of 3_HeightMap is resolved from queries issued this many frames before.
+constexpr size_t kQueryLatency = 4;
+constexpr size_t kFrameCount = 2000;
+constexpr size_t kRunCount = 5;
+
+/// @struct DTileMesh
+/// @brief Buffers of one terrain tile. XY position and height are separate streams.
+struct DTileMesh final
+{
+  ID3D11Buffer* mPosition = nullptr;
+  ID3D11Buffer* mHeight = nullptr;
+  ID3D11Buffer* mIndex = nullptr;
+};
+
+/// @struct DFrameQueries
+/// @brief Timestamp queries of one frame, as TIME_CHECK_D3D11 with "Overall" and "Draw" fragments.
+struct DFrameQueries final
+{
+  ID3D11Query* mDisjoint = nullptr;
+  std::array<ID3D11Query*, 4> mTimestamps = {};
+};
+
+ID3D11Buffer* CreateBuffer(ID3D11Device& device, UINT byteWidth, UINT bindFlags)
+{
+  D3D11_BUFFER_DESC desc = {};
+  desc.ByteWidth = byteWidth;
+  desc.Usage = D3D11_USAGE_DEFAULT;
+  desc.BindFlags = bindFlags;
+
+  std::vector<char> initial(byteWidth, 0);
+  D3D11_SUBRESOURCE_DATA data = {};
+  data.pSysMem = initial.data();
+
+  ID3D11Buffer* pBuffer = nullptr;
+  device.CreateBuffer(&desc, &data, &pBuffer);
+  return pBuffer;
+}
+
+ID3D11Texture2D* CreateTexture(ID3D11Device& device, DXGI_FORMAT format, UINT bindFlags)
+{
+  D3D11_TEXTURE2D_DESC desc = {};
+  desc.Width = 1280; desc.Height = 720;
+  desc.MipLevels = 1; desc.ArraySize = 1;
+  desc.Format = format;
+  desc.SampleDesc.Count = 1;
+  desc.Usage = D3D11_USAGE_DEFAULT;
+  desc.BindFlags = bindFlags;
+
+  ID3D11Texture2D* pTexture = nullptr;
+  device.CreateTexture2D(&desc, nullptr, &pTexture);
+  return pTexture;
+}
+
+ID3D11Query* CreateQuery(ID3D11Device& device, D3D11_QUERY type)
+{
+  const D3D11_QUERY_DESC desc = {type, 0};
+  ID3D11Query* pQuery = nullptr;
+  device.CreateQuery(&desc, &pQuery);
+  return pQuery;
+}
+
+/// @class FHeightMapLoop
+/// @brief Replay of frame loop of 3_HeightMap. 
+/// Each frame simulates fixed steps, clears targets, updates view-projection buffer, 
+/// and draws every visible tile with its object buffer, as FObjTerrain::DrawMesh does.
+class FHeightMapLoop final
+{
+public:
+  FHeightMapLoop(ID3D11Device& device, ID3D11DeviceContext& dc, size_t tileCount)
+    : mDc{dc}
+  {
+    this->mRenderTarget = CreateTexture(device, DXGI_FORMAT_R8G8B8A8_UNORM, D3D11_BIND_RENDER_TARGET);
+    this->mDepthStencil = CreateTexture(device, DXGI_FORMAT_D24_UNORM_S8_UINT, D3D11_BIND_DEPTH_STENCIL);
+    device.CreateRenderTargetView(this->mRenderTarget, nullptr, &this->mRtv);
+    device.CreateDepthStencilView(this->mDepthStencil, nullptr, &this->mDsv);
+
+    const std::array<char, 64> bytecode = {};
+    device.CreateVertexShader(bytecode.data(), bytecode.size(), nullptr, &this->mVs);
+    device.CreatePixelShader(bytecode.data(), bytecode.size(), nullptr, &this->mPs);
+
+    this->mCbViewProj = CreateBuffer(device, sizeof(float) * 32, D3D11_BIND_CONSTANT_BUFFER);
+    this->mCbObject = CreateBuffer(device, sizeof(float) * 16, D3D11_BIND_CONSTANT_BUFFER);
+
+    // Tiles share topology (XY position and index), and have their own height.
+    this->mPosition = CreateBuffer(device, kTileVertexCount * sizeof(float) * 2, D3D11_BIND_VERTEX_BUFFER);
+    this->mIndex = CreateBuffer(device, kTileIndexCount * sizeof(UINT), D3D11_BIND_INDEX_BUFFER);
+    for (size_t i = 0; i < tileCount; ++i)
+    {
+      DTileMesh tile;
+      tile.mPosition = this->mPosition;
+      tile.mHeight = CreateBuffer(device, kTileVertexCount * sizeof(float), D3D11_BIND_VERTEX_BUFFER);
+      tile.mIndex = this->mIndex;
+      this->mTiles.push_back(tile);
+    }
+
+    for (auto& queries : this->mQueries)
+    {
+      queries.mDisjoint = CreateQuery(device, D3D11_QUERY_TIMESTAMP_DISJOINT);
+      for (auto& pTimestamp : queries.mTimestamps) { pTimestamp = CreateQuery(device, D3D11_QUERY_TIMESTAMP); }
+    }
+  }
+
+  ~FHeightMapLoop()
+  {
+    for (auto& tile : this->mTiles) { tile.mHeight->Release(); }
+    for (auto& queries : this->mQueries)
+    {
+      queries.mDisjoint->Release();
+      for (auto* pTimestamp : queries.mTimestamps) { pTimestamp->Release(); }
+    }
+    this->mIndex->Release();
+    this->mPosition->Release();
+    this->mCbObject->Release();
+    this->mCbViewProj->Release();
+    this->mPs->Release();
+    this->mVs->Release();
+    this->mDsv->Release();
+    this->mRtv->Release();
+    this->mDepthStencil->Release();
+    this->mRenderTarget->Release();
+  }
+
+  /// @brief Run one frame with given delta time.
+  void RunFrame(dy::FFrameLoop& frameLoop, double deltaTime)
+  {
+    frameLoop.BeginFrame(deltaTime);
+    while (frameLoop.StepFixed() == true) { this->mTravel += 4.0f * frameLoop.GetFixedStep(); }
+
+    auto& queries = this->mQueries[this->mFrameIndex % kQueryLatency];
+    this->ResolveQueries(queries);
+    this->mDc.Begin(queries.mDisjoint);
+    this->mDc.End(queries.mTimestamps[0]);
+
+    this->mDc.ClearRenderTargetView(this->mRtv, std::array<FLOAT, 4>{0, 0, 0, 1}.data());
+    this->mDc.ClearDepthStencilView(this->mDsv, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+    this->mDc.VSSetShader(this->mVs, nullptr, 0);
+    this->mDc.PSSetShader(this->mPs, nullptr, 0);
+
+    this->mDc.End(queries.mTimestamps[1]);
+    {
+      // Camera is interpolated by alpha, and uploaded once per rendered frame.
+      std::array<float, 32> viewProj = {};
+      viewProj[12] = this->mTravel + frameLoop.GetAlpha();
+      this->mDc.UpdateSubresource(this->mCbViewProj, 0, nullptr, viewProj.data(), 0, 0);
+
+      std::array<float, 16> model = {};
+      const std::array<UINT, 2> strides = {sizeof(float) * 2, sizeof(float)};
+      const std::array<UINT, 2> offsets = {0, 0};
+      for (size_t i = 0; i < this->mTiles.size(); ++i)
+      {
+        const auto& tile = this->mTiles[i];
+        model[12] = float(i);
+        this->mDc.UpdateSubresource(this->mCbObject, 0, nullptr, model.data(), 0, 0);
+
+        const std::array<ID3D11Buffer*, 2> pVBuffers = {tile.mPosition, tile.mHeight};
+        this->mDc.IASetVertexBuffers(0, UINT(pVBuffers.size()), pVBuffers.data(), strides.data(), offsets.data());
+        this->mDc.IASetIndexBuffer(tile.mIndex, DXGI_FORMAT_R32_UINT, 0);
+        this->mDc.DrawIndexed(kTileIndexCount, 0, 0);
+      }
+    }
+    this->mDc.End(queries.mTimestamps[2]);
+    this->mDc.End(queries.mTimestamps[3]);
+    this->mDc.End(queries.mDisjoint);
+
+    frameLoop.EndFrame();
+    this->mFrameIndex += 1;
+  }
+
+private:
+  /// @brief Read queries of old frame which used this query set, as GPU time of 3_HeightMap is read.
+  void ResolveQueries(DFrameQueries& queries)
+  {
+    if (this->mFrameIndex < kQueryLatency) { return; }
+
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint = {};
+    while (this->mDc.GetData(queries.mDisjoint, &disjoint, sizeof(disjoint), 0) == S_FALSE) { }
+    for (auto* pTimestamp : queries.mTimestamps)
+    {
+      UINT64 timestamp = 0;
+      while (this->mDc.GetData(pTimestamp, &timestamp, sizeof(timestamp), 0) == S_FALSE) { }
+      DoNotOptimize(timestamp);
+    }
+  }
+
+  ID3D11DeviceContext& mDc;
+  ID3D11Texture2D* mRenderTarget = nullptr;
+  ID3D11Texture2D* mDepthStencil = nullptr;
+  ID3D11RenderTargetView* mRtv = nullptr;
+  ID3D11DepthStencilView* mDsv = nullptr;
+  ID3D11VertexShader* mVs = nullptr;
+  ID3D11PixelShader* mPs = nullptr;
+  ID3D11Buffer* mCbViewProj = nullptr;
+  ID3D11Buffer* mCbObject = nullptr;
+  ID3D11Buffer* mPosition = nullptr;
+  ID3D11Buffer* mIndex = nullptr;
+
+  std::vector<DTileMesh> mTiles;
+  std::array<DFrameQueries, kQueryLatency> mQueries;
+  size_t mFrameIndex = 0;
+  float mTravel = 0.0f;
+};
+
+} /// ::anonymous namespace
+
+int main()
+{
+  FMockCommandLog deviceLog;
+  FMockCommandLog contextLog;
+  ID3D11Device* pDevice = nullptr;
+  ID3D11DeviceContext* pDc = nullptr;
+  if (FAILED(FMockD3D11Factory::CreateDevice(deviceLog, contextLog, &pDevice, &pDc))) { return 1; }
+
+  // Long runs must not grow log, and only statistics are needed.
+  contextLog.SetRecording(false);
+
+  std::printf("3_HeightMap frame loop on mock D3D11 (%zu frames x %zu runs, %u indices per tile)\n", 
+    kFrameCount, kRunCount, kTileIndexCount);
+  std::printf("\n| tiles | ns/frame | ns/draw | calls/frame | uploaded bytes/frame |\n");
+  std::printf("|---:|---:|---:|---:|---:|\n");
+
+  // View radius 0, 1, 2 (default) and 3 of tile cache.
+  double emptyFrameNs = 0.0;
+  for (const size_t tileCount : {0, 1, 9, 25, 49})
+  {
+    FHeightMapLoop loop{*pDevice, *pDc, tileCount};
+    dy::PFrameLoopDescriptor desc;
+    desc.mMaxFrameRate = 120.0;
+    dy::FFrameLoop frameLoop{desc};
+
+    contextLog.Clear();
+    const auto result = MeasureBench(kFrameCount, kRunCount, [&](size_t) 
+    { 
+      loop.RunFrame(frameLoop, 1.0 / 120.0); 
+    });
+
+    uint64_t callCount = 0;
+    for (size_t i = 0; i < static_cast<size_t>(EMockD3D11Call::__Sum); ++i)
+    {
+      callCount += contextLog.GetCount(static_cast<EMockD3D11Call>(i));
+    }
+    const double frameCount = double(kFrameCount * (kRunCount + 1));
+    if (tileCount == 0) { emptyFrameNs = result.mMedianNs; }
+
+    // Cost per draw excludes fixed cost of frame (clear, shaders, queries) measured with no tile.
+    const double drawNs = tileCount == 0 ? 0.0 : (result.mMedianNs - emptyFrameNs) / double(tileCount);
+    std::printf("| %zu | %.1f | %.1f | %.1f | %.1f |\n", 
+      tileCount, result.mMedianNs, drawNs, 
+      double(callCount) / frameCount, double(contextLog.GetUploadedBytes()) / frameCount);
+  }
+
+  pDc->Release();
+  pDevice->Release();
+  return 0;
+}
@@ -0,0 +1,113 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <FGradientNoiseKernel.h>
+#include <XBenchUtility.h>
+
+namespace
+{
+
+constexpr size_t kRunCount = 5;
+
+/// @brief Get name of kernel path.
+const char* GetPathName(ENoiseKernelPath path)
+{
+  switch (path)
+  {
+  case ENoiseKernelPath::Scalar:  return "Scalar";
+  case ENoiseKernelPath::SSE:     return "SSE";
+  case ENoiseKernelPath::AVX2:    return "AVX2";
+  default: return "";
+  }
+}
+
+/// @brief Create kernel of random unit gradients, as MRandomMap::MakeMap.
+FGradientNoiseKernel CreateKernel(size_t grid, size_t fragment)
+{
+  std::mt19937 random{uint32_t(grid * 31 + fragment)};
+  std::uniform_real_distribution<float> angleDist{0.0f, 6.2831853f};
+
+  const size_t nodeCount = (grid + 1) * (grid + 1);
+  std::vector<float> gradientX(nodeCount);
+  std::vector<float> gradientY(nodeCount);
+  for (size_t i = 0; i < nodeCount; ++i)
+  {
+    const float angle = angleDist(random);
+    gradientX[i] = std::cos(angle);
+    gradientY[i] = std::sin(angle);
+  }
+  return FGradientNoiseKernel{std::move(gradientX), std::move(gradientY), grid, grid, fragment};
+}
+
+/// @brief Measure every compiled-in path of given grid, and check heights are bit-identical to scalar path.
+/// @return If heights of any path are different from scalar path, return false.
+bool RunGrid(size_t grid, size_t fragment)
+{
+  const auto kernel = CreateKernel(grid, fragment);
+  const size_t rowSize = kernel.GetRowSize();
+  const size_t sampleCount = rowSize * kernel.GetColumnSize();
+  // Small grids are repeated, so each run takes similar time.
+  const size_t iterationCount = (std::max)(size_t(1), size_t(4'000'000) / sampleCount);
+
+  std::vector<float> scalarHeights(sampleCount);
+  kernel.CalculateRows(0, rowSize, scalarHeights.data(), ENoiseKernelPath::Scalar);
+
+  bool isIdentical = true;
+  double scalarNs = 0.0;
+  for (const auto path : {ENoiseKernelPath::Scalar, ENoiseKernelPath::SSE, ENoiseKernelPath::AVX2})
+  {
+    if (FGradientNoiseKernel::IsSupported(path) == false) { continue; }
+
+    std::vector<float> heights(sampleCount);
+    const auto result = MeasureBench(iterationCount, kRunCount, [&](size_t)
+    {
+      kernel.CalculateRows(0, rowSize, heights.data(), path);
+      DoNotOptimize(heights.data());
+    });
+    const bool isPathIdentical = std::memcmp(heights.data(), scalarHeights.data(), sampleCount * sizeof(float)) == 0;
+    isIdentical = isIdentical && isPathIdentical;
+
+    const double nsPerSample = result.mMedianNs / double(sampleCount);
+    if (path == ENoiseKernelPath::Scalar) { scalarNs = nsPerSample; }
+    std::printf("| %zu x %zu, fragment %zu | %s | %zu | %.3f | %.2f | %.2fx | %s |\n", 
+      grid, grid, fragment, GetPathName(path), sampleCount, nsPerSample, 1.0 / nsPerSample, 
+      scalarNs / nsPerSample, isPathIdentical == true ? "yes" : "no");
+  }
+  return isIdentical;
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  std::printf("Gradient noise kernel of MRandomMap::MakeMap, default path is %s\n", 
+    GetPathName(FGradientNoiseKernel::GetDefaultPath()));
+  std::printf("\n| grid | path | samples | ns/sample | Gsamples/s | speedup | same as scalar |\n");
+  std::printf("|---|---|---:|---:|---:|---:|---|\n");
+
+  // 20 x 20 is the largest grid of GUI range. Fragment is swept beyond GUI range to see where explicit SIMD pays off.
+  constexpr size_t kGrid = 20;
+  bool isIdentical = true;
+  for (size_t fragment = 1; fragment <= 256; fragment *= 2)
+  {
+    isIdentical = RunGrid(kGrid, fragment) && isIdentical;
+  }
+  return isIdentical == true ? 0 : 1;
+}
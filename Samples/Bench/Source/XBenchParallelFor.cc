@@ -0,0 +1,117 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <FGradientNoiseKernel.h>
+#include <Thread/FWorkerPool.h>
+#include <XBenchUtility.h>
+
+namespace
+{
+
+constexpr size_t kRunCount = 5;
+
+/// @brief Create kernel of random unit gradients, as MRandomMap::MakeMap.
+FGradientNoiseKernel CreateKernel(size_t grid, size_t fragment)
+{
+  std::mt19937 random{uint32_t(grid * 31 + fragment)};
+  std::uniform_real_distribution<float> angleDist{0.0f, 6.2831853f};
+
+  const size_t nodeCount = (grid + 1) * (grid + 1);
+  std::vector<float> gradientX(nodeCount);
+  std::vector<float> gradientY(nodeCount);
+  for (size_t i = 0; i < nodeCount; ++i)
+  {
+    const float angle = angleDist(random);
+    gradientX[i] = std::cos(angle);
+    gradientY[i] = std::sin(angle);
+  }
+  return FGradientNoiseKernel{std::move(gradientX), std::move(gradientY), grid, grid, fragment};
+}
+
+/// @brief Measure height pass of MRandomMap::MakeMap with 1 to 8 threads, against sequential pass.
+/// @return If heights of any thread count are different from sequential pass, return false.
+bool RunGrid(size_t grid, size_t fragment)
+{
+  const auto kernel = CreateKernel(grid, fragment);
+  const size_t rowSize = kernel.GetRowSize();
+  const size_t colSize = kernel.GetColumnSize();
+  // Small grids are repeated, so each run takes similar time.
+  const size_t iterationCount = (std::max)(size_t(3), size_t(16'000'000) / (rowSize * colSize));
+
+  std::vector<float> sequentialHeights(rowSize * colSize);
+  const auto sequential = MeasureBench(iterationCount, kRunCount, [&](size_t)
+  {
+    kernel.CalculateRows(0, rowSize, sequentialHeights.data());
+  });
+  std::printf("| %zu x %zu, fragment %zu | sequential | - | %.2f | 1.00x |\n", 
+    grid, grid, fragment, sequential.mMedianNs / 1e6);
+
+  bool isIdentical = true;
+  for (const size_t threadCount : {1, 2, 4, 8})
+  {
+    // Calling thread runs blocks too, as GetWorkerPool() of MRandomMap.
+    FWorkerPool pool{threadCount - 1};
+    const size_t blockSize = (std::max)(size_t(1), rowSize / (threadCount * 4));
+
+    std::vector<float> heights(rowSize * colSize);
+    const auto result = MeasureBench(iterationCount, kRunCount, [&](size_t)
+    {
+      pool.ParallelFor(rowSize, blockSize, [&](size_t begin, size_t end)
+      {
+        kernel.CalculateRows(begin, end, heights.data() + begin * colSize);
+      });
+    });
+    isIdentical = isIdentical && std::memcmp(heights.data(), sequentialHeights.data(), heights.size() * sizeof(float)) == 0;
+
+    std::printf("| %zu x %zu, fragment %zu | %zu | %zu | %.2f | %.2fx |\n", 
+      grid, grid, fragment, threadCount, blockSize, result.mMedianNs / 1e6, sequential.mMedianNs / result.mMedianNs);
+  }
+  return isIdentical;
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  std::printf("Height pass of MRandomMap::MakeMap on FWorkerPool, %u hardware threads\n", std::thread::hardware_concurrency());
+  std::printf("\n| grid | threads | rows/block | ms/map | speedup |\n");
+  std::printf("|---|---|---:|---:|---:|\n");
+  bool isIdentical = true;
+  for (const auto& [grid, fragment] : {std::pair{20, 10}, std::pair{20, 64}, std::pair{64, 32}})
+  {
+    isIdentical = RunGrid(grid, fragment) && isIdentical;
+  }
+
+  // Fixed cost of ParallelFor itself, which bounds the smallest useful block.
+  PrintBenchHeader("ParallelFor of 64 empty blocks", "threads");
+  for (const size_t threadCount : {1, 2, 4, 8})
+  {
+    FWorkerPool pool{threadCount - 1};
+    char name[16];
+    std::snprintf(name, sizeof(name), "%zu", threadCount);
+    PrintBenchRow(name, MeasureBench(1000, kRunCount, [&](size_t)
+    {
+      pool.ParallelFor(64, 1, [](size_t begin, size_t) { DoNotOptimize(begin); });
+    }));
+  }
+  return isIdentical == true ? 0 : 1;
+}
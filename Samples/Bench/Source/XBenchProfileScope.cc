@@ -0,0 +1,133 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Profiling/FProfileThreadBuffer.h>
+#include <Profiling/FTimeContainer.h>
+#include <Profiling/XCpuClock.h>
+#include <XBenchUtility.h>
+
+namespace
+{
+
+constexpr size_t kScopeCount = 1'000'000;
+constexpr size_t kRunCount = 5;
+/// @brief The number of scopes of one frame. Buffer is collected at the end of frame.
+constexpr size_t kFrameScopeCount = 256;
+static_assert(kFrameScopeCount < FProfileThreadBuffer::kCapacity);
+
+/// @class FTagRegistry
+/// @brief Tag registry of MTimeChecker::RegisterTag(), which string path runs every call.
+class FTagRegistry final
+{
+public:
+  uint32_t RegisterTag(const std::string& tagName)
+  {
+    std::lock_guard<std::mutex> lock{this->mMutex};
+    if (const auto it = this->mTagIds.find(tagName); it != this->mTagIds.end()) { return it->second; }
+
+    const auto tagId = uint32_t(this->mContainers.size());
+    this->mContainers.emplace_back(std::make_unique<FTimeContainer>());
+    this->mTagIds.try_emplace(tagName, tagId);
+    return tagId;
+  }
+
+  FTimeContainer& GetContainer(uint32_t tagId) { return *this->mContainers[tagId]; }
+
+private:
+  std::mutex mMutex;
+  std::unordered_map<std::string, uint32_t> mTagIds;
+  std::vector<std::unique_ptr<FTimeContainer>> mContainers;
+};
+
+FTagRegistry sRegistry;
+
+/// @brief Thread buffer of MTimeChecker::GetThreadBuffer().
+FProfileThreadBuffer& GetThreadBuffer()
+{
+  thread_local std::shared_ptr<FProfileThreadBuffer> pBuffer = nullptr;
+  if (pBuffer == nullptr) { pBuffer = std::make_shared<FProfileThreadBuffer>(1, true); }
+  return *pBuffer;
+}
+
+/// @brief Run one CPU scope with the same sequence as MTimeChecker::BeginCpuScope and FCpuTimeHandle.
+void RunScope(uint32_t tagId)
+{
+  auto& buffer = GetThreadBuffer();
+  const auto depth = buffer.EnterScope();
+  const auto start = XCpuClock::Now();
+
+  const auto end = XCpuClock::Now();
+  DProfileEvent event;
+  event.mTagId = tagId;
+  event.mDepth = depth;
+  event.mStartTicks = start;
+  event.mDurationTicks = end - start;
+  GetThreadBuffer().ExitScope(event);
+}
+
+/// @brief Merge events of buffer into time containers, as MTimeChecker::CompleteFrame().
+void CollectEvents()
+{
+  auto& buffer = GetThreadBuffer();
+  DProfileEvent event;
+  while (buffer.TryPop(event) == true)
+  {
+    sRegistry.GetContainer(event.mTagId).Insert(XCpuClock::ToDuration(event.mDurationTicks));
+  }
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  // Clock is calibrated at the first use.
+  std::printf("CPU clock is %s, %.1f ns per read\n", 
+    XCpuClock::IsUsingTsc() == true ? "TSC" : "steady_clock", XCpuClock::GetCallOverhead().count() * 1e9);
+
+  // Other tags of sample are registered, so lookup is not of one entry.
+  for (size_t i = 0; i < 64; ++i) { sRegistry.RegisterTag("Tag" + std::to_string(i)); }
+
+  // Events are collected every kFrameScopeCount scopes, so collection cost is included in each scope.
+  PrintBenchHeader("CPU profiling scope, collected every 256 scopes", "scope");
+  PrintBenchRow("two clock reads only", MeasureBench(kScopeCount, kRunCount, [](size_t)
+  {
+    const auto start = XCpuClock::Now();
+    DoNotOptimize(XCpuClock::Now() - start);
+  }));
+  PrintBenchRow("interned tag", MeasureBench(kScopeCount, kRunCount, [](size_t i)
+  {
+    // Tag is static object of call site, so registered only once.
+    static const uint32_t tagId = sRegistry.RegisterTag("FObjTerrain::SwapMeshIfReady");
+    RunScope(tagId);
+    if ((i % kFrameScopeCount) == 0) { CollectEvents(); }
+  }));
+  PrintBenchRow("string tag, short name", MeasureBench(kScopeCount, kRunCount, [](size_t i)
+  {
+    RunScope(sRegistry.RegisterTag("Render"));
+    if ((i % kFrameScopeCount) == 0) { CollectEvents(); }
+  }));
+  PrintBenchRow("string tag, long name", MeasureBench(kScopeCount, kRunCount, [](size_t i)
+  {
+    RunScope(sRegistry.RegisterTag("FObjTerrain::SwapMeshIfReady"));
+    if ((i % kFrameScopeCount) == 0) { CollectEvents(); }
+  }));
+
+  return 0;
+}
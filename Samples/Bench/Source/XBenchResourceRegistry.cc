@@ -0,0 +1,125 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+#include <d3d11.h>
+
+#include <ComWrapper/IComOwner.h>
+#include <Mock/FMockCommandLog.h>
+#include <Mock/FMockD3D11Factory.h>
+#include <Resource/TShardedSlotMap.h>
+#include <XBenchUtility.h>
+
+namespace
+{
+
+constexpr size_t kLiveCount = 10'000;
+constexpr size_t kVisitCount = 200'000;
+
+ID3D11Buffer* CreateBuffer(ID3D11Device& device)
+{
+  D3D11_BUFFER_DESC desc = {};
+  desc.ByteWidth = 64;
+  desc.Usage = D3D11_USAGE_DEFAULT;
+  desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+
+  ID3D11Buffer* pBuffer = nullptr;
+  device.CreateBuffer(&desc, nullptr, &pBuffer);
+  return pBuffer;
+}
+
+/// @brief Visit live buffers from reader threads as Get* of render and loader threads, 
+/// while one writer thread creates and removes buffers if `withWriter` is true.
+/// @return Wall time per visit of all readers as nanoseconds.
+template <uint32_t TShardCount>
+double RunVisits(ID3D11Device& device, size_t readerCount, bool withWriter)
+{
+  TShardedSlotMap<IComOwner<ID3D11Buffer>, TShardCount> registry;
+  std::vector<DSlotKey> keys;
+  keys.reserve(kLiveCount);
+  for (size_t i = 0; i < kLiveCount; ++i) { keys.push_back(registry.Emplace(CreateBuffer(device))); }
+
+  std::atomic<bool> isDone = false;
+  std::thread writer;
+  if (withWriter == true)
+  {
+    writer = std::thread([&]
+    {
+      while (isDone.load() == false)
+      {
+        const auto key = registry.Emplace(CreateBuffer(device));
+        registry.Remove(key);
+      }
+    });
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> readers;
+  for (size_t t = 0; t < readerCount; ++t)
+  {
+    readers.emplace_back([&, t]
+    {
+      std::mt19937 random{uint32_t(t + 1)};
+      std::uniform_int_distribution<size_t> dist{0, keys.size() - 1};
+      const size_t visitCount = kVisitCount / readerCount;
+      for (size_t i = 0; i < visitCount; ++i)
+      {
+        auto* pBuffer = registry.Visit(keys[dist(random)], [](auto& owner) { return owner.GetPtr(); });
+        DoNotOptimize(pBuffer);
+      }
+    });
+  }
+  for (auto& reader : readers) { reader.join(); }
+  const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  isDone.store(true);
+  if (writer.joinable() == true) { writer.join(); }
+  for (const auto& key : keys) { registry.Remove(key); }
+  return elapsed / double(kVisitCount);
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  FMockCommandLog deviceLog;
+  FMockCommandLog contextLog;
+  deviceLog.SetRecording(false);
+  ID3D11Device* pDevice = nullptr;
+  ID3D11DeviceContext* pDc = nullptr;
+  if (FAILED(FMockD3D11Factory::CreateDevice(deviceLog, contextLog, &pDevice, &pDc))) { return 1; }
+
+  std::printf("Registry visits of %zu live mock buffers (%zu visits in total, %u hardware threads)\n", 
+    kLiveCount, kVisitCount, std::thread::hardware_concurrency());
+  std::printf("\n| readers | writer | 8 shards ns/visit | 1 shard ns/visit |\n");
+  std::printf("|---:|---|---:|---:|\n");
+  for (const bool withWriter : {false, true})
+  {
+    for (const size_t readerCount : {1, 2, 4, 8})
+    {
+      std::printf("| %zu | %s | %.1f | %.1f |\n", 
+        readerCount, withWriter == true ? "yes" : "no", 
+        RunVisits<8>(*pDevice, readerCount, withWriter), 
+        RunVisits<1>(*pDevice, readerCount, withWriter));
+    }
+  }
+
+  pDc->Release();
+  pDevice->Release();
+  return 0;
+}
@@ -0,0 +1,142 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <Resource/TSlotMap.h>
+#include <XBenchUtility.h>
+
+namespace
+{
+
+constexpr size_t kOperationCount = 1'000'000;
+constexpr size_t kRunCount = 5;
+
+/// @struct DRandomKey
+/// @brief 128-bit random key, in place of `dy::math::DUuid` which MD3D11Resources used as key before.
+struct DRandomKey final
+{
+  uint64_t mHigh = 0;
+  uint64_t mLow = 0;
+};
+
+bool operator==(const DRandomKey& lhs, const DRandomKey& rhs) noexcept
+{
+  return lhs.mHigh == rhs.mHigh && lhs.mLow == rhs.mLow;
+}
+
+/// @struct DRandomKeyHash
+/// @brief Hash combining both halves, as hash of 16 bytes uuid does.
+struct DRandomKeyHash final
+{
+  size_t operator()(const DRandomKey& key) const noexcept
+  {
+    const size_t high = std::hash<uint64_t>{}(key.mHigh);
+    return high ^ (std::hash<uint64_t>{}(key.mLow) + 0x9e3779b97f4a7c15ull + (high << 6) + (high >> 2));
+  }
+};
+
+/// @brief Value type of bench. Each owner of MD3D11Resources is one COM pointer.
+using TValue = void*;
+using THashMap = std::unordered_map<DRandomKey, TValue, DRandomKeyHash>;
+
+/// @brief Measure lookup, remove and insert churn, and iteration of `liveCount` values.
+void RunContainers(size_t liveCount)
+{
+  std::mt19937_64 random{liveCount};
+  std::vector<size_t> order(kOperationCount);
+  {
+    std::uniform_int_distribution<size_t> dist{0, liveCount - 1};
+    for (auto& index : order) { index = dist(random); }
+  }
+
+  // Keys are stored in handles of each sample, and looked up in random order.
+  THashMap hashMap;
+  std::vector<DRandomKey> hashKeys(liveCount);
+  for (size_t i = 0; i < liveCount; ++i)
+  {
+    hashKeys[i] = DRandomKey{random(), random()};
+    hashMap.emplace(hashKeys[i], reinterpret_cast<TValue>(i));
+  }
+
+  TSlotMap<TValue> slotMap;
+  std::vector<DSlotKey> slotKeys(liveCount);
+  for (size_t i = 0; i < liveCount; ++i) { slotKeys[i] = slotMap.Emplace(reinterpret_cast<TValue>(i)); }
+
+  char name[64];
+  std::snprintf(name, sizeof(name), "%zu live values", liveCount);
+  PrintBenchHeader(name, "operation");
+
+  PrintBenchRow("get, unordered_map", MeasureBench(kOperationCount, kRunCount, [&](size_t i)
+  {
+    DoNotOptimize(hashMap.find(hashKeys[order[i]])->second);
+  }));
+  PrintBenchRow("get, TSlotMap", MeasureBench(kOperationCount, kRunCount, [&](size_t i)
+  {
+    DoNotOptimize(slotMap.Get(slotKeys[order[i]]));
+  }));
+
+  // Remove and create again, as resources of terrain tile are regenerated.
+  PrintBenchRow("remove + insert, unordered_map", MeasureBench(kOperationCount, kRunCount, [&](size_t i)
+  {
+    auto& key = hashKeys[order[i]];
+    auto value = hashMap.find(key)->second;
+    hashMap.erase(key);
+    key.mLow += 1;
+    hashMap.emplace(key, value);
+  }));
+  PrintBenchRow("remove + insert, TSlotMap", MeasureBench(kOperationCount, kRunCount, [&](size_t i)
+  {
+    auto& key = slotKeys[order[i]];
+    auto value = slotMap.Get(key);
+    slotMap.Remove(key);
+    key = slotMap.Emplace(value);
+  }));
+
+  // Per-frame walk of all resources. Time is per value.
+  const size_t iterationCount = (std::max)(size_t(1), kOperationCount / liveCount);
+  const auto hashIteration = MeasureBench(iterationCount, kRunCount, [&](size_t)
+  {
+    for (const auto& [key, value] : hashMap) { DoNotOptimize(value); }
+  });
+  const auto slotIteration = MeasureBench(iterationCount, kRunCount, [&](size_t)
+  {
+    for (const auto& value : slotMap) { DoNotOptimize(value); }
+  });
+  const auto PerValue = [liveCount](DBenchResult result)
+  {
+    result.mMedianNs /= double(liveCount);
+    result.mMinNs /= double(liveCount);
+    result.mMaxNs /= double(liveCount);
+    return result;
+  };
+  PrintBenchRow("iterate per value, unordered_map", PerValue(hashIteration));
+  PrintBenchRow("iterate per value, TSlotMap", PerValue(slotIteration));
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  std::printf("Resource container of MD3D11Resources, %zu operations per run, %zu runs.\n", kOperationCount, kRunCount);
+  for (const size_t liveCount : {10'000, 100'000, 1'000'000})
+  {
+    RunContainers(liveCount);
+  }
+  return 0;
+}
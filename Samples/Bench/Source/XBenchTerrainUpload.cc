@@ -0,0 +1,176 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+#include <d3d11.h>
+
+#include <Mock/FMockCommandLog.h>
+#include <Mock/FMockD3D11Factory.h>
+#include <XBenchUtility.h>
+
+namespace
+{
+
+constexpr size_t kRegenerationCount = 50;
+constexpr size_t kRunCount = 5;
+
+/// @struct DVertex
+/// @brief Vertex of terrain before topology was shared. (DVector3<TReal>)
+struct DVertex final
+{
+  float mX = 0.0f;
+  float mY = 0.0f;
+  float mHeight = 0.0f;
+};
+
+/// @struct DPosition
+/// @brief Grid position of shared topology. (DVector2<TReal>)
+struct DPosition final
+{
+  float mX = 0.0f;
+  float mY = 0.0f;
+};
+
+ID3D11Buffer* CreateBuffer(ID3D11Device& device, D3D11_USAGE usage, UINT bindFlags, const void* data, size_t byteSize)
+{
+  D3D11_BUFFER_DESC desc = {};
+  desc.Usage = usage;
+  desc.ByteWidth = UINT(byteSize);
+  desc.BindFlags = bindFlags;
+
+  D3D11_SUBRESOURCE_DATA initialData = {};
+  initialData.pSysMem = data;
+  ID3D11Buffer* pBuffer = nullptr;
+  device.CreateBuffer(&desc, &initialData, &pBuffer);
+  return pBuffer;
+}
+
+/// @brief Build indices of grid as MRandomMap::GetTopology.
+std::vector<unsigned> BuildIndices(size_t columnSize, size_t rowSize)
+{
+  const auto quadColSize = columnSize - 1;
+  const auto quadRowSize = rowSize - 1;
+  std::vector<unsigned> indices(quadColSize * quadRowSize * 6);
+  unsigned* pIndex = indices.data();
+  for (size_t y = 0; y < quadRowSize; ++y)
+  {
+    for (size_t x = 0; x < quadColSize; ++x, pIndex += 6)
+    {
+      const unsigned i = unsigned(x + y * columnSize);
+      pIndex[0] = i;
+      pIndex[1] = i + unsigned(columnSize);
+      pIndex[2] = i + 1;
+      pIndex[3] = i + 1;
+      pIndex[4] = i + unsigned(columnSize);
+      pIndex[5] = i + unsigned(columnSize) + 1;
+    }
+  }
+  return indices;
+}
+
+/// @brief Regenerate terrain of same size `kRegenerationCount` times with and without shared topology.
+void RunSize(ID3D11Device& device, ID3D11DeviceContext& dc, FMockCommandLog& deviceLog, FMockCommandLog& contextLog, 
+  size_t grid, size_t fragment)
+{
+  const size_t size = grid * fragment;
+  const size_t vertexCount = size * size;
+  // Heights of new map. Generation of heights is same for both, so it is not measured.
+  std::vector<float> heights(vertexCount, 1.0f);
+
+  // Before : each regeneration builds vertices and indices, and creates both buffers again.
+  ID3D11Buffer* pVertexBuffer = nullptr;
+  ID3D11Buffer* pIndexBuffer = nullptr;
+  deviceLog.Clear();
+  const auto unshared = MeasureBench(kRegenerationCount, kRunCount, [&](size_t)
+  {
+    std::vector<DVertex> vertices(vertexCount);
+    for (size_t y = 0; y < size; ++y)
+    {
+      for (size_t x = 0; x < size; ++x)
+      {
+        vertices[y * size + x] = DVertex{float(x), float(y), heights[y * size + x]};
+      }
+    }
+    const auto indices = BuildIndices(size, size);
+
+    if (pVertexBuffer != nullptr) { pVertexBuffer->Release(); }
+    if (pIndexBuffer != nullptr) { pIndexBuffer->Release(); }
+    pVertexBuffer = CreateBuffer(device, D3D11_USAGE_DEFAULT, D3D11_BIND_VERTEX_BUFFER, 
+      vertices.data(), sizeof(DVertex) * vertices.size());
+    pIndexBuffer = CreateBuffer(device, D3D11_USAGE_DEFAULT, D3D11_BIND_INDEX_BUFFER, 
+      indices.data(), sizeof(unsigned) * indices.size());
+  });
+  const auto unsharedBytes = deviceLog.GetUploadedBytes() / ((kRunCount + 1) * kRegenerationCount);
+  pVertexBuffer->Release();
+  pIndexBuffer->Release();
+
+  // After : topology buffers are immutable and created once, and only heights are updated as FObjTerrain::SwapMeshIfReady.
+  deviceLog.Clear();
+  std::vector<DPosition> positions(vertexCount);
+  for (size_t y = 0; y < size; ++y)
+  {
+    for (size_t x = 0; x < size; ++x) { positions[y * size + x] = DPosition{float(x), float(y)}; }
+  }
+  const auto indices = BuildIndices(size, size);
+  auto* pPositionBuffer = CreateBuffer(device, D3D11_USAGE_IMMUTABLE, D3D11_BIND_VERTEX_BUFFER, 
+    positions.data(), sizeof(DPosition) * positions.size());
+  pIndexBuffer = CreateBuffer(device, D3D11_USAGE_IMMUTABLE, D3D11_BIND_INDEX_BUFFER, 
+    indices.data(), sizeof(unsigned) * indices.size());
+  auto* pHeightBuffer = CreateBuffer(device, D3D11_USAGE_DEFAULT, D3D11_BIND_VERTEX_BUFFER, 
+    heights.data(), sizeof(float) * heights.size());
+  const auto firstBytes = deviceLog.GetUploadedBytes();
+
+  contextLog.Clear();
+  const auto shared = MeasureBench(kRegenerationCount, kRunCount, [&](size_t)
+  {
+    dc.UpdateSubresource(pHeightBuffer, 0, nullptr, heights.data(), 0, 0);
+  });
+  const auto sharedBytes = contextLog.GetUploadedBytes() / ((kRunCount + 1) * kRegenerationCount);
+  pPositionBuffer->Release();
+  pIndexBuffer->Release();
+  pHeightBuffer->Release();
+
+  std::printf("| %zu x %zu, fragment %zu | %zu | %llu | %.2f | %llu | %llu | %.2f |\n", 
+    grid, grid, fragment, vertexCount,
+    static_cast<unsigned long long>(unsharedBytes), unshared.mMedianNs / 1e3, 
+    static_cast<unsigned long long>(firstBytes), 
+    static_cast<unsigned long long>(sharedBytes), shared.mMedianNs / 1e3);
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  FMockCommandLog deviceLog;
+  FMockCommandLog contextLog;
+  deviceLog.SetRecording(false);
+  contextLog.SetRecording(false);
+  ID3D11Device* pDevice = nullptr;
+  ID3D11DeviceContext* pDc = nullptr;
+  if (FAILED(FMockD3D11Factory::CreateDevice(deviceLog, contextLog, &pDevice, &pDc))) { return 1; }
+
+  std::printf("Terrain regeneration of same size, with and without shared topology\n");
+  std::printf("\n| grid | vertices | unshared bytes/regen | unshared us/regen "
+    "| shared first bytes | shared bytes/regen | shared us/regen |\n");
+  std::printf("|---|---:|---:|---:|---:|---:|---:|\n");
+  for (const auto& [grid, fragment] : {std::pair{8, 2}, std::pair{20, 10}, std::pair{20, 20}})
+  {
+    RunSize(*pDevice, *pDc, deviceLog, contextLog, grid, fragment);
+  }
+
+  pDc->Release();
+  pDevice->Release();
+  return 0;
+}
@@ -0,0 +1,128 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <Profiling/FTimeContainer.h>
+#include <XBenchUtility.h>
+
+namespace
+{
+
+constexpr size_t kSampleCount = 200'000;
+constexpr size_t kRunCount = 5;
+
+/// @brief Get exact percentile of values with the same rank as FTimeHistogram.
+double GetExactPercentile(std::vector<double> values, double ratio)
+{
+  const auto rank = (std::max)(size_t(1), size_t(std::ceil(ratio * double(values.size()))));
+  std::nth_element(values.begin(), values.begin() + (rank - 1), values.end());
+  return values[rank - 1];
+}
+
+/// @brief Generate frame times as seconds.
+template <typename TGenerator>
+std::vector<double> MakeSamples(TGenerator&& generator)
+{
+  std::vector<double> samples(kSampleCount);
+  for (auto& sample : samples) { sample = generator(); }
+  return samples;
+}
+
+/// @brief Insert samples into container of given window, and check relative error of percentiles 
+/// against exact percentiles of window, at every `kCheckStride` insertions.
+void RunAccuracy(const char* name, const std::vector<double>& samples, size_t windowLength)
+{
+  constexpr size_t kCheckStride = 997;
+  constexpr double kRatios[] = {0.5, 0.9, 0.99, 0.999};
+
+  FTimeContainer container{windowLength};
+  double maxErrors[std::size(kRatios)] = {};
+  for (size_t i = 0; i < samples.size(); ++i)
+  {
+    container.Insert(TTimeStamp(samples[i]));
+    if (i + 1 < windowLength || (i % kCheckStride) != 0) { continue; }
+
+    const std::vector<double> window(samples.begin() + (i + 1 - windowLength), samples.begin() + (i + 1));
+    for (size_t r = 0; r < std::size(kRatios); ++r)
+    {
+      const double exact = GetExactPercentile(window, kRatios[r]);
+      const double approximated = container.GetPercentile(kRatios[r]).count();
+      maxErrors[r] = (std::max)(maxErrors[r], std::abs(approximated - exact) / exact);
+    }
+  }
+
+  std::printf("| %s | %zu | %.2f%% | %.2f%% | %.2f%% | %.2f%% |\n", 
+    name, windowLength, maxErrors[0] * 100.0, maxErrors[1] * 100.0, maxErrors[2] * 100.0, maxErrors[3] * 100.0);
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  std::mt19937_64 random{11};
+
+  // 60 Hz frame times with jitter.
+  std::lognormal_distribution<double> frameDist{std::log(0.0166), 0.1};
+  const auto frames = MakeSamples([&] { return frameDist(random); });
+  // Mostly 1 ms with 5% of 30 ms hitches.
+  std::bernoulli_distribution hitchDist{0.05};
+  std::normal_distribution<double> shortDist{0.001, 0.0001};
+  std::normal_distribution<double> longDist{0.030, 0.003};
+  const auto hitches = MakeSamples([&] { return std::abs(hitchDist(random) == true ? longDist(random) : shortDist(random)); });
+  // From 10 us to 100 ms evenly in log scale.
+  std::uniform_real_distribution<double> exponentDist{std::log(1e-5), std::log(1e-1)};
+  const auto wide = MakeSamples([&] { return std::exp(exponentDist(random)); });
+
+  std::printf("Maximum relative error of FTimeContainer percentiles against exact percentiles of window\n");
+  std::printf("\n| samples | window | p50 | p90 | p99 | p99.9 |\n");
+  std::printf("|---|---:|---:|---:|---:|---:|\n");
+  for (const size_t windowLength : {FTimeContainer::kDefaultWindowLength, size_t(1000), size_t(10000)})
+  {
+    RunAccuracy("60 Hz frames", frames, windowLength);
+    RunAccuracy("1 ms with 30 ms hitches", hitches, windowLength);
+    RunAccuracy("10 us to 100 ms", wide, windowLength);
+  }
+
+  // Cost of each sample, and of reading percentile every frame as profiler window does.
+  PrintBenchHeader("FTimeContainer cost, 60 Hz frames", "operation");
+  for (const size_t windowLength : {FTimeContainer::kDefaultWindowLength, size_t(1000), size_t(10000)})
+  {
+    FTimeContainer container{windowLength};
+    char name[64];
+    std::snprintf(name, sizeof(name), "Insert, window %zu", windowLength);
+    PrintBenchRow(name, MeasureBench(kSampleCount, kRunCount, [&](size_t i) 
+    { 
+      container.Insert(TTimeStamp(frames[i])); 
+    }));
+
+    std::snprintf(name, sizeof(name), "GetPercentile(0.99), window %zu", windowLength);
+    PrintBenchRow(name, MeasureBench(kSampleCount / 10, kRunCount, [&](size_t) 
+    { 
+      DoNotOptimize(container.GetPercentile(0.99)); 
+    }));
+
+    // Percentile by sorting copy of window, without histogram.
+    std::snprintf(name, sizeof(name), "nth_element p99, window %zu", windowLength);
+    const std::vector<double> window(frames.begin(), frames.begin() + windowLength);
+    PrintBenchRow(name, MeasureBench(kSampleCount / 100, kRunCount, [&](size_t) 
+    { 
+      DoNotOptimize(GetExactPercentile(window, 0.99)); 
+    }));
+  }
+  return 0;
+}
@@ -0,0 +1,28 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdio>
+#include <cstdlib>
+
+/// @def TEST_EXPECT
+/// @brief Check expression. If expression is false, print location and exit test with failure.
+/// Unlike assert, this is also checked in release build.
+#define TEST_EXPECT(__MAExpression__) \
+  { \
+    if ((__MAExpression__) == false) \
+    { \
+      std::fprintf(stderr, "%s(%d): Expectation failed: %s\n", __FILE__, __LINE__, #__MAExpression__); \
+      std::exit(EXIT_FAILURE); \
+    } \
+  }
@@ -0,0 +1,123 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Profiling/MTimeChecker.h>
+#include <XTestUtility.h>
+
+namespace
+{
+
+constexpr size_t kWorkerCount = 4;
+constexpr size_t kFrameCount = 200;
+/// Less than window length of container, so every collected event remains in container.
+constexpr size_t kScopeCount = 40;
+static_assert(kScopeCount < FTimeContainer::kDefaultWindowLength);
+
+std::string GetWorkerTag(size_t workerIndex)
+{
+  return "Worker" + std::to_string(workerIndex);
+}
+
+std::string GetWorkerInnerTag(size_t workerIndex)
+{
+  return "Worker" + std::to_string(workerIndex) + "Inner";
+}
+
+/// @brief Check nested CPU scopes of own tags. Outermost scope of worker must not complete frame.
+void RunWorker(size_t workerIndex, const std::atomic<bool>& isStarted)
+{
+  while (isStarted.load(std::memory_order_acquire) == false) { std::this_thread::yield(); }
+
+  const auto tag = GetWorkerTag(workerIndex);
+  const auto innerTag = GetWorkerInnerTag(workerIndex);
+  for (size_t i = 0; i < kScopeCount; ++i)
+  {
+    auto handle = MTimeChecker::CheckCpuTime(tag);
+    {
+      auto innerHandle = MTimeChecker::CheckCpuTime(innerTag);
+      std::this_thread::yield();
+    }
+  }
+}
+
+/// @brief Run one frame on frame thread, and check scope tree has only scopes of frame thread.
+void RunFrame()
+{
+  {
+    TIME_CHECK_CPU("Frame");
+    {
+      TIME_CHECK_CPU("Update");
+    }
+  }
+
+  const auto& tree = MTimeChecker::GetCpuScopeTree();
+  TEST_EXPECT(tree.GetRoots().size() == 1);
+  const auto& frameNode = tree[tree.GetRoots().front()];
+  TEST_EXPECT(frameNode.mName == "Frame");
+  TEST_EXPECT(frameNode.mCallCount == 1);
+  TEST_EXPECT(frameNode.mChildren.size() == 1);
+  const auto& updateNode = tree[frameNode.mChildren.front()];
+  TEST_EXPECT(updateNode.mName == "Update");
+  TEST_EXPECT(updateNode.mCallCount == 1);
+  TEST_EXPECT(updateNode.mChildren.empty() == true);
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  // Main thread is bound as frame thread by Initialize().
+  MTimeChecker::Initialize();
+
+  // Worker checks CPU time before main thread does, but it must not complete frame.
+  {
+    const std::atomic<bool> isStarted = true;
+    std::thread{RunWorker, 0, std::cref(isStarted)}.join();
+  }
+  TEST_EXPECT(MTimeChecker::Get(GetWorkerTag(0)).Length() == 0);
+  TEST_EXPECT(MTimeChecker::Get(GetWorkerInnerTag(0)).Length() == 0);
+
+  // Workers check CPU time while main thread runs frames. 
+  // Events of workers are collected into containers at frame boundary of main thread.
+  std::atomic<bool> isStarted = false;
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < kWorkerCount; ++i)
+  {
+    workers.emplace_back(RunWorker, i, std::cref(isStarted));
+  }
+
+  isStarted.store(true, std::memory_order_release);
+  for (size_t frame = 0; frame < kFrameCount; ++frame) { RunFrame(); }
+  for (auto& worker : workers) { worker.join(); }
+
+  // Remaining events of terminated workers are collected by the next frame.
+  RunFrame();
+
+  TEST_EXPECT(MTimeChecker::Get("Frame").Length() == FTimeContainer::kDefaultWindowLength);
+  TEST_EXPECT(MTimeChecker::Get("Update").Length() == FTimeContainer::kDefaultWindowLength);
+  for (size_t i = 0; i < kWorkerCount; ++i)
+  {
+    TEST_EXPECT(MTimeChecker::Get(GetWorkerTag(i)).Length() == kScopeCount);
+    TEST_EXPECT(MTimeChecker::Get(GetWorkerInnerTag(i)).Length() == kScopeCount);
+  }
+  TEST_EXPECT(MTimeChecker::GetDroppedEventCount() == 0);
+
+  std::printf("%zu workers, %zu frames : all CPU scopes collected by frame thread.\n", kWorkerCount, kFrameCount);
+  return 0;
+}
@@ -0,0 +1,138 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include <FFrameLoop.h>
+#include <FHeadlessPlatform.h>
+#include <XTestUtility.h>
+
+namespace
+{
+
+constexpr double kFixedStep = 1.0 / 60.0;
+
+/// @brief Frames capped by frame rate must not be shorter than target frame time.
+void RunPacedFrames(dy::FHeadlessPlatform& platform)
+{
+  constexpr double kFrameRate = 100.0;
+  constexpr uint64_t kFrameCount = 30;
+
+  // Platform interface is called through base, as samples do.
+  dy::APlatformBase& base = platform;
+  dy::PWindowCreationDescriptor desc;
+  desc.mWindowWidth = 320;
+  desc.mWindowHeight = 240;
+  const auto window = base.CreateWindow(desc);
+  TEST_EXPECT(window.has_value() == true);
+  platform.SetMaxFrameCount(kFrameCount);
+
+  dy::PFrameLoopDescriptor loopDesc;
+  loopDesc.mFixedStep = kFixedStep;
+  loopDesc.mMaxFrameRate = kFrameRate;
+  dy::FFrameLoop loop{loopDesc};
+
+  uint64_t stepCount = 0;
+  const auto start = dy::FFrameLoop::TClock::now();
+  loop.Run(platform, [&stepCount](dy::FFrameLoop& frameLoop) 
+  {
+    while (frameLoop.StepFixed() == true) { stepCount += 1; }
+  });
+  const double elapsed = std::chrono::duration<double>(dy::FFrameLoop::TClock::now() - start).count();
+
+  TEST_EXPECT(platform.GetFrameCount() == kFrameCount);
+  const auto statistics = loop.GetStatistics();
+  TEST_EXPECT(statistics.mFrameCount == kFrameCount);
+  // First frame is not measured, and the others must wait until target frame time.
+  TEST_EXPECT(elapsed >= (kFrameCount - 1) / kFrameRate);
+  TEST_EXPECT(statistics.mMinFrameTime >= 1.0 / kFrameRate - 0.0005);
+  TEST_EXPECT(stepCount > 0);
+
+  std::printf("Paced %llu frames at %.0f Hz: average %.3f ms, jitter %.3f ms, max %.3f ms, %llu missed.\n",
+    static_cast<unsigned long long>(statistics.mFrameCount), kFrameRate, 
+    statistics.mAverageFrameTime * 1000.0, statistics.mJitter * 1000.0, statistics.mMaxFrameTime * 1000.0,
+    static_cast<unsigned long long>(statistics.mMissedFrameCount));
+
+  base.RemoveWindow(*window);
+}
+
+/// @brief Long frame simulates only mMaxStepsPerFrame steps, and drops other whole steps.
+void RunStepDropping()
+{
+  dy::PFrameLoopDescriptor loopDesc;
+  loopDesc.mFixedStep = kFixedStep;
+  loopDesc.mMaxStepsPerFrame = 8;
+  dy::FFrameLoop loop{loopDesc};
+
+  // 60 steps and half.
+  loop.BeginFrame(1.0 + kFixedStep * 0.5);
+  uint32_t stepCount = 0;
+  while (loop.StepFixed() == true) { stepCount += 1; }
+  loop.EndFrame();
+
+  TEST_EXPECT(stepCount == loopDesc.mMaxStepsPerFrame);
+  const auto statistics = loop.GetStatistics();
+  const double expectedDropped = (60 - loopDesc.mMaxStepsPerFrame) * kFixedStep;
+  TEST_EXPECT(std::abs(statistics.mDroppedTime - expectedDropped) < 1e-9);
+  TEST_EXPECT(std::abs(loop.GetAlpha() - 0.5f) < 1e-4f);
+
+  // Remainder is kept, so next short frame steps once.
+  loop.BeginFrame(kFixedStep * 0.75);
+  stepCount = 0;
+  while (loop.StepFixed() == true) { stepCount += 1; }
+  TEST_EXPECT(stepCount == 1);
+  TEST_EXPECT(loop.GetStatistics().mDroppedTime == statistics.mDroppedTime);
+}
+
+/// @brief Interpolation factor stays in [0, 1] after steps are consumed, whatever delta time is.
+void RunAlphaRange()
+{
+  dy::PFrameLoopDescriptor loopDesc;
+  loopDesc.mFixedStep = kFixedStep;
+  dy::FFrameLoop loop{loopDesc};
+
+  std::mt19937 engine{7};
+  std::uniform_real_distribution<double> distribution{0.0, kFixedStep * 12.0};
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    loop.BeginFrame(distribution(engine));
+    while (loop.StepFixed() == true) {}
+
+    const float alpha = loop.GetAlpha();
+    TEST_EXPECT(alpha >= 0.0f && alpha <= 1.0f);
+  }
+
+  // Negative delta time is treated as 0.
+  loop.BeginFrame(-1.0);
+  TEST_EXPECT(loop.GetDeltaTime() == 0.0f);
+  TEST_EXPECT(loop.GetAlpha() >= 0.0f);
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  dy::FHeadlessPlatform platform;
+  dy::APlatformBase& base = platform;
+  TEST_EXPECT(base.InitPlatform() == true);
+
+  RunPacedFrames(platform);
+  RunStepDropping();
+  RunAlphaRange();
+
+  TEST_EXPECT(base.ReleasePlatform() == true);
+  return 0;
+}
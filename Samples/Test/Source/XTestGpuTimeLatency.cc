@@ -0,0 +1,239 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <d3d11.h>
+
+#include <Graphics/MD3D11Resources.h>
+#include <Mock/FMockCommandLog.h>
+#include <Mock/FMockD3D11Factory.h>
+#include <Profiling/FD3D11TimeContainer.h>
+#include <Profiling/FD3D11TimeHandle.h>
+#include <Profiling/MTimeChecker.h>
+#include <XTestUtility.h>
+
+namespace
+{
+
+constexpr size_t kFrameCount = 64;
+constexpr size_t kSetCount = FD3D11TimeContainer::kMaxInFlightFrames;
+
+/// @struct DQuerySet
+/// @brief Disjoint query and timestamp pair of one in-flight frame, as FD3D11QueryPool has.
+struct DQuerySet final
+{
+  ID3D11Query* mDisjoint = nullptr;
+  ID3D11Query* mStart = nullptr;
+  ID3D11Query* mEnd = nullptr;
+};
+
+ID3D11Query* CreateQuery(ID3D11Device& device, D3D11_QUERY type)
+{
+  const D3D11_QUERY_DESC desc = {type, 0};
+  ID3D11Query* pQuery = nullptr;
+  TEST_EXPECT(SUCCEEDED(device.CreateQuery(&desc, &pQuery)));
+  return pQuery;
+}
+
+/// @brief Each frame has own fragment name, so resolved count of frame is length of its fragment.
+std::string GetFragmentName(size_t frame)
+{
+  return "Frame" + std::to_string(frame);
+}
+
+/// @class FResolveChecker
+/// @brief Checks that each frame is resolved only after its queries are completed, and only once.
+class FResolveChecker final
+{
+public:
+  FResolveChecker(const FD3D11TimeContainer& container, uint32_t latency)
+    : mContainer{container}, mLatency{latency}, mIsResolved(kFrameCount, false)
+  { }
+
+  /// @brief Check frames which are newly resolved at present frame.
+  void Check(size_t presentFrame)
+  {
+    for (size_t frame = 0; frame < kFrameCount; ++frame)
+    {
+      if (this->mIsResolved[frame] == true || this->mContainer.HasFragment(GetFragmentName(frame)) == false) 
+      { 
+        continue; 
+      }
+      TEST_EXPECT(presentFrame >= frame + this->mLatency);
+      this->mIsResolved[frame] = true;
+    }
+  }
+
+  /// @brief Get the number of resolved frames. Each resolved frame must have exactly one time stamp.
+  size_t GetResolvedCount() const
+  {
+    size_t resolvedCount = 0;
+    for (size_t frame = 0; frame < kFrameCount; ++frame)
+    {
+      const auto name = GetFragmentName(frame);
+      if (this->mContainer.HasFragment(name) == false) { continue; }
+      TEST_EXPECT(this->mContainer[name].Length() == 1);
+      resolvedCount += 1;
+    }
+    return resolvedCount;
+  }
+
+private:
+  const FD3D11TimeContainer& mContainer;
+  uint32_t mLatency = 0;
+  std::vector<bool> mIsResolved;
+};
+
+/// @brief Run frames with mock GPU which completes queries `latency` frames later, 
+/// and rotate `setCount` query sets by hand with deferred FD3D11TimeHandle.
+/// @return The number of resolved frames.
+size_t RunFrames(uint32_t latency, size_t setCount)
+{
+  FMockCommandLog deviceLog;
+  FMockCommandLog contextLog;
+  PMockD3D11Descriptor desc;
+  desc.mQueryLatency = latency;
+
+  ID3D11Device* pDevice = nullptr;
+  ID3D11DeviceContext* pDc = nullptr;
+  TEST_EXPECT(SUCCEEDED(FMockD3D11Factory::CreateDevice(deviceLog, contextLog, &pDevice, &pDc, desc)));
+
+  std::vector<DQuerySet> sets(setCount);
+  for (auto& set : sets)
+  {
+    set.mDisjoint = CreateQuery(*pDevice, D3D11_QUERY_TIMESTAMP_DISJOINT);
+    set.mStart = CreateQuery(*pDevice, D3D11_QUERY_TIMESTAMP);
+    set.mEnd = CreateQuery(*pDevice, D3D11_QUERY_TIMESTAMP);
+  }
+
+  FD3D11TimeContainer container{"Test"};
+  FResolveChecker checker{container, latency};
+  for (size_t frame = 0; frame < kFrameCount; ++frame)
+  {
+    auto& set = sets[frame % setCount];
+    {
+      FD3D11TimeHandle handle{container, *set.mDisjoint, *pDc, true};
+      checker.Check(frame);
+      {
+        const auto fragment = handle.CheckFragment(GetFragmentName(frame), *set.mStart, *set.mEnd);
+      }
+    }
+    checker.Check(frame);
+
+    // Present. GPU advances one frame.
+    pDc->Flush();
+  }
+
+  // Remaining pending frames are resolved when GPU catches up.
+  for (uint32_t i = 0; i <= latency; ++i)
+  {
+    container.TryResolve(*pDc);
+    checker.Check(kFrameCount + i);
+    pDc->Flush();
+  }
+
+  // Every frame is resolved exactly once, or dropped.
+  const size_t resolvedCount = checker.GetResolvedCount();
+  TEST_EXPECT(resolvedCount + container.GetDroppedFrameCount() == kFrameCount);
+
+  std::printf("Latency %u, %zu query sets : %zu resolved, %zu dropped.\n", 
+    latency, setCount, resolvedCount, container.GetDroppedFrameCount());
+
+  container.DiscardAllPending();
+  for (auto& set : sets)
+  {
+    set.mDisjoint->Release();
+    set.mStart->Release();
+    set.mEnd->Release();
+  }
+  pDc->Release();
+  pDevice->Release();
+  return resolvedCount;
+}
+
+/// @brief Run frames with queries of FD3D11QueryPool, through MTimeChecker as samples do.
+/// @return The number of resolved frames.
+size_t RunPooledFrames(uint32_t latency)
+{
+  FMockCommandLog deviceLog;
+  FMockCommandLog contextLog;
+  PMockD3D11Descriptor desc;
+  desc.mQueryLatency = latency;
+
+  const auto hDevice = MD3D11Resources::CreateD3D11MockDevice(deviceLog, contextLog, desc);
+  TEST_EXPECT(hDevice.has_value() == true);
+  auto* pDc = MD3D11Resources::GetDeviceContext(*hDevice).GetPtr();
+
+  // Containers of MTimeChecker are kept until program is terminated, so each run uses own tag.
+  const std::string tag = "Pooled" + std::to_string(latency);
+  for (size_t frame = 0; frame < kFrameCount; ++frame)
+  {
+    {
+      auto handle = MTimeChecker::CheckGpuD3D11Time(tag, *hDevice);
+      const auto fragment = handle.CheckFragment(GetFragmentName(frame));
+    }
+    pDc->Flush();
+  }
+
+  const auto& container = MTimeChecker::GetGpuD3D11(tag);
+  FResolveChecker checker{container, latency};
+  checker.Check(kFrameCount - 1);
+
+  // Pool does not resolve frames after the last frame, so frames of the last `latency` frames are pending.
+  const size_t resolvedCount = checker.GetResolvedCount();
+  const size_t pendingCount = (std::min)(size_t(latency), kSetCount);
+  TEST_EXPECT(resolvedCount + container.GetDroppedFrameCount() + pendingCount == kFrameCount);
+
+  std::printf("Latency %u, pooled : %zu resolved, %zu dropped, %zu pending.\n", 
+    latency, resolvedCount, container.GetDroppedFrameCount(), pendingCount);
+
+  // Pooled queries are removed from resources before device, as samples do at shutdown.
+  const size_t queryCount = MD3D11Resources::GetResourceCount(ED3D11Resc::Query);
+  TEST_EXPECT(queryCount > 0);
+  MTimeChecker::ReleaseD3D11Queries();
+  TEST_EXPECT(MD3D11Resources::GetResourceCount(ED3D11Resc::Query) == 0);
+  TEST_EXPECT(MD3D11Resources::RemoveDevice(*hDevice) == true);
+  return resolvedCount;
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  static_assert(kSetCount == 4, "Expected values below assume 4 in-flight frames.");
+
+  // Results arrive until their query set is reused at the beginning of frame, so no frame is dropped.
+  for (uint32_t latency = 0; latency <= kSetCount; ++latency)
+  {
+    TEST_EXPECT(RunFrames(latency, kSetCount) == kFrameCount);
+  }
+
+  // Query set is reused before its results arrive, so pending frame of the set is discarded 
+  // and never read from re-issued queries. Only the last frames are resolved after GPU catches up.
+  TEST_EXPECT(RunFrames(kSetCount + 1, kSetCount) == kSetCount);
+  TEST_EXPECT(RunFrames(kSetCount * 2, kSetCount) == kSetCount);
+
+  // With more sets than in-flight frames, the oldest pending frame is dropped by Enqueue instead.
+  TEST_EXPECT(RunFrames(kSetCount + 2, kSetCount * 2) == kSetCount);
+
+  // Pool has one query set for each in-flight frame, so the same latency limit applies.
+  for (uint32_t latency = 0; latency <= kSetCount; ++latency)
+  {
+    TEST_EXPECT(RunPooledFrames(latency) == kFrameCount - latency);
+  }
+  TEST_EXPECT(RunPooledFrames(kSetCount + 1) == 0);
+  return 0;
+}
@@ -0,0 +1,173 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <csignal>
+#include <cstdio>
+
+#include <FHeadlessPlatform.h>
+#include <FHeadlessHandles.h>
+#include <XTestUtility.h>
+
+namespace
+{
+
+using namespace dy::base;
+
+/// @brief Create virtual window, and check size and title through platform interface.
+dy::DWindowHandle RunWindow(dy::APlatformBase& platform)
+{
+  dy::PWindowCreationDescriptor invalidDesc;
+  invalidDesc.mWindowWidth = 0;
+  invalidDesc.mWindowHeight = 240;
+  TEST_EXPECT(platform.CreateWindow(invalidDesc).has_value() == false);
+  // Platform without window can be shutdown.
+  TEST_EXPECT(platform.CanShutdown() == true);
+
+  dy::PWindowCreationDescriptor desc;
+  desc.mWindowWidth = 320;
+  desc.mWindowHeight = 240;
+  desc.mWindowName = "Headless";
+  const auto window = platform.CreateWindow(desc);
+  TEST_EXPECT(window.has_value() == true);
+  TEST_EXPECT(platform.CanShutdown() == false);
+  TEST_EXPECT(platform.GetWindowWidth(*window) == 320);
+  TEST_EXPECT(platform.GetWindowHeight(*window) == 240);
+  TEST_EXPECT(platform.GetWindowTitle(*window) == "Headless");
+
+  platform.SetWindowTitle(*window, "Renamed");
+  TEST_EXPECT(platform.GetWindowTitle(*window) == "Renamed");
+  const auto* pWindow = static_cast<dy::DHeadlessWindow*>(platform._GetHandleOf(*window));
+  TEST_EXPECT(pWindow != nullptr && pWindow->mTitle == "Renamed");
+
+  // Resize is applied immediately, and zero size is ignored.
+  platform.ResizeWindow(*window, 1280, 720);
+  TEST_EXPECT(platform.GetWindowWidth(*window) == 1280);
+  TEST_EXPECT(platform.GetWindowHeight(*window) == 720);
+  platform.ResizeWindow(*window, 0, 480);
+  TEST_EXPECT(platform.GetWindowWidth(*window) == 1280);
+  TEST_EXPECT(platform.GetWindowHeight(*window) == 720);
+
+  // Unknown handle is ignored.
+  const dy::DWindowHandle unknown = {};
+  platform.ResizeWindow(unknown, 640, 480);
+  TEST_EXPECT(platform.GetWindowWidth(unknown) == 0);
+  TEST_EXPECT(platform._GetHandleOf(unknown) == nullptr);
+
+  return *window;
+}
+
+/// @brief Queued inputs are not applied until PollEvents, and are applied in order.
+void RunInput(dy::FHeadlessPlatform& platform)
+{
+  dy::APlatformBase& base = platform;
+  auto& input = base.GetInputManager();
+  input.SetMousePosFeatureState(ELowMousePosState::Normal);
+
+  platform.QueueKeyboard({Dy_Key_W, EInputState::Pressed});
+  platform.QueueMouseButton({DyMouseButton1, EInputState::Pressed});
+  platform.QueueMousePos({10, 20});
+  TEST_EXPECT(input.GetKeyboard(Dy_Key_W) == EInputState::Released);
+
+  const uint64_t frameCount = platform.GetFrameCount();
+  base.PollEvents();
+  TEST_EXPECT(platform.GetFrameCount() == frameCount + 1);
+  TEST_EXPECT(input.GetKeyboard(Dy_Key_W) == EInputState::Pressed);
+  TEST_EXPECT(input.GetMouseButton(DyMouseButton1) == EInputState::Pressed);
+  TEST_EXPECT(input.GetMousePos().has_value() == true);
+  TEST_EXPECT(input.GetMousePos()->first == 10 && input.GetMousePos()->second == 20);
+
+  // Key held on next poll is repeated.
+  platform.QueueKeyboard({Dy_Key_W, EInputState::Pressed});
+  platform.QueueMousePos({15, 30});
+  base.PollEvents();
+  TEST_EXPECT(input.GetKeyboard(Dy_Key_W) == EInputState::Repeated);
+  TEST_EXPECT(input.GetMousePosMovement().has_value() == true);
+  TEST_EXPECT(input.GetMousePosMovement()->first == 5 && input.GetMousePosMovement()->second == 10);
+
+  // Events in one poll are applied in queued order, so key released and pressed again is pressed.
+  platform.QueueKeyboard({Dy_Key_W, EInputState::Released});
+  platform.QueueKeyboard({Dy_Key_W, EInputState::Pressed});
+  platform.QueueMouseButton({DyMouseButton1, EInputState::Released});
+  base.PollEvents();
+  TEST_EXPECT(input.GetKeyboard(Dy_Key_W) == EInputState::Pressed);
+  TEST_EXPECT(input.GetMouseButton(DyMouseButton1) == EInputState::Released);
+}
+
+/// @brief Platform is shutdown by shutdown request, frame count or termination signal.
+void RunShutdown(dy::FHeadlessPlatform& platform, const dy::DWindowHandle& window)
+{
+  dy::APlatformBase& base = platform;
+  TEST_EXPECT(base.CanShutdown() == false);
+  TEST_EXPECT(base.TryShutdown() == true);
+  TEST_EXPECT(base.CanShutdown() == true);
+  TEST_EXPECT(base.TryShutdown() == false);
+  TEST_EXPECT(base.RemoveWindow(window) == true);
+}
+
+void RunFrameCountShutdown()
+{
+  dy::FHeadlessPlatform platform;
+  dy::APlatformBase& base = platform;
+  TEST_EXPECT(base.InitPlatform() == true);
+  const auto window = RunWindow(base);
+
+  platform.SetMaxFrameCount(3);
+  base.PollEvents();
+  base.PollEvents();
+  TEST_EXPECT(base.CanShutdown() == false);
+  base.PollEvents();
+  TEST_EXPECT(base.CanShutdown() == true);
+
+  TEST_EXPECT(base.RemoveWindow(window) == true);
+  TEST_EXPECT(base.ReleasePlatform() == true);
+}
+
+void RunSignalShutdown()
+{
+  dy::FHeadlessPlatform platform;
+  dy::APlatformBase& base = platform;
+  TEST_EXPECT(base.InitPlatform() == true);
+  const auto window = RunWindow(base);
+
+  // Signal is handled at next poll, not in handler.
+  std::raise(SIGTERM);
+  TEST_EXPECT(base.CanShutdown() == false);
+  base.PollEvents();
+  TEST_EXPECT(base.CanShutdown() == true);
+
+  TEST_EXPECT(base.RemoveWindow(window) == true);
+  TEST_EXPECT(base.ReleasePlatform() == true);
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  {
+    dy::FHeadlessPlatform platform;
+    dy::APlatformBase& base = platform;
+    TEST_EXPECT(base.InitPlatform() == true);
+
+    const auto window = RunWindow(base);
+    RunInput(platform);
+    RunShutdown(platform, window);
+    TEST_EXPECT(base.RemoveAllWindow() == true);
+    TEST_EXPECT(base.ReleasePlatform() == true);
+  }
+
+  RunFrameCountShutdown();
+  RunSignalShutdown();
+
+  std::printf("Window, input, resize, poll and shutdown of headless platform passed.\n");
+  return 0;
+}
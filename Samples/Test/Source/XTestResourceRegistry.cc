@@ -0,0 +1,208 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <d3d11.h>
+
+#include <ComWrapper/IComOwner.h>
+#include <Mock/FMockCommandLog.h>
+#include <Mock/FMockD3D11Factory.h>
+#include <Resource/TShardedSlotMap.h>
+#include <XTestUtility.h>
+
+namespace
+{
+
+/// Same container type as buffer container of MD3D11Resources.
+using TRegistry = TShardedSlotMap<IComOwner<ID3D11Buffer>>;
+
+constexpr size_t kThreadCount = 8;
+constexpr size_t kIterationCount = 20000;
+/// Each thread publishes its live keys into own slots, so other threads can visit them.
+constexpr size_t kSlotCount = 32;
+
+uint64_t Pack(const DSlotKey& key) noexcept
+{
+  return (uint64_t(key.mGeneration) << 32) | key.mIndex;
+}
+
+DSlotKey Unpack(uint64_t packed) noexcept
+{
+  return DSlotKey{uint32_t(packed), uint32_t(packed >> 32)};
+}
+
+/// @brief Create mock buffer. Byte width is always multiple of 16.
+ID3D11Buffer* CreateBuffer(ID3D11Device& device, size_t seed)
+{
+  D3D11_BUFFER_DESC desc = {};
+  desc.ByteWidth = UINT(16 * (1 + seed % 64));
+  desc.Usage = D3D11_USAGE_DEFAULT;
+  desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+  ID3D11Buffer* pBuffer = nullptr;
+  TEST_EXPECT(SUCCEEDED(device.CreateBuffer(&desc, nullptr, &pBuffer)));
+  return pBuffer;
+}
+
+/// @struct DThreadResult
+/// @brief Counts of one worker thread.
+struct DThreadResult final
+{
+  size_t mInsertCount = 0;
+  size_t mRemoveCount = 0;
+  size_t mForeignHitCount = 0;
+  size_t mForeignStaleCount = 0;
+};
+
+/// @brief Insert, visit and remove buffers, and visit keys of other threads at the same time.
+void RunWorker(
+  ID3D11Device& device, TRegistry& registry, 
+  std::vector<std::atomic<uint64_t>>& slots, size_t threadIndex, DThreadResult& result)
+{
+  std::mt19937 random{uint32_t(threadIndex + 1)};
+  std::uniform_int_distribution<size_t> slotDist{0, slots.size() - 1};
+
+  for (size_t i = 0; i < kIterationCount; ++i)
+  {
+    auto* pBuffer = CreateBuffer(device, threadIndex * kIterationCount + i);
+    const auto key = registry.Emplace(pBuffer);
+    result.mInsertCount += 1;
+
+    // Own value must be found as it was inserted.
+    TEST_EXPECT(registry.Has(key) == true);
+    TEST_EXPECT(registry.Visit(key, [](auto& owner) { return owner.GetPtr(); }) == pBuffer);
+
+    // Publish key, and remove key which was in the slot. Only this thread writes own slots.
+    auto& slot = slots[threadIndex * kSlotCount + i % kSlotCount];
+    const auto oldPacked = slot.exchange(Pack(key));
+    if (oldPacked != 0)
+    {
+      const auto oldKey = Unpack(oldPacked);
+      TEST_EXPECT(registry.Remove(oldKey) == true);
+      result.mRemoveCount += 1;
+
+      // Removed key must not be visited, even if its slot was reused by other value.
+      bool isCalled = false;
+      try { registry.Visit(oldKey, [&isCalled](auto&) { isCalled = true; }); }
+      catch (const std::out_of_range&) { }
+      TEST_EXPECT(isCalled == false);
+      TEST_EXPECT(registry.Remove(oldKey) == false);
+    }
+
+    // Let other threads run between operations even on machine with few cores.
+    if (i % 64 == 0) { std::this_thread::yield(); }
+
+    // Key of other thread can be removed at any time, so it is either valid value or stale.
+    const auto foreignPacked = slots[slotDist(random)].load();
+    if (foreignPacked == 0) { continue; }
+    try
+    {
+      const UINT byteWidth = registry.Visit(Unpack(foreignPacked), [](auto& owner)
+      {
+        TEST_EXPECT(owner.IsValid() == true);
+        D3D11_BUFFER_DESC desc = {};
+        owner.GetPtr()->GetDesc(&desc);
+        return desc.ByteWidth;
+      });
+      TEST_EXPECT(byteWidth > 0 && byteWidth % 16 == 0);
+      result.mForeignHitCount += 1;
+    }
+    catch (const std::out_of_range&)
+    {
+      result.mForeignStaleCount += 1;
+    }
+  }
+}
+
+/// @brief Remove the same keys from all threads at once, as two owners release shared handle.
+/// Each key must be removed by exactly one thread.
+void RunConcurrentRemoval(ID3D11Device& device, TRegistry& registry)
+{
+  constexpr size_t kKeyCount = 2000;
+  std::vector<DSlotKey> keys;
+  for (size_t i = 0; i < kKeyCount; ++i) { keys.push_back(registry.Emplace(CreateBuffer(device, i))); }
+
+  std::atomic<size_t> removedCount = 0;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreadCount; ++t)
+  {
+    threads.emplace_back([&]
+    {
+      for (size_t i = 0; i < kKeyCount; ++i)
+      {
+        if (registry.Remove(keys[i]) == true) { removedCount.fetch_add(1); }
+        if (i % 64 == 0) { std::this_thread::yield(); }
+      }
+    });
+  }
+  for (auto& thread : threads) { thread.join(); }
+
+  TEST_EXPECT(removedCount.load() == kKeyCount);
+  TEST_EXPECT(registry.Size() == 0);
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  FMockCommandLog deviceLog;
+  FMockCommandLog contextLog;
+  deviceLog.SetRecording(false);
+  ID3D11Device* pDevice = nullptr;
+  ID3D11DeviceContext* pDc = nullptr;
+  TEST_EXPECT(SUCCEEDED(FMockD3D11Factory::CreateDevice(deviceLog, contextLog, &pDevice, &pDc)));
+
+  TRegistry registry;
+  std::vector<std::atomic<uint64_t>> slots(kThreadCount * kSlotCount);
+  std::array<DThreadResult, kThreadCount> results = {};
+  {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadCount; ++i)
+    {
+      threads.emplace_back(RunWorker, std::ref(*pDevice), std::ref(registry), std::ref(slots), i, std::ref(results[i]));
+    }
+    for (auto& thread : threads) { thread.join(); }
+  }
+
+  // Only published keys are alive.
+  DThreadResult total;
+  for (const auto& result : results)
+  {
+    total.mInsertCount += result.mInsertCount;
+    total.mRemoveCount += result.mRemoveCount;
+    total.mForeignHitCount += result.mForeignHitCount;
+    total.mForeignStaleCount += result.mForeignStaleCount;
+  }
+  TEST_EXPECT(total.mInsertCount == kThreadCount * kIterationCount);
+  TEST_EXPECT(registry.Size() == total.mInsertCount - total.mRemoveCount);
+  TEST_EXPECT(registry.Size() == kThreadCount * kSlotCount);
+  TEST_EXPECT(deviceLog.GetCount(EMockD3D11Call::CreateBuffer) == total.mInsertCount);
+
+  for (auto& slot : slots) { TEST_EXPECT(registry.Remove(Unpack(slot.load())) == true); }
+  TEST_EXPECT(registry.Size() == 0);
+
+  RunConcurrentRemoval(*pDevice, registry);
+
+  std::printf("Inserted %zu, visited %zu foreign values and %zu stale foreign keys from %zu threads.\n",
+    total.mInsertCount, total.mForeignHitCount, total.mForeignStaleCount, kThreadCount);
+
+  pDc->Release();
+  pDevice->Release();
+  return 0;
+}
@@ -0,0 +1,75 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdio>
+#include <Profiling/FTimeContainer.h>
+#include <XTestUtility.h>
+
+namespace
+{
+
+DHardwareCounters MakeCounters(uint64_t cycles, uint64_t instructions)
+{
+  DHardwareCounters counters;
+  counters.mCycles = cycles;
+  counters.mInstructions = instructions;
+  return counters;
+}
+
+/// @brief Scopes of one tag can be recorded on threads with and without counters.
+void RunMixedInsertion()
+{
+  FTimeContainer container{4};
+  container.Insert(TTimeStamp(1.0));
+  TEST_EXPECT(container.HasCounters() == false);
+  TEST_EXPECT(container.GetInstructionsPerCycle() == -1.0);
+
+  // Counters arrive after one time stamp without counters.
+  container.Insert(TTimeStamp(1.0), MakeCounters(100, 200));
+  container.Insert(TTimeStamp(1.0));
+  container.Insert(TTimeStamp(1.0), MakeCounters(300, 400));
+  TEST_EXPECT(container.Length() == 4);
+  TEST_EXPECT(container.HasCounters() == true);
+  TEST_EXPECT(container.GetAverageCounters().mCycles == 200);
+  TEST_EXPECT(container.GetAverageCounters().mInstructions == 300);
+
+  // Wrap window. Slot of (100, 200) is replaced by slot without counters.
+  container.Insert(TTimeStamp(1.0));
+  container.Insert(TTimeStamp(1.0));
+  TEST_EXPECT(container.GetAverageCounters().mCycles == 300);
+  TEST_EXPECT(container.GetInstructionsPerCycle() == 400.0 / 300.0);
+
+  // Last slot with counters goes out of window.
+  container.Insert(TTimeStamp(1.0));
+  container.Insert(TTimeStamp(1.0));
+  TEST_EXPECT(container.HasCounters() == false);
+  TEST_EXPECT(container.GetAverageCounters().mCycles == 0);
+  TEST_EXPECT(container.GetAverage() == TTimeStamp(1.0));
+
+  // Counters are cleared with window.
+  container.Insert(TTimeStamp(1.0), MakeCounters(10, 10));
+  container.SetWindowLength(2);
+  TEST_EXPECT(container.HasCounters() == false);
+  container.Insert(TTimeStamp(1.0), MakeCounters(10, 30));
+  TEST_EXPECT(container.GetInstructionsPerCycle() == 3.0);
+}
+
+} /// ::anonymous namespace
+
+int main()
+{
+  RunMixedInsertion();
+
+  std::printf("Mixed insertion of time stamps with and without counters passed.\n");
+  return 0;
+}
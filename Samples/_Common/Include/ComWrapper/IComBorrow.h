@@ -12,15 +12,13 @@
 /// SOFTWARE.
 ///
 
-template <typename TType>
-class __IComOwner;
-
-template <typename TType>
-class XComCounter;
+#include <ComWrapper/XComPolicy.h>
 
 /// @class IComBorrow
-/// @brief 
-template <typename TType>
+/// @brief Non-owning reference of COM instance of IComOwner.
+/// This is XComChecked version.
+/// Borrow shares control block with owner, so IsValid() becomes false when owner is released.
+template <typename TType, typename TPolicy>
 class IComBorrow final
 {
 public:
@@ -29,7 +27,10 @@ public:
   IComBorrow(const IComBorrow& borrow)
     : mPtrCom{borrow.mPtrCom}
   {
-    this->mPtrCom->mCounter.syncPush(*this);
+    if (this->mPtrCom != nullptr)
+    {
+      this->mPtrCom->mCounter.syncPush();
+    }
   }
 
   IComBorrow& operator=(const IComBorrow& borrow)
@@ -37,31 +38,27 @@ public:
     if (this == &borrow) { return *this; }
     if (this->mPtrCom == borrow.mPtrCom) { return *this; }
 
+    this->TryReleaseSelf();
+    this->mPtrCom = borrow.mPtrCom;
     if (this->mPtrCom != nullptr)
     {
-      this->mPtrCom->mCounter.syncPop(*this);
+      this->mPtrCom->mCounter.syncPush();
     }
-    this->mPtrCom = borrow.mPtrCom;
-    this->mPtrCom->mCounter.syncPush(*this);
     return *this;
   }
 
   IComBorrow(IComBorrow&& borrow) noexcept
     : mPtrCom{borrow.mPtrCom}
   {
-    if (borrow.mPtrCom != nullptr) 
-    { 
-      borrow.mPtrCom->mCounter.syncPop(borrow);
-      borrow.mPtrCom = nullptr;
-      this->mPtrCom->mCounter.syncPush(*this);
-    }
+    // Reference is just transferred, so counter does not need to be touched.
+    borrow.mPtrCom = nullptr;
   }
 
   IComBorrow& operator=(IComBorrow&& borrow) noexcept = delete;
 
   ~IComBorrow();
 
-  /// @brief Check this instance is valid (owns COM instance)
+  /// @brief Check this instance is valid (owner of COM instance is alive)
   [[nodiscard]] bool IsValid() const noexcept;
 
   TType& GetRef() 
@@ -80,8 +77,37 @@ public:
   }
 
 private:
+  /// @brief Release reference of control block. 
+  /// If this was the last reference, control block is deleted.
+  void TryReleaseSelf() noexcept;
+
   __IComOwner<TType>* mPtrCom = nullptr;
+};
+
+/// @class IComBorrow
+/// @brief Non-owning reference of COM instance of IComOwner.
+/// This is XComUnchecked version, which is just a plain pointer. 
+/// IsValid() does not know whether owner was released or not.
+template <typename TType>
+class IComBorrow<TType, XComUnchecked> final
+{
+public:
+  explicit IComBorrow(TType* pComInstance) noexcept : mPtrOwner{pComInstance} {};
 
-  friend class XComCounter<TType>;
+  IComBorrow(const IComBorrow&) noexcept = default;
+  IComBorrow& operator=(const IComBorrow&) noexcept = default;
+  IComBorrow(IComBorrow&&) noexcept = default;
+  IComBorrow& operator=(IComBorrow&& borrow) noexcept = delete;
+  ~IComBorrow() = default;
+
+  /// @brief Check this instance is valid (not null)
+  [[nodiscard]] bool IsValid() const noexcept { return this->mPtrOwner != nullptr; }
+
+  TType& GetRef() { return *this->mPtrOwner; }
+  TType* GetPtr() { return this->mPtrOwner; }
+  TType* operator->() { return this->mPtrOwner; }
+
+private:
+  TType* mPtrOwner = nullptr;
 };
 #include <Inline/IComBorrow.inl>
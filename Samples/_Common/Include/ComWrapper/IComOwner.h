@@ -12,19 +12,17 @@
 /// SOFTWARE.
 ///
 
+#include <cassert>
 #include <memory>
 #include <type_traits>
+#include <ComWrapper/XComBlockPool.h>
 #include <ComWrapper/XComCounter.h>
-
-template <typename TType>
-class IComBorrow;
-
-template <typename TType>
-class __IComOwner;
+#include <ComWrapper/XComPolicy.h>
 
 /// @class IComOwner
-/// @brief
-template <typename TType>
+/// @brief Owner of COM instance. COM instance is released when owner is destructed.
+/// This is XComChecked version, which tracks borrows with shared control block.
+template <typename TType, typename TPolicy>
 class [[nodiscard]] IComOwner final
 {
 public:
@@ -50,7 +48,7 @@ public:
 #endif
 
   /// @brief Get Borrow type of COM Owner.
-  IComBorrow<TType> GetBorrow() noexcept;
+  IComBorrow<TType, TPolicy> GetBorrow() noexcept;
 
   /// @brief Get pointer of COM instance pointer.
   /// This function should be used carefully.
@@ -76,6 +74,75 @@ private:
   __IComOwner<TType>* mObj = nullptr;
   //std::unique_ptr<XComCounter<TType>> mCounter = nullptr;
 
+  static_assert(
+    std::is_base_of_v<IUnknown, TType>,
+    "TType must be derived from IUnknown.");
+  static_assert(
+    std::is_same_v<TPolicy, XComChecked>,
+    "TPolicy must be XComChecked or XComUnchecked.");
+};
+
+/// @class IComOwner
+/// @brief Owner of COM instance. COM instance is released when owner is destructed.
+/// This is XComUnchecked version, which does not allocate control block and does not track borrows.
+template <typename TType>
+class [[nodiscard]] IComOwner<TType, XComUnchecked> final
+{
+public:
+  using Type = TType;
+  using TPtrType = TType*;
+
+  IComOwner(std::nullptr_t) {};
+  explicit IComOwner(TType* pCOMInstance) : mPtrOwner{pCOMInstance} {};
+  ~IComOwner() { this->Release(); }
+
+  IComOwner(const IComOwner&) = delete;
+  IComOwner& operator=(const IComOwner&) = delete;
+  IComOwner(IComOwner&& movedOwner) noexcept 
+    : mPtrOwner{movedOwner.mPtrOwner}
+  {
+    movedOwner.mPtrOwner = nullptr;
+  }
+  IComOwner& operator=(IComOwner&& movedOwner) noexcept
+  {
+    if (this == &movedOwner) { return *this; }
+
+    this->Release();
+    this->mPtrOwner = movedOwner.mPtrOwner;
+    movedOwner.mPtrOwner = nullptr;
+    return *this;
+  }
+
+  /// @brief Check this instance is valid (owns COM instance)
+  [[nodiscard]] bool IsValid() const noexcept { return this->mPtrOwner != nullptr; }
+
+  /// @brief Get Borrow type of COM Owner.
+  IComBorrow<TType, XComUnchecked> GetBorrow() noexcept;
+
+  /// @brief Get pointer of COM instance pointer.
+  /// This function should be used carefully.
+  TType* GetPtr() noexcept { return this->mPtrOwner; }
+
+  /// @brief Try release COM instance if COM is bound to wrapping type.
+  void Release()
+  {
+    if (this->mPtrOwner == nullptr) { return; }
+
+    this->mPtrOwner->Release();
+    this->mPtrOwner = nullptr;
+  }
+
+  /// @brief Get reference of COM instance ptr.
+  /// This does not check validity.
+  TType& operator*() { return *this->mPtrOwner; }
+
+  /// @brief Get pointer of COM instance.
+  /// This does not check validity.
+  TType* operator->() { return this->mPtrOwner; }
+
+private:
+  TType* mPtrOwner = nullptr;
+
   static_assert(
     std::is_base_of_v<IUnknown, TType>,
     "TType must be derived from IUnknown.");
@@ -92,9 +159,23 @@ public:
   __IComOwner(__IComOwner&&) noexcept = delete;
   __IComOwner& operator=(__IComOwner&&) noexcept = delete;
 
+#if COMWRAPPER_POOLED == 1
+  /// @brief Control blocks are allocated from per-type pool.
+  static void* operator new([[maybe_unused]] std::size_t size)
+  {
+    assert(size == sizeof(__IComOwner));
+    return XComBlockPool<__IComOwner>::Allocate();
+  }
+
+  static void operator delete(void* pBlock) noexcept
+  {
+    XComBlockPool<__IComOwner>::Deallocate(pBlock);
+  }
+#endif
+
   /// @brief Actual COM instance pointer.
   TType* mPtrOwner = nullptr;
-  /// @brief Counter. life-scope is __IComOwner's cosntruction and destruction.
+  /// @brief Reference counter of owner and borrows. This control block is deleted when it reaches 0.
   XComCounter<TType> mCounter;
 };
 #include <Inline/IComOwner.inl>
@@ -0,0 +1,99 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/// @struct DComPoolStatistics
+/// @brief Allocation statistics of XComBlockPool.
+struct DComPoolStatistics final
+{
+  /// @brief The number of blocks handed out by pool.
+  uint64_t mBlockAllocations = 0;
+  /// @brief The number of blocks returned to pool.
+  uint64_t mBlockDeallocations = 0;
+  /// @brief The number of chunk allocations. (Actual heap allocations)
+  uint64_t mChunkAllocations = 0;
+};
+
+/// @class XComBlockPoolBase
+/// @brief Statistics of all XComBlockPool types.
+class XComBlockPoolBase
+{
+public:
+  /// @brief Get summed statistics of all pools.
+  static DComPoolStatistics GetTotalStatistics() noexcept
+  {
+    return DComPoolStatistics{
+      sTotalBlockAllocations.load(std::memory_order_relaxed),
+      sTotalBlockDeallocations.load(std::memory_order_relaxed),
+      sTotalChunkAllocations.load(std::memory_order_relaxed)};
+  }
+
+protected:
+  inline static std::atomic<uint64_t> sTotalBlockAllocations = 0;
+  inline static std::atomic<uint64_t> sTotalBlockDeallocations = 0;
+  inline static std::atomic<uint64_t> sTotalChunkAllocations = 0;
+};
+
+/// @class XComBlockPool
+/// @tparam TBlock Block type. (e.g. __IComOwner<ID3D11Buffer>)
+/// @brief Per-type fixed-size block pool. 
+/// Blocks are carved from chunks of kChunkBlockCount blocks and recycled through free list,
+/// so creating many COM wrappers does not call heap allocation for each one.
+/// Chunks are never returned to heap.
+template <typename TBlock>
+class XComBlockPool final : public XComBlockPoolBase
+{
+public:
+  /// @brief The number of blocks of one chunk.
+  static constexpr std::size_t kChunkBlockCount = 256;
+
+  /// @brief Get uninitialized memory of one block.
+  [[nodiscard]] static void* Allocate();
+
+  /// @brief Return memory of block into pool. Block must be already destructed.
+  static void Deallocate(void* pBlock) noexcept;
+
+  /// @brief Get statistics of this pool.
+  [[nodiscard]] static DComPoolStatistics GetStatistics();
+
+private:
+  /// @union DSlot
+  /// @brief Storage of one block. When slot is free, it is node of free list.
+  union DSlot
+  {
+    DSlot* mPtrNext;
+    alignas(TBlock) unsigned char mStorage[sizeof(TBlock)];
+  };
+
+  /// @struct DState
+  /// @brief Internal state of pool.
+  struct DState final
+  {
+    std::mutex mMutex;
+    DSlot* mPtrFreeHead = nullptr;
+    std::vector<DSlot*> mChunks;
+    DComPoolStatistics mStatistics;
+  };
+
+  /// @brief Get state of pool. 
+  /// State is intentionally never destructed, because control blocks can be released 
+  /// by other static instances on program exit.
+  static DState& GetState();
+};
+#include <Inline/XComBlockPool.inl>
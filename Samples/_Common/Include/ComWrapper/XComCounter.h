@@ -13,62 +13,42 @@
 ///
 
 #include <cstdint>
-#include <cassert>
-
 #include <atomic>
-#include <algorithm>
-#include <mutex>
-#include <vector>
-
-template <typename TType>
-class IComBorrow;
 
+/// @class XComCounter
+/// @brief Lock-free reference counter of __IComOwner control block.
+/// Owner holds one reference and each IComBorrow holds one reference, 
+/// so control block outlives owner while any borrow is alive.
+/// When owner is released, borrows are not visited but see that owner is dead through this counter.
 template <typename TType>
 class XComCounter final
 {
 public:
   XComCounter() = default;
-  ~XComCounter();
 
-  /// @brief
-  void syncPush(IComBorrow<TType>& borrow)
-  {
-    const auto counter = this->mCounter.load(std::memory_order_consume);
-    this->mCounter.store(counter + 1, std::memory_order_release);
+  XComCounter(const XComCounter&) = delete;
+  XComCounter& operator=(const XComCounter&) = delete;
+
+  /// @brief Add reference of new borrow.
+  void syncPush() noexcept;
 
-    {
-      std::lock_guard<std::mutex> mtx(this->mMutexBorrows);
-      this->mBorrows.emplace_back(&borrow);
-    }
-  }
+  /// @brief Remove reference of borrow or owner.
+  /// @return If this was the last reference, return true. Caller must delete control block.
+  [[nodiscard]] bool syncPop() noexcept;
 
-  /// @brief
-  void syncPop(IComBorrow<TType>& pop)
-  {
-    const auto counter = mCounter.load(std::memory_order_consume);
-    this->mCounter.store(counter - 1, std::memory_order_release);
+  /// @brief Mark owner is released. Owner must call syncPop() after this.
+  void syncInvalidate() noexcept;
 
-    {
-      std::lock_guard<std::mutex> mtx(this->mMutexBorrows);
-      auto it = 
-        std::find_if(
-          mBorrows.begin(), mBorrows.end(), 
-          [pPop = &pop](const auto& pItem) { return pItem == pPop; }
-      );
-      assert(it != this->mBorrows.end());
-      this->mBorrows.erase(it);
-    }
-  }
+  /// @brief Check owner is not released yet.
+  [[nodiscard]] bool syncIsOwnerAlive() const noexcept;
 
-  /// @brief
-  uint32_t syncGetCounter()
-  {
-    return this->mCounter.load(std::memory_order_consume);
-  }
+  /// @brief Get the number of living borrows.
+  [[nodiscard]] uint32_t syncGetCounter() const noexcept;
 
 private:
-  std::atomic<uint32_t> mCounter = 0;
-  std::mutex mMutexBorrows;
-  std::vector<IComBorrow<TType>*> mBorrows;
+  /// @brief The number of references. Owner (if alive) + Borrows.
+  std::atomic<uint32_t> mCounter = 1;
+  /// @brief Owner is alive or not.
+  std::atomic<bool> mIsOwnerAlive = true;
 };
 #include <Inline/XComCounter.inl>
@@ -0,0 +1,56 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <type_traits>
+
+/// @def COMWRAPPER_CHECKED
+/// @brief If 1, IComOwner and IComBorrow use XComChecked policy as default.
+/// Default value is 1 in debug build, and 0 in release build.
+#ifndef COMWRAPPER_CHECKED
+#if defined(DEBUG) || defined(_DEBUG)
+#define COMWRAPPER_CHECKED 1
+#else
+#define COMWRAPPER_CHECKED 0
+#endif
+#endif
+
+/// @def COMWRAPPER_POOLED
+/// @brief If 1, control blocks of XComChecked wrappers are allocated from XComBlockPool.
+/// If 0, they are allocated from heap one by one. Default value is 1.
+#ifndef COMWRAPPER_POOLED
+#define COMWRAPPER_POOLED 1
+#endif
+
+/// @struct XComChecked
+/// @brief Policy of COM wrapper. 
+/// Owner and borrows share reference-counted control block, 
+/// so borrow can detect that owner was released, and owner can assert dangling borrows.
+struct XComChecked final {};
+
+/// @struct XComUnchecked
+/// @brief Policy of COM wrapper. 
+/// Owner holds COM instance pointer directly and borrow is just a plain pointer without tracking.
+struct XComUnchecked final {};
+
+/// @brief Default policy of COM wrapper types.
+using XComDefaultPolicy = std::conditional_t<COMWRAPPER_CHECKED == 1, XComChecked, XComUnchecked>;
+
+template <typename TType, typename TPolicy = XComDefaultPolicy>
+class IComOwner;
+
+template <typename TType, typename TPolicy = XComDefaultPolicy>
+class IComBorrow;
+
+template <typename TType>
+class __IComOwner;
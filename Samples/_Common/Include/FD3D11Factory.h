@@ -15,7 +15,7 @@
 #include <optional>
 #include <string>
 #include <filesystem>
-#include <D3D11.h>
+#include <d3d11.h>
 
 #include <ComWrapper/IComOwner.h>
 #include <Resource/DD3D11Handle.h>
@@ -13,16 +13,18 @@
 ///
 
 #include <optional>
-#include <unordered_map>
-#include <D3D11.h>
+#include <d3d11.h>
 #include <ComWrapper/IComBorrow.h>
 #include <ComWrapper/IComOwner.h>
-#include <Math/Type/Micellanous/DUuid.h>
 #include <Resource/DD3DResourceDevice.h>
 #include <Resource/DD3D11Handle.h>
 #include <Resource/E11SimpleQueryType.h>
+#include <Resource/ED3D11Resc.h>
+#include <Resource/TShardedSlotMap.h>
 
 class D11DefaultHandles;
+class FMockCommandLog;
+struct PMockD3D11Descriptor;
 
 namespace dy
 {
@@ -32,6 +34,8 @@ class APlatformBase;
 
 /// @class MD3D11Resources
 /// @brief Manager class of D3D11 Resources.
+/// Resources can be created, looked up and removed from multiple threads 
+/// when MD3D11RESOURCES_CONCURRENT is 1. (Default)
 class MD3D11Resources final
 {
 public:
@@ -41,20 +45,35 @@ public:
   [[nodiscard]] static std::optional<D11HandleDevice> 
   CreateD3D11DefaultDevice(dy::APlatformBase& platform);
 
+  /// @brief Create recording mock device which does not use GPU.
+  /// Swap-chain can not be created from mock device, so use texture render target instead.
+  /// @param deviceLog Command log of device calls.
+  /// @param contextLog Command log of immediate context calls.
+  /// @return If successful, return device handle instance.
+  [[nodiscard]] static std::optional<D11HandleDevice> 
+  CreateD3D11MockDevice(FMockCommandLog& deviceLog, FMockCommandLog& contextLog);
+
+  /// @brief Create recording mock device with given mock behavior. (e.g. query latency)
+  [[nodiscard]] static std::optional<D11HandleDevice> 
+  CreateD3D11MockDevice(
+    FMockCommandLog& deviceLog, 
+    FMockCommandLog& contextLog, 
+    const PMockD3D11Descriptor& desc);
+
   /// @brief Check device resource is valid and in container.
   /// @param handle Device handle.
   /// @return If find, return true. Otherwise, return false.
   [[nodiscard]] static bool HasDevice(const D11HandleDevice& handle) noexcept;
 
   /// @brief Get borrow type of Device resource safely. 
-  /// This function does not check whether handle is valid or not and device resource is exist or not.
+  /// If handle is null or stale, or device resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleDevice::IsValid() and MD3D11Resources::HasDevice().
   /// @param handle Valid device handle.
   /// @return Return borrow type of actual D3D11 device resource.
   static IComBorrow<ID3D11Device> GetDevice(const D11HandleDevice& handle);
 
   /// @brief Get borrow type of Device context resource safely.
-  /// This function does not check whether handle is valid or not and device resource is exist or not.
+  /// If handle is null or stale, or device resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleDevice::IsValid() and MD3D11Resources::HasDevice().
   /// @param handle Valid device handle.
   /// @return Return borrow type of actual D3D11 device context resource.
@@ -83,7 +102,7 @@ public:
   [[nodiscard]] static bool HasSwapChain(const D11SwapChainHandle& handle) noexcept;
 
   /// @brief Get borrow type of Swap-chain context resource safely.
-  /// This function does not check whether handle is valid or not and swap-chain resource is exist or not.
+  /// If handle is null or stale, or swap-chain resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleSwapChain::IsValid() and MD3D11Resources::HasSwapChain().
   /// @param handle Valid swap-chain handle.
   /// @return Return borrow type of actual D3D11 swap-chain resource.
@@ -114,7 +133,7 @@ public:
   [[nodiscard]] static bool HasRTV(const D11HandleRTV& handle) noexcept;
 
   /// @brief Get borrow type of RTV resource safely.
-  /// This function does not check whether handle is valid or not and RTV resource is exist or not.
+  /// If handle is null or stale, or RTV resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleRTV::IsValid() and MD3D11Resources::HasRTV().
   /// @param handle Valid RTV handle.
   /// @return Return borrow type of actual D3D11 RTV resource.
@@ -145,7 +164,7 @@ public:
   [[nodiscard]] static bool HasDSV(const D11HandleDSV& handle) noexcept;
 
   /// @brief Get borrow type of DSV resource safely.
-  /// This function does not check whether handle is valid or not and DSV resource is exist or not.
+  /// If handle is null or stale, or DSV resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleDSV::IsValid() and MD3D11Resources::HasDSV().
   /// @param handle Valid DSV handle.
   /// @return Return borrow type of actual D3D11 DSV resource.
@@ -173,7 +192,7 @@ public:
   [[nodiscard]] static bool HasRasterState(const D11HandleRasterState& handle) noexcept;
 
   /// @brief Get borrow type of RasterState resource safely.
-  /// This function does not check whether handle is valid or not and RasterState resource is exist or not.
+  /// If handle is null or stale, or RasterState resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleRasterState::IsValid() and MD3D11Resources::HasRasterState().
   /// @param handle Valid RasterState handle.
   /// @return Return borrow type of actual D3D11 RasterState resource.
@@ -201,8 +220,7 @@ public:
   [[nodiscard]] static bool HasDepthStencilState(const D11HandleDepthStencilState& handle) noexcept;
 
   /// @brief Get borrow type of Depth-Stencil State resource safely. \n
-  /// This function does not check whether handle is valid 
-  /// or not and Depth-Stencil State resource is exist or not. \n
+  /// If handle is null or stale, or Depth-Stencil State resource was removed, throw std::out_of_range. \n
   /// That can be checkable for using D11HandleDepthStencilState::IsValid() 
   /// and MD3D11Resources::HasDepthStencilState(). 
   /// @param handle Valid Depth-Stencil State handle.
@@ -231,8 +249,7 @@ public:
   [[nodiscard]] static bool HasBlendState(const D11HandleBlendState& handle) noexcept;
 
   /// @brief Get borrow type of Blend State resource safely. \n
-  /// This function does not check whether handle is valid 
-  /// or not and Blend State resource is exist or not. \n
+  /// If handle is null or stale, or Blend State resource was removed, throw std::out_of_range. \n
   /// That can be checkable for using D11HandleBlendState::IsValid() 
   /// and MD3D11Resources::HasBlendState(). 
   /// @param handle Valid Blend State handle.
@@ -264,7 +281,7 @@ public:
   [[nodiscard]] static bool HasTexture2D(const D11HandleTexture2D& handle);
 
   /// @brief Get borrow type of Texture2D resource safely.
-  /// This function does not check whether handle is valid or not and Texture2D resource is exist or not.
+  /// If handle is null or stale, or Texture2D resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleTexture2D::IsValid() and MD3D11Resources::HasTexture2D().
   /// @param handle Valid Texture2D handle.
   /// @return Return borrow type of actual D3D11 Texture2D resource.
@@ -295,7 +312,7 @@ public:
   [[nodiscard]] static bool HasBuffer(const D11HandleBuffer& handle);
 
   /// @brief Get borrow type of Buffer resource safely.
-  /// This function does not check whether handle is valid or not and Buffer resource is exist or not.
+  /// If handle is null or stale, or Buffer resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleBuffer::IsValid() and MD3D11Resources::HasBuffer().
   /// @param handle Valid Buffer handle.
   /// @return Return borrow type of actual D3D11 Buffer resource.
@@ -330,7 +347,7 @@ public:
   [[nodiscard]] static bool HasBlob(const D11HandleBlob& handle);
 
   /// @brief Get borrow type of Blob resource safely.
-  /// This function does not check whether handle is valid or not and Blob resource is exist or not.
+  /// If handle is null or stale, or Blob resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleBlob::IsValid() and MD3D11Resources::HasBlob().
   /// @param handle Valid Blob handle.
   /// @return Return borrow type of actual D3D11 Blob resource.
@@ -359,7 +376,7 @@ public:
   [[nodiscard]] static bool HasVertexShader(const D11HandleVS& handle);
 
   /// @brief Get borrow type of Vertex Shader resource safely.
-  /// This function does not check whether handle is valid or not and Vertex Shader resource is exist or not.
+  /// If handle is null or stale, or Vertex Shader resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleVS::IsValid() and MD3D11Resources::HasVertexShader().
   /// @param handle Valid Vertex Shader handle.
   /// @return Return borrow type of actual D3D11 Vertex Shader resource.
@@ -388,7 +405,7 @@ public:
   [[nodiscard]] static bool HasPixelShader(const D11HandlePS& handle);
 
   /// @brief Get borrow type of Pixel Shader resource safely.
-  /// This function does not check whether handle is valid or not and Pixel Shader resource is exist or not.
+  /// If handle is null or stale, or Pixel Shader resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleVS::IsValid() and MD3D11Resources::HasPixelShader().
   /// @param handle Valid Pixel Shader handle.
   /// @return Return borrow type of actual D3D11 Pixel Shader resource.
@@ -421,7 +438,7 @@ public:
   [[nodiscard]] static bool HasInputLayout(const D11HandleInputLayout& handle);
 
   /// @brief Get borrow type of Input Layout resource safely.
-  /// This function does not check whether handle is valid or not and Input Layout resource is exist or not.
+  /// If handle is null or stale, or Input Layout resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleInputLayout::IsValid() and MD3D11Resources::HasInputLayout().
   /// @param handle Valid Input Layout handle.
   /// @return Return borrow type of actual D3D11 Input Layout resource.
@@ -456,7 +473,7 @@ public:
   [[nodiscard]] static bool HasQuery(const D11HandleQuery& handle);
 
   /// @brief Get borrow type of Query resource safely.
-  /// This function does not check whether handle is valid or not and Query resource is exist or not.
+  /// If handle is null or stale, or Query resource was removed, throw std::out_of_range.
   /// That can be checkable for using D11HandleQuery::IsValid() and MD3D11Resources::HasQuery().
   /// @param handle Valid Query handle.
   /// @return Return borrow type of actual D3D11 Query resource.
@@ -475,38 +492,45 @@ public:
   /// All resource that be specified by member handles must be valid, or do nothing return false.
   static bool RemoveDefaultFrameBufferResouce(const D11DefaultHandles& handles);
 
+  /// @brief Get the number of alive resources of given type.
+  /// This can be called from any thread, such as metrics sampler.
+  [[nodiscard]] static std::size_t GetResourceCount(ED3D11Resc type);
+
 private:
+  /// @brief Resource container type. 
+  /// Handle has slot key of container, so lookup does not need hashing.
+  /// Each container can be accessed from multiple threads when MD3D11RESOURCES_CONCURRENT is 1.
   template <typename TValue>
-  using THashMap = std::unordered_map<::dy::math::DUuid, TValue>;
+  using TContainer = TShardedSlotMap<TValue>;
 
   using TThis = MD3D11Resources;
 
   /// @brief 
-  static THashMap<DD3DResourceDevice> mDevices; 
+  static TContainer<DD3DResourceDevice> mDevices; 
   /// @brief
-  static THashMap<IComOwner<IDXGISwapChain>> mSwapChains;
+  static TContainer<IComOwner<IDXGISwapChain>> mSwapChains;
   /// @brief Render-Target-View Resource Container.
-  static THashMap<IComOwner<ID3D11RenderTargetView>> mRTVs;
+  static TContainer<IComOwner<ID3D11RenderTargetView>> mRTVs;
   /// @brief Depth-Stencil-View Resource container.
-  static THashMap<IComOwner<ID3D11DepthStencilView>> mDSVs;
+  static TContainer<IComOwner<ID3D11DepthStencilView>> mDSVs;
   /// @brief Rasterizer-State Resource Container.
-  static THashMap<IComOwner<ID3D11RasterizerState>> mRasterStates;
+  static TContainer<IComOwner<ID3D11RasterizerState>> mRasterStates;
   /// @brief Depth-Stencil-State Resource Container.
-  static THashMap<IComOwner<ID3D11DepthStencilState>> mDepthStencilStates;
+  static TContainer<IComOwner<ID3D11DepthStencilState>> mDepthStencilStates;
   /// @brief Blend State Resource Container.
-  static THashMap<IComOwner<ID3D11BlendState>> mBlendStates;
+  static TContainer<IComOwner<ID3D11BlendState>> mBlendStates;
   /// @brief 2DTextureResource Container.
-  static THashMap<IComOwner<ID3D11Texture2D>> mTexture2Ds;
+  static TContainer<IComOwner<ID3D11Texture2D>> mTexture2Ds;
   /// @brief Buffer Resource Container.
-  static THashMap<IComOwner<ID3D11Buffer>> mBuffers;
+  static TContainer<IComOwner<ID3D11Buffer>> mBuffers;
   /// @brief Vertex-Shader Resource Container.
-  static THashMap<IComOwner<ID3D11VertexShader>> mVSs;
+  static TContainer<IComOwner<ID3D11VertexShader>> mVSs;
   /// @brief Pixel-Shader Resource Container.
-  static THashMap<IComOwner<ID3D11PixelShader>> mPSs;
+  static TContainer<IComOwner<ID3D11PixelShader>> mPSs;
   /// @brief Input Layout Resource Container.
-  static THashMap<IComOwner<ID3D11InputLayout>> mInputLayouts;
+  static TContainer<IComOwner<ID3D11InputLayout>> mInputLayouts;
   /// @brief Blob (arbitary length, buffer) Resource Container.
-  static THashMap<IComOwner<ID3DBlob>> mBlobs;
+  static TContainer<IComOwner<ID3DBlob>> mBlobs;
   /// @brief Query Resource Container.
-  static THashMap<IComOwner<ID3D11Query>> mQueries;
+  static TContainer<IComOwner<ID3D11Query>> mQueries;
 };
\ No newline at end of file
@@ -42,6 +42,11 @@
       #define HR(__MAExpression__) (__MAExpression__)
     #endif
   #endif
+#else
+  /// Error message box is only available on Windows, so result is just ignored.
+  #ifndef HR
+    #define HR(__MAExpression__) (__MAExpression__)
+  #endif
 #endif
 
 #define ReleaseCOM(x) { if(x){ x->Release(); x = NULL; } }
@@ -11,3 +11,47 @@
 /// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 /// SOFTWARE.
 ///
+
+#include <cassert>
+
+template <ED3D11Resc EValue>
+DD3D11Handle<EValue>::DD3D11Handle(const DSlotKey& validKey) noexcept
+{ 
+  // Invalid key (generation 0) must be null handle, or default key would be packed into non-zero value.
+  assert(validKey.mGeneration != 0);
+  if (validKey.mGeneration == 0) { return; }
+
+  this->mPacked = (static_cast<uint64_t>(validKey.mGeneration) << 32) | validKey.mIndex;
+}
+
+template <ED3D11Resc EValue>
+bool DD3D11Handle<EValue>::IsValid() const noexcept
+{
+  return this->mPacked != 0;
+}
+
+template <ED3D11Resc EValue>
+DSlotKey DD3D11Handle<EValue>::GetKey() const noexcept
+{
+  return DSlotKey{
+    static_cast<uint32_t>(this->mPacked & 0xFFFFFFFF),
+    static_cast<uint32_t>(this->mPacked >> 32)};
+}
+
+template <ED3D11Resc EValue>
+uint64_t DD3D11Handle<EValue>::GetPacked() const noexcept
+{
+  return this->mPacked;
+}
+
+template <ED3D11Resc EValue>
+bool operator==(const DD3D11Handle<EValue>& lhs, const DD3D11Handle<EValue>& rhs) noexcept
+{
+  return lhs.GetPacked() == rhs.GetPacked();
+}
+
+template <ED3D11Resc EValue>
+bool operator!=(const DD3D11Handle<EValue>& lhs, const DD3D11Handle<EValue>& rhs) noexcept
+{
+  return lhs.GetPacked() != rhs.GetPacked();
+}
@@ -0,0 +1,43 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+inline void FMockCommandLog::Record(EMockD3D11Call call, uint32_t arg0, uint32_t arg1, uint32_t arg2)
+{
+  this->mCounts[static_cast<size_t>(call)] += 1;
+
+  switch (call)
+  {
+  case EMockD3D11Call::Draw: 
+  case EMockD3D11Call::DrawIndexed: 
+  {
+    this->mVertexCount += arg0;
+  } break;
+  case EMockD3D11Call::DrawInstanced:
+  case EMockD3D11Call::DrawIndexedInstanced:
+  {
+    this->mVertexCount += uint64_t(arg0) * arg1;
+  } break;
+  default: break;
+  }
+
+  if (this->mIsRecording == true)
+  {
+    this->mCommands.push_back(DMockCommand{call, arg0, arg1, arg2});
+  }
+}
+
+inline void FMockCommandLog::AddUploadedBytes(uint64_t bytes) noexcept
+{
+  this->mUploadedBytes += bytes;
+}
@@ -12,24 +12,34 @@
 /// SOFTWARE.
 ///
 
-template <typename TType>
-IComBorrow<TType>::IComBorrow(__IComOwner<TType>& comOwner)
+template <typename TType, typename TPolicy>
+IComBorrow<TType, TPolicy>::IComBorrow(__IComOwner<TType>& comOwner)
   : mPtrCom{&comOwner}
 {
-  this->mPtrCom->mCounter.syncPush(*this);
+  this->mPtrCom->mCounter.syncPush();
 };
 
-template <typename TType>
-IComBorrow<TType>::~IComBorrow()
+template <typename TType, typename TPolicy>
+IComBorrow<TType, TPolicy>::~IComBorrow()
 {
-  if (this->mPtrCom != nullptr)
-  {
-    this->mPtrCom->mCounter.syncPop(*this);
-  }
+  this->TryReleaseSelf();
+}
+
+template <typename TType, typename TPolicy>
+bool IComBorrow<TType, TPolicy>::IsValid() const noexcept
+{
+  return this->mPtrCom != nullptr 
+      && this->mPtrCom->mCounter.syncIsOwnerAlive() == true;
 }
 
-template <typename TType>
-bool IComBorrow<TType>::IsValid() const noexcept
+template <typename TType, typename TPolicy>
+void IComBorrow<TType, TPolicy>::TryReleaseSelf() noexcept
 {
-  return this->mPtrCom != nullptr;
+  if (this->mPtrCom == nullptr) { return; }
+
+  if (this->mPtrCom->mCounter.syncPop() == true)
+  {
+    delete this->mPtrCom;
+  }
+  this->mPtrCom = nullptr;
 }
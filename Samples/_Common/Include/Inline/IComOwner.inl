@@ -15,105 +15,111 @@
 #include <cassert>
 #include <ComWrapper/IComBorrow.h>
 
-template <typename TType>
-IComOwner<TType>::IComOwner(std::nullptr_t) { }
+template <typename TType, typename TPolicy>
+IComOwner<TType, TPolicy>::IComOwner(std::nullptr_t) { }
 
-template <typename TType>
-IComOwner<TType>::IComOwner(TType* pCOMInstance)
+template <typename TType, typename TPolicy>
+IComOwner<TType, TPolicy>::IComOwner(TType* pCOMInstance)
   : mObj{new __IComOwner<TType>(pCOMInstance)}
 { };
 
-template <typename TType>
-IComOwner<TType>::IComOwner(IComOwner&& movedOwner) noexcept
+template <typename TType, typename TPolicy>
+IComOwner<TType, TPolicy>::IComOwner(IComOwner&& movedOwner) noexcept
   : mObj{movedOwner.mObj}
 {
   movedOwner.mObj = nullptr;
 }
 
-template <typename TType>
-IComOwner<TType>& IComOwner<TType>::operator=(IComOwner&& movedOwner) noexcept
+template <typename TType, typename TPolicy>
+IComOwner<TType, TPolicy>& IComOwner<TType, TPolicy>::operator=(IComOwner&& movedOwner) noexcept
 {
   if (this == &movedOwner) { return *this; }
   
   // Release old one.
-  if (this->mObj != nullptr)
-  {
-    TryReleaseSelf();
-    delete this->mObj;
-    this->mObj = nullptr;
-  }
+  this->TryReleaseSelf();
 
   this->mObj = movedOwner.mObj;
   movedOwner.mObj = nullptr;
   return *this;
 }
 
-template <typename TType>
-IComOwner<TType>::~IComOwner()
+template <typename TType, typename TPolicy>
+IComOwner<TType, TPolicy>::~IComOwner()
 {
   assert(this->mObj == nullptr 
       || this->mObj->mCounter.syncGetCounter() == 0);
   TryReleaseSelf();
 }
 
-template <typename TType>
-bool IComOwner<TType>::IsValid() const noexcept
+template <typename TType, typename TPolicy>
+bool IComOwner<TType, TPolicy>::IsValid() const noexcept
 {
   return this->mObj != nullptr;
 }
 
-template <typename TType>
-IComBorrow<TType> IComOwner<TType>::GetBorrow() noexcept
+template <typename TType, typename TPolicy>
+IComBorrow<TType, TPolicy> IComOwner<TType, TPolicy>::GetBorrow() noexcept
 {
   assert(this->mObj != nullptr);
-  return IComBorrow<TType>(*this->mObj);
+  return IComBorrow<TType, TPolicy>(*this->mObj);
 }
 
-template <typename TType>
-TType* IComOwner<TType>::GetPtr() noexcept
+template <typename TType, typename TPolicy>
+TType* IComOwner<TType, TPolicy>::GetPtr() noexcept
 {
   assert(this->mObj != nullptr);
   return this->mObj->mPtrOwner;
 }
 
 #if 0
-template <typename TType>
-TType** IComOwner<TType>::GetAddressOf() noexcept
+template <typename TType, typename TPolicy>
+TType** IComOwner<TType, TPolicy>::GetAddressOf() noexcept
 {
   assert(this->mObj != nullptr);
   return &this->mPtrOwner;
 }
 #endif
 
-template <typename TType>
-TType& IComOwner<TType>::operator*()
+template <typename TType, typename TPolicy>
+TType& IComOwner<TType, TPolicy>::operator*()
 {
   assert(this->mObj != nullptr);
   return *this->mObj->mPtrOwner;
 }
 
-template <typename TType>
-TType* IComOwner<TType>::operator->()
+template <typename TType, typename TPolicy>
+TType* IComOwner<TType, TPolicy>::operator->()
 {
   assert(this->mObj != nullptr);
   return this->mObj->mPtrOwner;
 }
 
-template <typename TType>
-void IComOwner<TType>::Release()
+template <typename TType, typename TPolicy>
+void IComOwner<TType, TPolicy>::Release()
 {
   this->TryReleaseSelf();
 }
 
-template <typename TType>
-void IComOwner<TType>::TryReleaseSelf()
+template <typename TType, typename TPolicy>
+void IComOwner<TType, TPolicy>::TryReleaseSelf()
 {
   if (this->mObj == nullptr) { return; }
 
-  if (this->mObj != nullptr)
+  // Release COM instance and notify borrows that owner is released.
+  // Control block is deleted by the last one of owner and borrows.
+  this->mObj->mPtrOwner->Release();
+  this->mObj->mPtrOwner = nullptr;
+  this->mObj->mCounter.syncInvalidate();
+  if (this->mObj->mCounter.syncPop() == true)
   {
-    this->mObj->mPtrOwner->Release();
     delete this->mObj;
-    this->mObj = nullptr;
   }
+  this->mObj = nullptr;
+}
+
+template <typename TType>
+IComBorrow<TType, XComUnchecked> IComOwner<TType, XComUnchecked>::GetBorrow() noexcept
+{
+  assert(this->mPtrOwner != nullptr);
+  return IComBorrow<TType, XComUnchecked>(this->mPtrOwner);
 }
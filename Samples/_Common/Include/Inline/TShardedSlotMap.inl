@@ -0,0 +1,96 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+template <typename TValue, uint32_t TShardCount>
+template <typename... TArgs>
+DSlotKey TShardedSlotMap<TValue, TShardCount>::Emplace(TArgs&&... args)
+{
+  const auto shardIndex = TShardedSlotMap::GetThreadShardIndex();
+  auto& shard = this->mShards[shardIndex];
+
+  DSlotKey localKey;
+  {
+    std::unique_lock<TLock> lock{shard.mLock};
+    localKey = shard.mContainer.Emplace(std::forward<TArgs>(args)...);
+  }
+
+  assert(localKey.mIndex < DSlotKey::kInvalidIndex / TShardCount);
+  return DSlotKey{localKey.mIndex * TShardCount + shardIndex, localKey.mGeneration};
+}
+
+template <typename TValue, uint32_t TShardCount>
+bool TShardedSlotMap<TValue, TShardCount>::Has(const DSlotKey& key) const
+{
+  if (key.mGeneration == 0) { return false; }
+
+  const auto& shard = this->mShards[key.mIndex % TShardCount];
+  std::shared_lock<TLock> lock{shard.mLock};
+  return shard.mContainer.Has(TShardedSlotMap::ToLocalKey(key));
+}
+
+template <typename TValue, uint32_t TShardCount>
+template <typename TFunction>
+decltype(auto) TShardedSlotMap<TValue, TShardCount>::Visit(const DSlotKey& key, TFunction&& function)
+{
+  auto& shard = this->mShards[key.mIndex % TShardCount];
+  std::shared_lock<TLock> lock{shard.mLock};
+
+  auto* pValue = shard.mContainer.TryGet(TShardedSlotMap::ToLocalKey(key));
+  if (pValue == nullptr) { throw std::out_of_range("Slot key is stale or invalid."); }
+  return function(*pValue);
+}
+
+template <typename TValue, uint32_t TShardCount>
+bool TShardedSlotMap<TValue, TShardCount>::Remove(const DSlotKey& key)
+{
+  if (key.mGeneration == 0) { return false; }
+
+  auto& shard = this->mShards[key.mIndex % TShardCount];
+  std::unique_lock<TLock> lock{shard.mLock};
+  return shard.mContainer.Remove(TShardedSlotMap::ToLocalKey(key));
+}
+
+template <typename TValue, uint32_t TShardCount>
+std::size_t TShardedSlotMap<TValue, TShardCount>::Size() const
+{
+  std::size_t size = 0;
+  for (const auto& shard : this->mShards)
+  {
+    std::shared_lock<TLock> lock{shard.mLock};
+    size += shard.mContainer.Size();
+  }
+  return size;
+}
+
+template <typename TValue, uint32_t TShardCount>
+uint32_t TShardedSlotMap<TValue, TShardCount>::GetThreadShardIndex() noexcept
+{
+  if constexpr (TShardCount == 1) { return 0; }
+  else
+  {
+    thread_local const auto shardIndex = static_cast<uint32_t>(
+      std::hash<std::thread::id>{}(std::this_thread::get_id()) % TShardCount);
+    return shardIndex;
+  }
+}
+
+template <typename TValue, uint32_t TShardCount>
+DSlotKey TShardedSlotMap<TValue, TShardCount>::ToLocalKey(const DSlotKey& key) noexcept
+{
+  return DSlotKey{key.mIndex / TShardCount, key.mGeneration};
+}
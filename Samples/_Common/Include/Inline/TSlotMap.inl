@@ -0,0 +1,123 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cassert>
+#include <utility>
+
+template <typename TValue>
+template <typename... TArgs>
+DSlotKey TSlotMap<TValue>::Emplace(TArgs&&... args)
+{
+  // Get free slot. If not exist, append new slot.
+  uint32_t slotIndex = this->mFreeHead;
+  if (slotIndex != DSlotKey::kInvalidIndex)
+  {
+    this->mFreeHead = this->mSlots[slotIndex].mValueIndex;
+  }
+  else
+  {
+    slotIndex = static_cast<uint32_t>(this->mSlots.size());
+    assert(slotIndex != DSlotKey::kInvalidIndex);
+    this->mSlots.emplace_back();
+  }
+
+  // Insert value.
+  this->mValues.emplace_back(std::forward<TArgs>(args)...);
+  this->mValueSlots.emplace_back(slotIndex);
+
+  auto& slot = this->mSlots[slotIndex];
+  slot.mValueIndex = static_cast<uint32_t>(this->mValues.size() - 1);
+  return DSlotKey{slotIndex, slot.mGeneration};
+}
+
+template <typename TValue>
+bool TSlotMap<TValue>::Has(const DSlotKey& key) const noexcept
+{
+  if (key.mIndex >= this->mSlots.size()) { return false; }
+  return this->mSlots[key.mIndex].mGeneration == key.mGeneration;
+}
+
+template <typename TValue>
+TValue& TSlotMap<TValue>::Get(const DSlotKey& key)
+{
+  assert(this->Has(key) == true);
+  return this->mValues[this->mSlots[key.mIndex].mValueIndex];
+}
+
+template <typename TValue>
+const TValue& TSlotMap<TValue>::Get(const DSlotKey& key) const
+{
+  assert(this->Has(key) == true);
+  return this->mValues[this->mSlots[key.mIndex].mValueIndex];
+}
+
+template <typename TValue>
+TValue* TSlotMap<TValue>::TryGet(const DSlotKey& key) noexcept
+{
+  if (this->Has(key) == false) { return nullptr; }
+  return &this->mValues[this->mSlots[key.mIndex].mValueIndex];
+}
+
+template <typename TValue>
+bool TSlotMap<TValue>::Remove(const DSlotKey& key)
+{
+  // Validation check.
+  if (this->Has(key) == false) { return false; }
+
+  // Move last value into removed place, and update slot of moved value.
+  const uint32_t valueIndex = this->mSlots[key.mIndex].mValueIndex;
+  const uint32_t lastIndex  = static_cast<uint32_t>(this->mValues.size() - 1);
+  if (valueIndex != lastIndex)
+  {
+    this->mValues[valueIndex] = std::move(this->mValues[lastIndex]);
+    this->mValueSlots[valueIndex] = this->mValueSlots[lastIndex];
+    this->mSlots[this->mValueSlots[valueIndex]].mValueIndex = valueIndex;
+  }
+  this->mValues.pop_back();
+  this->mValueSlots.pop_back();
+
+  this->ReleaseSlot(key.mIndex);
+  return true;
+}
+
+template <typename TValue>
+void TSlotMap<TValue>::Clear()
+{
+  for (const auto slotIndex : this->mValueSlots)
+  {
+    this->ReleaseSlot(slotIndex);
+  }
+
+  this->mValues.clear();
+  this->mValueSlots.clear();
+}
+
+template <typename TValue>
+std::size_t TSlotMap<TValue>::Size() const noexcept
+{
+  return this->mValues.size();
+}
+
+template <typename TValue>
+void TSlotMap<TValue>::ReleaseSlot(uint32_t slotIndex) noexcept
+{
+  auto& slot = this->mSlots[slotIndex];
+
+  // Generation 0 is reserved for invalid key, so skip it when wrapped.
+  slot.mGeneration += 1;
+  if (slot.mGeneration == 0) { slot.mGeneration = 1; }
+
+  slot.mValueIndex = this->mFreeHead;
+  this->mFreeHead = slotIndex;
+}
@@ -0,0 +1,37 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+template <typename TType, std::size_t TCapacity>
+bool TSpscRingBuffer<TType, TCapacity>::TryPush(const TType& value) noexcept
+{
+  const auto head = this->mHead.load(std::memory_order_relaxed);
+  const auto tail = this->mTail.load(std::memory_order_acquire);
+  if (head - tail == TCapacity) { return false; }
+
+  this->mValues[head & kMask] = value;
+  this->mHead.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename TType, std::size_t TCapacity>
+bool TSpscRingBuffer<TType, TCapacity>::TryPop(TType& outValue) noexcept
+{
+  const auto tail = this->mTail.load(std::memory_order_relaxed);
+  const auto head = this->mHead.load(std::memory_order_acquire);
+  if (tail == head) { return false; }
+
+  outValue = this->mValues[tail & kMask];
+  this->mTail.store(tail + 1, std::memory_order_release);
+  return true;
+}
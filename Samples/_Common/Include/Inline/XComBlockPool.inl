@@ -0,0 +1,74 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <new>
+
+template <typename TBlock>
+void* XComBlockPool<TBlock>::Allocate()
+{
+  auto& state = XComBlockPool::GetState();
+  std::lock_guard<std::mutex> lock(state.mMutex);
+
+  // If there is no free slot, allocate new chunk and link all slots of chunk into free list.
+  if (state.mPtrFreeHead == nullptr)
+  {
+    auto* pChunk = static_cast<DSlot*>(::operator new(sizeof(DSlot) * kChunkBlockCount));
+    for (std::size_t i = 0; i < kChunkBlockCount - 1; ++i)
+    {
+      pChunk[i].mPtrNext = &pChunk[i + 1];
+    }
+    pChunk[kChunkBlockCount - 1].mPtrNext = nullptr;
+
+    state.mChunks.emplace_back(pChunk);
+    state.mPtrFreeHead = pChunk;
+    state.mStatistics.mChunkAllocations += 1;
+    sTotalChunkAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  DSlot* pSlot = state.mPtrFreeHead;
+  state.mPtrFreeHead = pSlot->mPtrNext;
+  state.mStatistics.mBlockAllocations += 1;
+  sTotalBlockAllocations.fetch_add(1, std::memory_order_relaxed);
+  return pSlot->mStorage;
+}
+
+template <typename TBlock>
+void XComBlockPool<TBlock>::Deallocate(void* pBlock) noexcept
+{
+  if (pBlock == nullptr) { return; }
+
+  auto& state = XComBlockPool::GetState();
+  std::lock_guard<std::mutex> lock(state.mMutex);
+
+  auto* pSlot = static_cast<DSlot*>(pBlock);
+  pSlot->mPtrNext = state.mPtrFreeHead;
+  state.mPtrFreeHead = pSlot;
+  state.mStatistics.mBlockDeallocations += 1;
+  sTotalBlockDeallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename TBlock>
+DComPoolStatistics XComBlockPool<TBlock>::GetStatistics()
+{
+  auto& state = XComBlockPool::GetState();
+  std::lock_guard<std::mutex> lock(state.mMutex);
+  return state.mStatistics;
+}
+
+template <typename TBlock>
+typename XComBlockPool<TBlock>::DState& XComBlockPool<TBlock>::GetState()
+{
+  static DState* pState = new DState();
+  return *pState;
+}
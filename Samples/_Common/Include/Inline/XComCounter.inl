@@ -12,13 +12,39 @@
 /// SOFTWARE.
 ///
 
-#include <ComWrapper/IComBorrow.h>
+#include <cassert>
 
 template <typename TType>
-XComCounter<TType>::~XComCounter()
+void XComCounter<TType>::syncPush() noexcept
 {
-  for (auto& borrow : this->mBorrows)
-  {
-    borrow->mPtrCom = nullptr;
-  }
+  // Caller already has a reference, so relaxed ordering is enough.
+  [[maybe_unused]] const auto previous = this->mCounter.fetch_add(1, std::memory_order_relaxed);
+  assert(previous > 0);
+}
+
+template <typename TType>
+bool XComCounter<TType>::syncPop() noexcept
+{
+  [[maybe_unused]] const auto previous = this->mCounter.fetch_sub(1, std::memory_order_acq_rel);
+  assert(previous > 0);
+  return previous == 1;
+}
+
+template <typename TType>
+void XComCounter<TType>::syncInvalidate() noexcept
+{
+  this->mIsOwnerAlive.store(false, std::memory_order_release);
+}
+
+template <typename TType>
+bool XComCounter<TType>::syncIsOwnerAlive() const noexcept
+{
+  return this->mIsOwnerAlive.load(std::memory_order_acquire);
+}
+
+template <typename TType>
+uint32_t XComCounter<TType>::syncGetCounter() const noexcept
+{
+  const auto counter = this->mCounter.load(std::memory_order_acquire);
+  return this->syncIsOwnerAlive() == true ? counter - 1 : counter;
 }
@@ -0,0 +1,46 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#if PROFILING_TSC_TIMER == 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+inline XCpuClock::TTicks XCpuClock::Now() noexcept
+{
+#if PROFILING_TSC_TIMER == 1
+  static const bool isUsingTsc = GetCalibration().mIsUsingTsc;
+  if (isUsingTsc == true) { return ReadTsc(); }
+#endif
+  return ReadSteadyClock();
+}
+
+inline XCpuClock::TTicks XCpuClock::ReadTsc() noexcept
+{
+#if PROFILING_TSC_TIMER == 1
+  // rdtscp waits until previous instructions are executed, so scope does not begin too early.
+  unsigned int processorId = 0;
+  return __rdtscp(&processorId);
+#else
+  return ReadSteadyClock();
+#endif
+}
+
+inline XCpuClock::TTicks XCpuClock::ReadSteadyClock() noexcept
+{
+  return TTicks(std::chrono::steady_clock::now().time_since_epoch().count());
+}
@@ -0,0 +1,73 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdint>
+
+/// @enum EMockD3D11Call
+/// @brief Recorded call types of mock D3D11 device and immediate context.
+/// Object arguments are recorded as mock object id, which starts from 1. (0 is nullptr)
+enum class EMockD3D11Call : uint16_t
+{
+  // Device
+  CreateBuffer,           // (Id, ByteWidth, BindFlags)
+  CreateTexture2D,        // (Id, Width, Height)
+  CreateRenderTargetView, // (Id, Resource Id)
+  CreateDepthStencilView, // (Id, Resource Id)
+  CreateInputLayout,      // (Id, NumElements)
+  CreateVertexShader,     // (Id, BytecodeLength)
+  CreatePixelShader,      // (Id, BytecodeLength)
+  CreateBlendState,       // (Id)
+  CreateDepthStencilState,// (Id)
+  CreateRasterizerState,  // (Id)
+  CreateSamplerState,     // (Id)
+  CreateQuery,            // (Id, D3D11_QUERY)
+  // Immediate context
+  IASetInputLayout,       // (Input layout Id)
+  IASetVertexBuffers,     // (StartSlot, NumBuffers, First buffer Id)
+  IASetIndexBuffer,       // (Buffer Id, DXGI_FORMAT, Offset)
+  IASetPrimitiveTopology, // (D3D11_PRIMITIVE_TOPOLOGY)
+  VSSetShader,            // (Shader Id)
+  VSSetConstantBuffers,   // (StartSlot, NumBuffers, First buffer Id)
+  PSSetShader,            // (Shader Id)
+  PSSetConstantBuffers,   // (StartSlot, NumBuffers, First buffer Id)
+  PSSetShaderResources,   // (StartSlot, NumViews)
+  PSSetSamplers,          // (StartSlot, NumSamplers, First sampler Id)
+  RSSetState,             // (Rasterizer state Id)
+  RSSetViewports,         // (NumViewports)
+  RSSetScissorRects,      // (NumRects)
+  OMSetRenderTargets,     // (NumViews, First RTV Id, DSV Id)
+  OMSetBlendState,        // (Blend state Id, SampleMask)
+  OMSetDepthStencilState, // (Depth stencil state Id, StencilRef)
+  ClearRenderTargetView,  // (RTV Id)
+  ClearDepthStencilView,  // (DSV Id, ClearFlags)
+  UpdateSubresource,      // (Resource Id, Subresource, Copied bytes)
+  Map,                    // (Resource Id, Subresource, D3D11_MAP)
+  Unmap,                  // (Resource Id, Subresource)
+  CopyResource,           // (Dest Id, Source Id, Copied bytes)
+  Draw,                   // (VertexCount, StartVertexLocation)
+  DrawIndexed,            // (IndexCount, StartIndexLocation, BaseVertexLocation)
+  DrawInstanced,          // (VertexCountPerInstance, InstanceCount, StartVertexLocation)
+  DrawIndexedInstanced,   // (IndexCountPerInstance, InstanceCount, StartIndexLocation)
+  Begin,                  // (Query Id)
+  End,                    // (Query Id)
+  GetData,                // (Query Id, Result HRESULT)
+  ClearState,             // ()
+  Flush,                  // ()
+  // Miscellaneous
+  Unsupported,            // (), Call which is not supported by mock and ignored.
+  __Sum
+};
+
+/// @brief Get string name of given call type.
+const char* ToString(EMockD3D11Call call) noexcept;
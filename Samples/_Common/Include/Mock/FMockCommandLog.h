@@ -0,0 +1,78 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <Mock/EMockD3D11Call.h>
+
+/// @struct DMockCommand
+/// @brief Compact recorded command of mock D3D11. Meaning of arguments is up to call type.
+struct DMockCommand final
+{
+  EMockD3D11Call mCall = EMockD3D11Call::Unsupported;
+  uint32_t mArg0 = 0;
+  uint32_t mArg1 = 0;
+  uint32_t mArg2 = 0;
+};
+
+/// @class FMockCommandLog
+/// @brief Command log of mock D3D11 device or immediate context. 
+/// This type is not thread-safe, as like as D3D11 immediate context.
+class FMockCommandLog final
+{
+public:
+  /// @brief Record call. When recording is disabled, only statistics are accumulated.
+  void Record(EMockD3D11Call call, uint32_t arg0 = 0, uint32_t arg1 = 0, uint32_t arg2 = 0);
+
+  /// @brief Add uploaded bytes by UpdateSubresource, Map or resource creation.
+  void AddUploadedBytes(uint64_t bytes) noexcept;
+
+  /// @brief Enable or disable keeping commands. (Default is true)
+  /// Disable this for long soak tests, not to grow log infinitely.
+  void SetRecording(bool isRecording) noexcept;
+
+  /// @brief Clear all commands and statistics.
+  void Clear() noexcept;
+
+  /// @brief Get recorded commands.
+  const std::vector<DMockCommand>& GetCommands() const noexcept;
+
+  /// @brief Get called count of given call type.
+  uint64_t GetCount(EMockD3D11Call call) const noexcept;
+
+  /// @brief Get the number of all draw calls. (Draw, DrawIndexed, Draw*Instanced)
+  uint64_t GetDrawCallCount() const noexcept;
+
+  /// @brief Get the number of submitted vertices or indices of draw calls.
+  uint64_t GetDrawnPrimitiveVertexCount() const noexcept;
+
+  /// @brief Get total uploaded bytes.
+  uint64_t GetUploadedBytes() const noexcept;
+
+  /// @brief Get summary string of called counts. Call types which are not called are skipped.
+  std::string GetSummary() const;
+
+private:
+  static constexpr size_t kCallCount = static_cast<size_t>(EMockD3D11Call::__Sum);
+
+  std::vector<DMockCommand> mCommands;
+  std::array<uint64_t, kCallCount> mCounts = {};
+  uint64_t mVertexCount = 0;
+  uint64_t mUploadedBytes = 0;
+  bool mIsRecording = true;
+};
+
+#include <Inline/FMockCommandLog.inl>
@@ -0,0 +1,49 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdint>
+#include <d3d11.h>
+
+class FMockCommandLog;
+
+/// @struct PMockD3D11Descriptor
+/// @brief Descriptor of mock D3D11 device.
+struct PMockD3D11Descriptor final
+{
+  /// @brief The number of Flush() calls of immediate context after query was ended, 
+  /// until result of query is available. If 0, query is completed immediately when ended.
+  /// Call Flush() once per frame to simulate GPU running this many frames behind CPU.
+  uint32_t mQueryLatency = 0;
+};
+
+/// @class FMockD3D11Factory
+/// @brief Factory class for creating recording mock D3D11 device, which does not use GPU.
+/// Mock supports the subset used by samples (buffers, textures, views, shaders, states, queries,
+/// UpdateSubresource, Map and Draw*), keeps CPU-side storage of buffers and textures,
+/// and records calls into command logs, so CPU cost of submission path can be measured.
+/// Other calls return E_NOTIMPL or are ignored, and recorded as EMockD3D11Call::Unsupported.
+class FMockD3D11Factory final
+{
+public:
+  /// @brief Create mock device and immediate context.
+  /// Device can be used from multiple threads, so device calls are recorded into deviceLog with lock.
+  /// Immediate context calls are recorded into contextLog without lock.
+  /// Given logs must be alive until device and context are released.
+  static HRESULT CreateDevice(
+    FMockCommandLog& deviceLog, 
+    FMockCommandLog& contextLog,
+    ID3D11Device** ppDevice,
+    ID3D11DeviceContext** ppContext,
+    const PMockD3D11Descriptor& desc = {});
+};
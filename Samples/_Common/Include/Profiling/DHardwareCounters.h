@@ -0,0 +1,63 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdint>
+
+/// @def PROFILING_HARDWARE_COUNTERS
+/// @brief If 1, hardware counters (cycles, instructions, cache misses, branch misses) are read 
+/// with perf_event_open at the begin and end of each CPU profiling scope. Linux only.
+/// Reading counters costs system call per scope boundary, so this is 0 by default.
+/// Enable with CMake option of same name.
+#ifndef PROFILING_HARDWARE_COUNTERS
+#define PROFILING_HARDWARE_COUNTERS 0
+#endif
+
+#if PROFILING_HARDWARE_COUNTERS == 1 && !defined(__linux__)
+#undef PROFILING_HARDWARE_COUNTERS
+#define PROFILING_HARDWARE_COUNTERS 0
+#endif
+
+/// @struct DHardwareCounters
+/// @brief Hardware counter values of user-space execution.
+struct DHardwareCounters final
+{
+  uint64_t mCycles = 0;
+  uint64_t mInstructions = 0;
+  /// @brief Last level cache misses.
+  uint64_t mCacheMisses = 0;
+  uint64_t mBranchMisses = 0;
+
+  DHardwareCounters& operator+=(const DHardwareCounters& rhs) noexcept
+  {
+    this->mCycles       += rhs.mCycles;
+    this->mInstructions += rhs.mInstructions;
+    this->mCacheMisses  += rhs.mCacheMisses;
+    this->mBranchMisses += rhs.mBranchMisses;
+    return *this;
+  }
+
+  DHardwareCounters& operator-=(const DHardwareCounters& rhs) noexcept
+  {
+    this->mCycles       -= rhs.mCycles;
+    this->mInstructions -= rhs.mInstructions;
+    this->mCacheMisses  -= rhs.mCacheMisses;
+    this->mBranchMisses -= rhs.mBranchMisses;
+    return *this;
+  }
+};
+
+inline DHardwareCounters operator-(DHardwareCounters lhs, const DHardwareCounters& rhs) noexcept
+{
+  return lhs -= rhs;
+}
@@ -0,0 +1,89 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/// @struct DProfileScopeNode
+/// @brief Node of profiling scope tree. 
+/// Scopes which have same name and same parent are merged into one node.
+struct DProfileScopeNode final
+{
+  using TTimeStamp = std::chrono::duration<double>;
+
+  /// @brief Name of scope.
+  std::string mName;
+  /// @brief Index of parent node. If root, DProfileScopeTree::kNone.
+  std::size_t mParent = std::numeric_limits<std::size_t>::max();
+  /// @brief Indices of child nodes in insertion order.
+  std::vector<std::size_t> mChildren;
+  /// @brief Total elapsed time of scope including children.
+  TTimeStamp mTotal = TTimeStamp{0};
+  /// @brief Elapsed time of scope excluding children.
+  TTimeStamp mSelf = TTimeStamp{0};
+  /// @brief The number of entering scope.
+  uint32_t mCallCount = 0;
+  /// @brief Interned tag id of scope. If scope is not tagged, DProfileScopeTree::kNoTag.
+  uint32_t mTagId = std::numeric_limits<uint32_t>::max();
+};
+
+/// @class DProfileScopeTree
+/// @brief Call tree of profiling scopes of one frame.
+class DProfileScopeTree final
+{
+public:
+  static constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+  static constexpr uint32_t kNoTag = std::numeric_limits<uint32_t>::max();
+
+  /// @brief Find child node of parent that has given name. If not exist, create new node.
+  /// @param parent Parent node index. If kNone, find root node.
+  /// @return Index of node.
+  std::size_t FindOrInsert(const std::string& name, std::size_t parent);
+
+  /// @brief Find child node of parent that has given interned tag id. If not exist, create new node.
+  /// Siblings are compared by tag id, so name is only copied when new node is created.
+  /// @return Index of node.
+  std::size_t FindOrInsert(uint32_t tagId, const std::string& name, std::size_t parent);
+
+  /// @brief Add elapsed time of one call to node.
+  void AddTime(std::size_t index, const DProfileScopeNode::TTimeStamp& elapsedTime);
+
+  /// @brief Calculate self time of all nodes. (Total - Sum of children totals)
+  void CalculateSelfTimes();
+
+  /// @brief Remove all nodes.
+  void Clear() noexcept;
+
+  /// @brief Get node of index.
+  [[nodiscard]] const DProfileScopeNode& operator[](std::size_t index) const noexcept;
+
+  /// @brief Get all nodes.
+  [[nodiscard]] const std::vector<DProfileScopeNode>& GetNodes() const noexcept;
+
+  /// @brief Get root node indices.
+  [[nodiscard]] const std::vector<std::size_t>& GetRoots() const noexcept;
+
+  /// @brief Get sum of total time of root nodes.
+  [[nodiscard]] DProfileScopeNode::TTimeStamp GetTotal() const noexcept;
+
+private:
+  /// @brief Create new child node of parent.
+  std::size_t Insert(uint32_t tagId, const std::string& name, std::size_t parent);
+
+  std::vector<DProfileScopeNode> mNodes;
+  std::vector<std::size_t> mRoots;
+};
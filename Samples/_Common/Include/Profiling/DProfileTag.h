@@ -0,0 +1,29 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdint>
+#include <string>
+
+/// @struct DProfileTag
+/// @brief Interned profiling tag. 
+/// Tag name is registered into MTimeChecker only once when tag is created, 
+/// so checking time with tag does not hash or allocate string.
+/// Tag is intended to be a static object of call site. (See TIME_CHECK_CPU)
+struct DProfileTag final
+{
+  explicit DProfileTag(const std::string& tagName);
+
+  /// @brief Interned id of tag name.
+  uint32_t mId;
+};
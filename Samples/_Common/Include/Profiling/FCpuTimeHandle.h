@@ -12,14 +12,15 @@
 /// SOFTWARE.
 ///
 
-#include <chrono>
-
-class FTimeContainer;
+#include <cstdint>
+#include <Profiling/DHardwareCounters.h>
+#include <Profiling/XCpuClock.h>
 
 class FCpuTimeHandle final
 {
 public:
-  FCpuTimeHandle(FTimeContainer& container);
+  /// @brief Begin CPU scope of interned tag id, which has given depth in thread.
+  FCpuTimeHandle(uint32_t tagId, uint32_t depth);
   ~FCpuTimeHandle();
 
   FCpuTimeHandle(const FCpuTimeHandle&) = delete;
@@ -30,9 +31,10 @@ public:
 
 private:
   bool mIsMoved = false;
-  FTimeContainer& mContainer;
-
-  using TStamp = decltype(std::chrono::steady_clock::now());
-  TStamp mStart;
-  TStamp mEnd;
+  uint32_t mTagId = 0;
+  uint32_t mDepth = 0;
+  XCpuClock::TTicks mStart = 0;
+#if PROFILING_HARDWARE_COUNTERS == 1
+  DHardwareCounters mStartCounters;
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <Profiling/FD3D11TimeContainer.h>
+#include <Resource/DD3D11Handle.h>
+
+struct ID3D11Query;
+
+/// @class FD3D11QueryPool
+/// @brief Pool of disjoint and timestamp queries for one GPU time tag.
+/// Pool has query set for each in-flight frame, and each set has disjoint query 
+/// and start/end timestamp query pair of each fragment name that is created on first use.
+/// Sets are used in round-robin, so no query is issued again before its frame is resolved or dropped.
+class FD3D11QueryPool final
+{
+public:
+  /// @brief The number of query sets. Same as the number of in-flight frames.
+  static constexpr std::size_t kSetCount = FD3D11TimeContainer::kMaxInFlightFrames;
+
+  FD3D11QueryPool(const D11HandleDevice& hDevice);
+  ~FD3D11QueryPool();
+
+  FD3D11QueryPool(const FD3D11QueryPool&) = delete;
+  FD3D11QueryPool& operator=(const FD3D11QueryPool&) = delete;
+
+  /// @brief Move to next query set and return disjoint query of the set.
+  ID3D11Query& NextFrame();
+
+  /// @brief Get start and end timestamp queries of fragment name in current set.
+  std::pair<ID3D11Query*, ID3D11Query*> GetFragmentQueries(const std::string& fragmentName);
+
+  /// @brief Remove all queries from MD3D11Resources.
+  void Release();
+
+private:
+  /// @struct DQuery
+  /// @brief Handle of pooled query and its cached pointer.
+  struct DQuery final
+  {
+    D11HandleQuery mHandle = nullptr;
+    ID3D11Query* mPtr = nullptr;
+  };
+
+  /// @struct DQuerySet
+  /// @brief Queries of one in-flight frame.
+  struct DQuerySet final
+  {
+    DQuery mDisjoint;
+    std::unordered_map<std::string, std::pair<DQuery, DQuery>> mFragments;
+  };
+
+  /// @brief Create query of given type from device.
+  DQuery CreateQuery(bool isDisjoint);
+
+  D11HandleDevice mDevice = nullptr;
+  std::array<DQuerySet, kSetCount> mSets;
+  std::size_t mSetIndex = kSetCount - 1;
+};
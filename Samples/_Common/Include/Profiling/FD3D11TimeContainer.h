@@ -13,8 +13,13 @@
 ///
 
 #include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
 #include <vector>
 
+#include <Profiling/DProfileScopeTree.h>
 #include <Profiling/FD3D11TimeHandle.h>
 #include <Profiling/FTimeContainer.h>
 
@@ -26,6 +31,9 @@ using TTimeStamp = std::chrono::duration<double>;
 class FD3D11TimeContainer final
 {
 public:
+  /// @brief Name is used as track name of trace capture.
+  explicit FD3D11TimeContainer(const std::string& name = "GPU");
+
   /// @brief
   const FTimeContainer& operator[](const std::string& fragmentName) const noexcept;
 
@@ -33,9 +41,72 @@ public:
   [[nodiscard]] bool HasFragment(const std::string& fragmentName) const noexcept;
 
   /// @brief Insert new elapsed time stamp into list.
-  void Insert(const FD3D11TimeHandle::TTimeStamps& elapsedTimes);
+  /// If parents of fragments are given, scope tree is also rebuilt with elapsed times.
+  void Insert(
+    const FD3D11TimeHandle::TTimeStamps& elapsedTimes, 
+    const FD3D11TimeHandle::TFragmentParents& fragmentParents = {});
+
+  /// @brief Record resolved fragments into trace capture, if capturing.
+  /// GPU timestamps can not be converted to CPU time, so fragments are placed from the CPU time 
+  /// when disjoint query was begun, with their start offsets from the earliest fragment.
+  void Trace(
+    const FD3D11TimeHandle::TTimePoint& beginTime,
+    const FD3D11TimeHandle::TTimeStamps& startOffsets,
+    const FD3D11TimeHandle::TTimeStamps& elapsedTimes) const;
+
+  /// @brief Get fragment scope tree of the last resolved frame.
+  [[nodiscard]] const DProfileScopeTree& GetScopeTree() const noexcept;
+
+  /// @brief The maximum number of frames that are waiting for GPU results.
+  /// Query sets used for deferred time checking should be rotated at least this count.
+  static constexpr std::size_t kMaxInFlightFrames = 4;
+
+  /// @brief Enqueue queries of ended frame. Results will be read later by TryResolve().
+  /// If there are already kMaxInFlightFrames pending frames, the oldest one is dropped.
+  void Enqueue(
+    ID3D11Query& disjointQuery, 
+    FD3D11TimeHandle::TTimeFragments&& fragments,
+    FD3D11TimeHandle::TFragmentParents&& fragmentParents,
+    const FD3D11TimeHandle::TTimePoint& beginTime);
+
+  /// @brief Read results of pending frames in order, without blocking CPU.
+  /// Stop at the first frame whose results are not available yet.
+  void TryResolve(ID3D11DeviceContext& deviceContext);
+
+  /// @brief Drop pending frame that uses given disjoint query, because the query will be issued again.
+  void DiscardPending(const ID3D11Query& disjointQuery);
+
+  /// @brief Drop all pending frames. Must be called before queries of pending frames are released.
+  void DiscardAllPending();
+
+  /// @brief Get the number of pending frames that dropped before resolved.
+  [[nodiscard]] std::size_t GetDroppedFrameCount() const noexcept;
 
 private:
+  /// @struct DPendingFrame
+  /// @brief Queries of frame which results are not read yet.
+  struct DPendingFrame final
+  {
+    ID3D11Query* mDisjointQuery = nullptr;
+    FD3D11TimeHandle::TTimeFragments mFragments;
+    FD3D11TimeHandle::TFragmentParents mFragmentParents;
+    FD3D11TimeHandle::TTimePoint mBeginTime;
+  };
+
+  /// @brief Try get results of pending frame without flushing and blocking.
+  /// If any query is not available yet, return nullopt.
+  /// Start offsets (ms) of fragments from the earliest fragment are stored into outStartOffsets.
+  static std::optional<FD3D11TimeHandle::TTimeStamps> 
+  TryGetTimestamps(
+    ID3D11DeviceContext& deviceContext, 
+    DPendingFrame& frame, 
+    FD3D11TimeHandle::TTimeStamps& outStartOffsets);
+
+  std::string mName;
+  uint32_t mTraceTrackId = 0;
   std::unordered_map<std::string, FTimeContainer> mFragments;
+  std::deque<DPendingFrame> mPendingFrames;
+  DProfileScopeTree mScopeTree;
+  std::size_t mDroppedFrameCount = 0;
 };
 
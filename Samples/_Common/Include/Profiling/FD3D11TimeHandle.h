@@ -15,9 +15,12 @@
 #include <chrono>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <Profiling/FD3D11TimeFragment.h>
 
 class FD3D11TimeContainer;
+class FD3D11QueryPool;
 struct ID3D11Query;
 struct ID3D11DeviceContext;
 
@@ -27,12 +30,27 @@ public:
   using TFragmentPair = std::pair<ID3D11Query*, ID3D11Query*>;
   using TTimeFragments = std::unordered_map<std::string, TFragmentPair>;
   using TTimeStamps = std::unordered_map<std::string, double>;
+  /// @brief Pairs of (fragment name, parent fragment name) in order of first check.
+  /// Parent name is empty when fragment is not nested.
+  using TFragmentParents = std::vector<std::pair<std::string, std::string>>;
+  using TTimePoint = std::chrono::steady_clock::time_point;
 
+  /// @brief Begin disjoint query.
+  /// If isUpdateDeferred is true, results are not read when this handle is destructed, 
+  /// but read later without blocking by container. 
+  /// In that case, disjoint and fragment queries must not be reused for FD3D11TimeContainer::kMaxInFlightFrames frames.
   FD3D11TimeHandle(
     FD3D11TimeContainer& container,
     ID3D11Query& disjointQuery,
     ID3D11DeviceContext& deviceContext,
     bool isUpdateDeferred);
+
+  /// @brief Begin disjoint query of next query set of pool. Results are always deferred.
+  /// Fragments can be checked without queries by CheckFragment(fragmentName).
+  FD3D11TimeHandle(
+    FD3D11TimeContainer& container,
+    FD3D11QueryPool& queryPool,
+    ID3D11DeviceContext& deviceContext);
   ~FD3D11TimeHandle();
 
   FD3D11TimeHandle(const FD3D11TimeHandle&) = delete;
@@ -47,16 +65,34 @@ public:
     ID3D11Query& startQuery,
     ID3D11Query& endQuery);
 
+  /// @brief Check fragment with start and end queries of query pool.
+  /// Handle must be created with query pool.
+  [[nodiscard]] FD3D11TimeFragment CheckFragment(const std::string& fragmentName);
+
 private:
+  friend class FD3D11TimeFragment;
+
+  /// @brief Close the innermost opened fragment. Called by FD3D11TimeFragment.
+  void EndFragment();
+
   /// @brief This function does not check every fragment query had been done.
+  /// Start offsets (ms) of fragments from the earliest fragment are stored into outStartOffsets.
   std::unordered_map<std::string, double>
-  CalculateTimestamps(ID3D11DeviceContext& dc, ID3D11Query& disjoint, TTimeFragments& fragments);
+  CalculateTimestamps(
+    ID3D11DeviceContext& dc, 
+    ID3D11Query& disjoint, 
+    TTimeFragments& fragments,
+    TTimeStamps& outStartOffsets);
   
   bool mIsMoved = false;
   bool mIsUpdateDeferred = false;
   FD3D11TimeContainer& mContainer;
   ID3D11DeviceContext& mDC;
   ID3D11Query& mDisjointQuery;
+  FD3D11QueryPool* mPtrQueryPool = nullptr;
+  TTimePoint mBeginTime;
 
   TTimeFragments mTimeFragments;
+  TFragmentParents mFragmentParents;
+  std::vector<std::string> mOpenedFragments;
 };
\ No newline at end of file
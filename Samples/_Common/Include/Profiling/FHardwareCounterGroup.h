@@ -0,0 +1,46 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <array>
+#include <Profiling/DHardwareCounters.h>
+
+/// @class FHardwareCounterGroup
+/// @brief Group of perf_event hardware counters of calling thread.
+/// Counters are opened as one group, so all values are scheduled together and comparable.
+/// Must be constructed and read by the thread to be measured. 
+/// If perf_event_open is not supported or permitted (see /proc/sys/kernel/perf_event_paranoid),
+/// group is invalid and Read() returns zero counters.
+class FHardwareCounterGroup final
+{
+public:
+  FHardwareCounterGroup();
+  ~FHardwareCounterGroup();
+
+  FHardwareCounterGroup(const FHardwareCounterGroup&) = delete;
+  FHardwareCounterGroup& operator=(const FHardwareCounterGroup&) = delete;
+
+  /// @brief Check all counters are opened.
+  [[nodiscard]] bool IsValid() const noexcept;
+
+  /// @brief Read current counter values of calling thread.
+  [[nodiscard]] DHardwareCounters Read() const noexcept;
+
+private:
+  /// @brief Close all opened counters.
+  void Close() noexcept;
+
+  /// @brief File descriptors of cycles (group leader), instructions, cache misses and branch misses.
+  std::array<int, 4> mFileDescriptors = {-1, -1, -1, -1};
+  bool mIsValid = false;
+};
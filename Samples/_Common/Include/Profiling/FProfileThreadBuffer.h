@@ -0,0 +1,100 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <atomic>
+#include <cstdint>
+#include <Profiling/DHardwareCounters.h>
+#include <Profiling/FHardwareCounterGroup.h>
+#include <Profiling/TSpscRingBuffer.h>
+#include <Profiling/XCpuClock.h>
+
+/// @struct DProfileEvent
+/// @brief Ended CPU scope event.
+struct DProfileEvent final
+{
+  /// @brief Interned tag id of scope.
+  uint32_t mTagId = 0;
+  /// @brief Nesting depth of scope in thread. Outermost scope is 0.
+  uint32_t mDepth = 0;
+  /// @brief Ticks of XCpuClock. Converted into time when collected.
+  XCpuClock::TTicks mStartTicks = 0;
+  XCpuClock::TTicks mDurationTicks = 0;
+#if PROFILING_HARDWARE_COUNTERS == 1
+  /// @brief Hardware counters increased while scope is opened.
+  DHardwareCounters mCounters;
+#endif
+};
+
+/// @class FProfileThreadBuffer
+/// @brief Profiling event buffer of one thread.
+/// Owner thread pushes ended scope events without lock, and collector pops them at frame boundary.
+class FProfileThreadBuffer final
+{
+public:
+  /// @brief The number of events that can be stored until collected.
+  static constexpr std::size_t kCapacity = 16384;
+
+  FProfileThreadBuffer(uint32_t trackId, bool isFrameThread);
+
+  /// @brief Enter new scope. Called by owner thread only.
+  /// @return Depth of entered scope.
+  uint32_t EnterScope() noexcept;
+
+  /// @brief Push ended scope event and exit scope. Called by owner thread only.
+  /// If buffer is full, event is dropped.
+  void ExitScope(const DProfileEvent& event) noexcept;
+
+  /// @brief Pop the oldest event. Called by collector only.
+  [[nodiscard]] bool TryPop(DProfileEvent& outEvent) noexcept;
+
+  /// @brief Mark owner thread is terminated. Buffer can be removed after remained events are collected.
+  void Retire() noexcept;
+
+  /// @brief Check owner thread is terminated.
+  [[nodiscard]] bool IsRetired() const noexcept;
+
+  /// @brief Check owner thread is frame thread, which completes frame when its outermost scope is ended.
+  [[nodiscard]] bool IsFrameThread() const noexcept;
+
+  /// @brief Set owner thread is frame thread or not.
+  void SetFrameThread(bool isFrameThread) noexcept;
+
+  /// @brief Get track id of owner thread, which is used for trace capture.
+  [[nodiscard]] uint32_t GetTrackId() const noexcept;
+
+  /// @brief Get the number of dropped events because buffer was full.
+  [[nodiscard]] std::size_t GetDroppedCount() const noexcept;
+
+#if PROFILING_HARDWARE_COUNTERS == 1
+  /// @brief Check hardware counters of owner thread are opened.
+  [[nodiscard]] bool HasHardwareCounters() const noexcept;
+
+  /// @brief Read hardware counters of owner thread. Called by owner thread only.
+  [[nodiscard]] DHardwareCounters ReadHardwareCounters() const noexcept;
+#endif
+
+private:
+  TSpscRingBuffer<DProfileEvent, kCapacity> mEvents;
+  std::atomic<std::size_t> mDroppedCount = 0;
+  std::atomic<bool> mIsRetired = false;
+  std::atomic<bool> mIsFrameThread = false;
+  uint32_t mTrackId = 0;
+
+  /// @brief Only accessed by owner thread.
+  uint32_t mDepth = 0;
+#if PROFILING_HARDWARE_COUNTERS == 1
+  /// @brief Opened by owner thread when buffer is created.
+  FHardwareCounterGroup mCounterGroup;
+#endif
+};
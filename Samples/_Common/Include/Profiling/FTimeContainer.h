@@ -13,19 +13,37 @@
 ///
 
 #include <chrono>
+#include <deque>
+#include <utility>
 #include <vector>
 
+#include <Profiling/DHardwareCounters.h>
+#include <Profiling/FTimeHistogram.h>
+
 /// @brief Time stamp type.
 using TTimeStamp = std::chrono::duration<double>;
 
 /// @class FTimeContainer
-/// @brief Time stamp container
+/// @brief Time stamp container. 
+/// Keeps the recent elapsed times of window and statistics of them.
+/// Every statistics except for percentile are updated in O(1) when inserted.
 class FTimeContainer final
 {
 public:
+  /// @brief Default length of window.
+  static constexpr std::size_t kDefaultWindowLength = 50;
+
+  explicit FTimeContainer(std::size_t windowLength = kDefaultWindowLength);
+
   /// @brief Get Lenght of elapsed second timer items.
   std::size_t Length() const noexcept;
 
+  /// @brief Get length of window, the maximum number of recent items.
+  std::size_t GetWindowLength() const noexcept;
+
+  /// @brief Set length of window. All items are removed.
+  void SetWindowLength(std::size_t windowLength);
+
   /// @brief Get recent time stamp. 
   /// If not exist, just return -1.
   TTimeStamp GetRecent() const noexcept;
@@ -34,6 +52,22 @@ public:
   /// If not exist, just return -1.
   TTimeStamp GetAverage() const noexcept;
 
+  /// @brief Get variance (second^2) of list.
+  /// If not exist, just return -1.
+  double GetVariance() const noexcept;
+
+  /// @brief Get standard deviation of list.
+  /// If not exist, just return -1.
+  TTimeStamp GetStandardDeviation() const noexcept;
+
+  /// @brief Get approximated percentile of list. ratio must be in [0, 1]. (e.g 0.99 is p99)
+  /// If not exist, just return -1.
+  TTimeStamp GetPercentile(double ratio) const noexcept;
+
+  /// @brief Get maximum time stamp of list.
+  /// If not exist, just return -1.
+  TTimeStamp GetMax() const noexcept;
+
   /// @brief Get time stamp of index. 
   /// this function does not check potential error.
   TTimeStamp operator[](std::size_t index) const noexcept;
@@ -41,12 +75,52 @@ public:
   /// @brief Insert new elapsed time stamp into list.
   void Insert(const TTimeStamp& elapsedTime);
 
+  /// @brief Insert new elapsed time stamp and hardware counters of the same scope into list.
+  /// Insertions with and without counters can be mixed, and only slots with counters are averaged.
+  void Insert(const TTimeStamp& elapsedTime, const DHardwareCounters& counters);
+
+  /// @brief Check hardware counters are inserted with time stamps.
+  [[nodiscard]] bool HasCounters() const noexcept;
+
+  /// @brief Get average hardware counters of list.
+  /// If not exist, just return zero counters.
+  [[nodiscard]] DHardwareCounters GetAverageCounters() const noexcept;
+
+  /// @brief Get instructions per cycle of list.
+  /// If not exist, just return -1.
+  [[nodiscard]] double GetInstructionsPerCycle() const noexcept;
+
 private:
-  /// @brief
-  static constexpr std::size_t kMax = 50;
+  /// @brief Insert elapsed time stamp at present index and update statistics.
+  void InsertTime(const TTimeStamp& elapsedTime);
+  /// @brief Put counters at present index. This must be called before InsertTime.
+  void InsertCounters(const DHardwareCounters& counters, bool isValid);
+
+  /// @brief Maximum length of list.
+  std::size_t mWindowLength = kDefaultWindowLength;
   /// @brief List
   std::vector<TTimeStamp> mElapsedSeconds;
   /// @brief Present index of list cursor.
   std::size_t mPresentIndex = 0;
-};
 
+  /// @brief Running mean of list. (seconds)
+  double mMean = 0.0;
+  /// @brief Running sum of squared differences from the mean. (Welford)
+  double mSquaredDiffSum = 0.0;
+  /// @brief Histogram of list to get percentiles.
+  FTimeHistogram mHistogram;
+  /// @brief Pairs of (insertion sequence, elapsed time) which are decreasing, to get max in O(1).
+  std::deque<std::pair<std::size_t, TTimeStamp>> mMaxCandidates;
+  /// @brief The number of inserted items since window was set.
+  std::size_t mInsertedCount = 0;
+
+  /// @brief Hardware counters of list. Index is same to time stamp.
+  /// Empty until the first counters are inserted.
+  std::vector<DHardwareCounters> mCounters;
+  /// @brief Whether slot of same index has counters.
+  std::vector<bool> mIsCounterValid;
+  /// @brief The number of slots which have counters.
+  std::size_t mValidCounterCount = 0;
+  /// @brief Sum of hardware counters of list.
+  DHardwareCounters mCounterSum;
+};
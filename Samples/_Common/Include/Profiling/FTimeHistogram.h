@@ -0,0 +1,60 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/// @class FTimeHistogram
+/// @brief Log-linear histogram of elapsed times, like HDR histogram.
+/// Values are recorded as microseconds, and each power of 2 range is divided into kSubBucketCount buckets,
+/// so relative error of percentile is less than 1 / kSubBucketCount.
+class FTimeHistogram final
+{
+public:
+  using TTimeStamp = std::chrono::duration<double>;
+
+  /// @brief Add one elapsed time into histogram.
+  void Add(const TTimeStamp& elapsedTime) noexcept;
+
+  /// @brief Remove one elapsed time that was added before.
+  void Remove(const TTimeStamp& elapsedTime) noexcept;
+
+  /// @brief Remove all values.
+  void Clear() noexcept;
+
+  /// @brief Get approximated value of percentile. ratio must be in [0, 1].
+  /// If there is no value, return -1.
+  [[nodiscard]] TTimeStamp GetPercentile(double ratio) const noexcept;
+
+  /// @brief Get the number of values.
+  [[nodiscard]] std::size_t GetCount() const noexcept;
+
+private:
+  static constexpr uint32_t kSubBucketBits = 5;
+  static constexpr uint32_t kSubBucketCount = 1u << kSubBucketBits;
+  /// @brief The largest exponent of microseconds. (2^30 us is about 18 minutes)
+  static constexpr uint32_t kMaxExponent = 30;
+  static constexpr std::size_t kBucketCount = 
+    (kSubBucketCount * 2) + (kMaxExponent - kSubBucketBits) * kSubBucketCount;
+
+  /// @brief Get bucket index of elapsed time.
+  static std::size_t GetBucketIndex(const TTimeStamp& elapsedTime) noexcept;
+
+  /// @brief Get middle value of bucket range.
+  static TTimeStamp GetBucketValue(std::size_t index) noexcept;
+
+  std::array<uint32_t, kBucketCount> mBuckets = {};
+  std::size_t mCount = 0;
+};
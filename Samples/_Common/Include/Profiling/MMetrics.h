@@ -0,0 +1,152 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dy
+{
+class AProfilingBase;
+} /// ::dy namespace
+
+/// @enum EMetricKind
+/// @brief How metric value is recorded into history.
+enum class EMetricKind
+{
+  Gauge,            // Value is set by SetGauge. History records the latest value.
+  CounterPerSecond, // Value is monotonic count. History records increase per second.
+  CounterPerFrame,  // Value is monotonic count. History records increase per completed frame.
+};
+
+/// @class MMetrics
+/// @brief Static registry of named counters and gauges.
+///
+/// Counters and gauges can be updated from any thread without lock.
+/// Sampler records all metrics at fixed rate into history ring buffer of each metric, 
+/// so UI and exporters read history instead of calling OS every frame.
+/// Sample callbacks are called by sampler before recording, to update gauges read from OS or other managers.
+/// While MTraceCapture is capturing, sampled values are also recorded as counter events.
+class MMetrics final
+{
+public:
+  /// @brief The number of samples that history of each metric keeps.
+  static constexpr std::size_t kHistoryLength = 256;
+
+  /// @brief Register metric and get id of it.
+  /// If name is already registered, just return registered id. (Kind is not changed)
+  static uint32_t RegisterMetric(const std::string& name, EMetricKind kind);
+
+  /// @brief Find id of metric name. If not exist, return null.
+  [[nodiscard]] static std::optional<uint32_t> FindMetric(const std::string& name);
+
+  /// @brief Set gauge value of metric.
+  static void SetGauge(uint32_t id, double value) noexcept;
+
+  /// @brief Increase count of counter metric.
+  static void AddCount(uint32_t id, uint64_t count = 1) noexcept;
+
+  /// @brief Set total count of counter metric, which is read from monotonic source.
+  static void SetCount(uint32_t id, uint64_t total) noexcept;
+
+  /// @brief Count draw calls. Recorded as "Draw Calls" per frame by default metrics.
+  static void CountDrawCall(uint32_t count = 1) noexcept;
+
+  /// @brief Mark frame is completed. Called by MTimeChecker when CPU frame is completed.
+  static void MarkFrame() noexcept;
+
+  /// @brief Add callback that is called by sampler before metrics are recorded.
+  /// Callback must not register metric or callback.
+  static void AddSampleCallback(std::function<void()> callback);
+
+  /// @brief Register CPU usage (total and per core), RAM usage, allocation rate, 
+  /// draw calls per frame and resource counts of MD3D11Resources.
+  /// Profiling instance must be alive until sampling is stopped, and must be sampled only by sampler.
+  static void RegisterDefaultMetrics(dy::AProfilingBase& profiling);
+
+  /// @brief Start sampling thread which samples metrics per interval.
+  /// If sampling is already started, do nothing.
+  static void StartSampling(std::chrono::milliseconds interval = std::chrono::milliseconds(100));
+
+  /// @brief Stop sampling thread and wait until it is terminated.
+  static void StopSampling();
+
+  /// @brief Sample all metrics into history on caller thread.
+  static void Sample();
+
+  /// @brief Get the number of registered metrics. Id is less than this value.
+  [[nodiscard]] static std::size_t GetMetricCount();
+
+  /// @brief Get name of metric.
+  [[nodiscard]] static std::string GetMetricName(uint32_t id);
+
+  /// @brief Get kind of metric.
+  [[nodiscard]] static EMetricKind GetMetricKind(uint32_t id);
+
+  /// @brief Get the latest recorded value of metric. If not sampled yet, return 0.
+  [[nodiscard]] static float GetLatest(uint32_t id);
+
+  /// @brief Get recorded values of metric from the oldest to the latest.
+  [[nodiscard]] static std::vector<float> GetHistory(uint32_t id);
+
+private:
+  /// @struct DMetric
+  /// @brief Registered metric and its history.
+  struct DMetric final
+  {
+    std::string mName;
+    EMetricKind mKind = EMetricKind::Gauge;
+    std::atomic<double> mValue = 0.0;
+    std::atomic<uint64_t> mCount = 0;
+
+    /// @brief Only accessed while registry is locked.
+    uint64_t mLastCount = 0;
+    std::array<float, kHistoryLength> mHistory = {};
+    std::size_t mHistoryHead = 0;
+    std::size_t mHistorySize = 0;
+  };
+
+  /// @brief The maximum number of metrics.
+  static constexpr std::size_t kMaxMetricCount = 256;
+
+  /// @brief Sampling thread routine.
+  static void SampleRoutine(std::chrono::milliseconds interval);
+
+  /// @brief Guards registration, callbacks and histories.
+  static std::mutex mMutex;
+  /// @brief Registered metrics. Index is id. 
+  /// Fixed array is used so that counters can be updated without lock while other threads register.
+  static std::array<DMetric, kMaxMetricCount> mMetrics;
+  static std::atomic<std::size_t> mMetricCount;
+  static std::vector<std::function<void()>> mSampleCallbacks;
+
+  static std::atomic<uint64_t> mFrameCount;
+  static std::atomic<uint64_t> mDrawCallCount;
+  /// @brief Only accessed while registry is locked.
+  static uint64_t mLastFrameCount;
+  static std::chrono::steady_clock::time_point mLastSampleTime;
+
+  static std::mutex mSamplerMutex;
+  static std::condition_variable mSamplerConditionVariable;
+  static bool mIsStopRequested;
+  static std::thread mSamplerThread;
+};
@@ -12,14 +12,23 @@
 /// SOFTWARE.
 ///
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
+#include <Profiling/DProfileScopeTree.h>
+#include <Profiling/DProfileTag.h>
 #include <Profiling/FCpuTimeHandle.h>
+#include <Profiling/FD3D11QueryPool.h>
 #include <Profiling/FD3D11TimeHandle.h>
 #include <Profiling/FTimeContainer.h>
 #include <Profiling/FD3D11TimeContainer.h>
+#include <Profiling/FProfileThreadBuffer.h>
 #include <Math/Common/XGlobalMacroes.h>
 
 struct ID3D11Query;
@@ -27,15 +36,39 @@ struct ID3D11DeviceContext;
 
 /// @class MTimeChecker
 /// @brief Static time checker class 
+///
+/// CPU scopes can be checked from any thread. Each thread writes ended scopes into its own buffer without lock,
+/// and events of all threads are merged into CPU time containers when frame is completed. 
+/// Frame is completed when the outermost scope of frame thread is ended.
+/// Frame thread is the thread that called Initialize() or SetFrameThread() the last,
+/// or is the first thread that checks CPU time if neither was called.
+/// CPU time containers, scope tree and GPU functions must be accessed from frame thread only.
 class MTimeChecker final
 {
 public:
   using TCpuContainer = std::unordered_map<std::string, std::unique_ptr<FTimeContainer>>;
   using TD3D11Container = std::unordered_map<std::string, std::unique_ptr<FD3D11TimeContainer>>;
+  using TD3D11QueryPools = std::unordered_map<std::string, std::unique_ptr<FD3D11QueryPool>>;
+
+  /// @brief Calibrate CPU clock, measure instrumentation cost of one CPU scope and make caller thread frame thread.
+  /// Call this once from frame thread before the first profiled frame and before other threads check CPU time,
+  /// so calibration does not stall the frame.
+  static void Initialize();
+
+  /// @brief Register tag name and get interned id of it. 
+  /// If tag name is already registered, just return registered id.
+  static uint32_t RegisterTag(const std::string& tagName);
+
+  /// @brief Make caller thread frame thread. Must not be called while any CPU scope is opened.
+  static void SetFrameThread();
 
   /// @brief Check CPU time.
+  /// Tag name is looked up every call, so prefer DProfileTag version if tag name is constant.
   [[nodiscard]] static FCpuTimeHandle CheckCpuTime(const std::string& tagName);
 
+  /// @brief Check CPU time with interned tag.
+  [[nodiscard]] static FCpuTimeHandle CheckCpuTime(const DProfileTag& tag);
+
   /// @brief Check D3D11 GPU time.
   [[nodiscard]] static FD3D11TimeHandle CheckGpuD3D11Time(
     const std::string& tagName,
@@ -43,7 +76,21 @@ public:
     ID3D11DeviceContext& deviceContext,
     bool isUpdateDeferred);
 
-  /// @brief Get CPU time container of tag name.
+  /// @brief Check D3D11 GPU time with queries of pool that MTimeChecker owns.
+  /// Results are read some frames later without stall.
+  [[nodiscard]] static FD3D11TimeHandle CheckGpuD3D11Time(
+    const std::string& tagName,
+    const D11HandleDevice& hDevice);
+
+  /// @brief Release all pooled D3D11 queries. 
+  /// This must be called before device of queries is removed.
+  static void ReleaseD3D11Queries();
+
+  /// @brief Check CPU time container of tag name exists.
+  [[nodiscard]] static bool Has(const std::string& tagName);
+
+  /// @brief Get CPU time container of tag name. 
+  /// Elapsed times of ended scopes are inserted when frame is completed.
   /// If not exist, just throw error.
   static const FTimeContainer& Get(const std::string& tagName);
 
@@ -51,27 +98,106 @@ public:
   /// If not exist, just throw error.
   static const FD3D11TimeContainer& GetGpuD3D11(const std::string& tagName);
 
+  /// @brief Get CPU scope tree of frame thread of the last completed frame.
+  static const DProfileScopeTree& GetCpuScopeTree();
+
+  /// @brief Get measured instrumentation cost of one CPU scope. (Reading clock twice and pushing event)
+  /// Measured by Initialize(). If Initialize() was not called, return 0.
+  static TTimeStamp GetScopeOverhead();
+
+  /// @brief Get the number of CPU scope events dropped because buffer of thread was full.
+  static std::size_t GetDroppedEventCount();
+
 private:
+  friend class FCpuTimeHandle;
+
+  /// @struct DTagEntry
+  /// @brief Name and CPU time container of interned tag.
+  struct DTagEntry final
+  {
+    const std::string* mName = nullptr;
+    FTimeContainer* mContainer = nullptr;
+  };
+
+  /// @brief The maximum number of interned tags.
+  static constexpr std::size_t kMaxTagCount = 1024;
+
+  /// @brief Begin CPU scope of interned tag id.
+  static FCpuTimeHandle BeginCpuScope(uint32_t tagId);
+
+  /// @brief End the innermost CPU scope of caller thread. Called by FCpuTimeHandle.
+  static void EndCpuScope(const DProfileEvent& event);
+
+  /// @brief Get profiling event buffer of caller thread. If not exist, create and register it.
+  static FProfileThreadBuffer& GetThreadBuffer();
+
+  /// @brief Measure instrumentation cost of one CPU scope with small buffer on stack.
+  /// Reading hardware counters is not included.
+  static TTimeStamp MeasureScopeOverhead();
+
+  /// @brief Merge events of all threads into CPU time containers, and build scope tree of frame thread.
+  /// Called by frame thread when its outermost scope is ended.
+  static void CompleteFrame();
+
+  /// @brief Guards tag registration, CPU time container map and thread buffer list.
+  static std::mutex mMutex;
   /// @brief CPU Timer container.
   static TCpuContainer mTimerContainer;
+  /// @brief Interned tags. Index is tag id. 
+  /// Fixed array is used so that registered entries are never moved while other threads register.
+  static std::array<DTagEntry, kMaxTagCount> mTags;
+  static std::size_t mTagCount;
+  /// @brief Tag name to interned tag id.
+  static std::unordered_map<std::string, uint32_t> mTagIds;
+  /// @brief Event buffers of threads which checked CPU time.
+  static std::vector<std::shared_ptr<FProfileThreadBuffer>> mThreadBuffers;
+  /// @brief Dropped event count of retired thread buffers.
+  static std::size_t mRetiredDroppedCount;
 
   /// @brief GPU D3D11 Timer container.
   static TD3D11Container mD3D11TimeContainer;
+
+  /// @brief GPU D3D11 Query pools of each tag.
+  static TD3D11QueryPools mD3D11QueryPools;
+
+  /// @brief Collected events of frame thread which are not built into scope tree yet.
+  static std::vector<DProfileEvent> mFrameEvents;
+  /// @brief CPU scope tree of the last completed frame.
+  static DProfileScopeTree mCpuScopeTree;
+  /// @brief The number of completed CPU frames.
+  static uint64_t mCpuFrameIndex;
+  /// @brief Instrumentation cost of one CPU scope measured by Initialize().
+  static TTimeStamp mScopeOverhead;
 };
 
 /// @def TIME_CHECK_CPU
 /// @brief Fire CPU checking routine. Fire and forget.
+/// Name is interned only once at the first call of call site, so Name must be constant.
+/// If Name can be changed, use MTimeChecker::CheckCpuTime(const std::string&) instead.
 #define TIME_CHECK_CPU(Name) \
-  auto MATH_TOKEN_PASTE(_, __LINE__) = ::MTimeChecker::CheckCpuTime(Name)
+  static const ::DProfileTag MATH_TOKEN_PASTE(_tag, __LINE__){Name}; \
+  auto MATH_TOKEN_PASTE(_, __LINE__) = ::MTimeChecker::CheckCpuTime(MATH_TOKEN_PASTE(_tag, __LINE__))
 
 /// @def TIME_CHECK_D3D11_STALL
 /// @brief Fire GPU disjoint checking routine as D3D11.
 #define TIME_CHECK_D3D11_STALL(Variable, Name, Disjoint, DeviceContext) \
   auto Variable = ::MTimeChecker::CheckGpuD3D11Time(Name, Disjoint, DeviceContext, false)
 
+/// @def TIME_CHECK_D3D11_DEFERRED
+/// @brief Fire GPU disjoint checking routine as D3D11, but results are read some frames later without stall.
+/// Disjoint and fragment queries must be rotated per frame. (See FD3D11TimeContainer::kMaxInFlightFrames)
+#define TIME_CHECK_D3D11_DEFERRED(Variable, Name, Disjoint, DeviceContext) \
+  auto Variable = ::MTimeChecker::CheckGpuD3D11Time(Name, Disjoint, DeviceContext, true)
+
+/// @def TIME_CHECK_D3D11
+/// @brief Fire GPU disjoint checking routine as D3D11 with pooled queries. 
+/// Results are read some frames later without stall.
+#define TIME_CHECK_D3D11(Variable, Name, Device) \
+  auto Variable = ::MTimeChecker::CheckGpuD3D11Time(Name, Device)
+
 /// @def TIME_CHECK_FRAGMENT
 /// @brief Fire GPU fragment gpu time checking routine by Disjoint Variable.
+/// Queries can be omitted when Disjoint Variable was made by TIME_CHECK_D3D11.
 /// Fire and forget.
-#define TIME_CHECK_FRAGMENT(Disjoint, Name, StartQuery, EndQuery) \
-  auto MATH_TOKEN_PASTE(_, __LINE__) = Disjoint.CheckFragment( \
-    Name, StartQuery, EndQuery)
\ No newline at end of file
+#define TIME_CHECK_FRAGMENT(Disjoint, ...) \
+  auto MATH_TOKEN_PASTE(_, __LINE__) = Disjoint.CheckFragment(__VA_ARGS__)
@@ -0,0 +1,128 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/// @class MTraceCapture
+/// @brief Static trace capture class. 
+/// Stream profiling events into file as Chrome Trace Event JSON format, 
+/// which can be opened with about:tracing or Perfetto UI.
+///
+/// Events are only appended into memory buffer on caller thread.
+/// Formatting and writing into file is done by background writer thread.
+/// CPU scope events are recorded by MTimeChecker when frame is completed, not when scope is ended.
+class MTraceCapture final
+{
+public:
+  using TClock = std::chrono::steady_clock;
+  using TTimePoint = TClock::time_point;
+
+  /// @brief Start capturing into file of given path. 
+  /// If capture is already started or file can not be opened, return false.
+  static bool StartCapture(const std::string& filePath);
+
+  /// @brief Stop capturing. Wait until all buffered events are written and close file.
+  static void StopCapture();
+
+  /// @brief Check capture is started.
+  [[nodiscard]] static bool IsCapturing() noexcept;
+
+  /// @brief Record frame marker with frame index at given time.
+  static void MarkFrame(uint64_t frameIndex, uint32_t trackId, const TTimePoint& time);
+
+  /// @brief Record complete event on given track.
+  /// Name, category and track name must be alive until capture is stopped.
+  /// If track name is null, track is named by its id.
+  static void AddCompleteEvent(
+    const char* name, 
+    const char* category,
+    uint32_t trackId, 
+    const char* trackName, 
+    const TTimePoint& start, 
+    const std::chrono::duration<double>& duration);
+
+  /// @brief Record counter event of given value at given time.
+  /// Name and track name must be alive until capture is stopped.
+  static void AddCounterEvent(
+    const char* name,
+    uint32_t trackId,
+    const char* trackName,
+    const TTimePoint& time,
+    double value);
+
+  /// @brief Allocate new track id which is not used by any thread.
+  [[nodiscard]] static uint32_t AllocateTrackId() noexcept;
+
+private:
+  /// @struct DTraceEvent
+  /// @brief Unformatted trace event.
+  struct DTraceEvent final
+  {
+    const char* mName = nullptr;
+    const char* mCategory = nullptr;
+    const char* mTrackName = nullptr;
+    char mPhase = 'i';
+    uint32_t mTrackId = 0;
+    uint64_t mFrameIndex = 0;
+    TTimePoint mTime;
+    std::chrono::duration<double> mDuration{0};
+    double mValue = 0.0;
+  };
+
+  /// @brief Push event into front buffer and wake up writer thread if buffer is full enough.
+  static void Push(const DTraceEvent& event);
+
+  /// @brief Writer thread routine. Swap buffers and write back buffer until capture is stopped.
+  static void WriteRoutine();
+
+  /// @brief Write one event as JSON object into file.
+  static void Write(const DTraceEvent& event);
+
+  /// @brief Write string into file with escaping JSON special characters.
+  static void WriteEscaped(const char* string);
+
+  /// @brief The number of events that wakes writer thread.
+  static constexpr std::size_t kFlushThreshold = 4096;
+  /// @brief Interval that writer thread wakes even if buffer is not full.
+  static constexpr std::chrono::milliseconds kFlushInterval{100};
+  /// @brief The start id of tracks that are not thread. (e.g GPU)
+  /// Track id of threads must be less than this value.
+  static constexpr uint32_t kVirtualTrackIdBase = 1000;
+
+  static std::atomic<bool> mIsCapturing;
+  static std::atomic<uint32_t> mVirtualTrackCounter;
+
+  static std::mutex mMutex;
+  static std::condition_variable mConditionVariable;
+  static std::vector<DTraceEvent> mFrontBuffer;
+  static bool mIsStopRequested;
+
+  /// @brief Only accessed by writer thread while capturing.
+  static std::vector<DTraceEvent> mBackBuffer;
+  static std::unordered_set<uint32_t> mWrittenTracks;
+  static std::ofstream mFile;
+  static bool mIsFirstEvent;
+
+  static std::thread mWriterThread;
+  static TTimePoint mStartTime;
+};
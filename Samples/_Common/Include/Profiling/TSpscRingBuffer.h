@@ -0,0 +1,49 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/// @class TSpscRingBuffer
+/// @tparam TType Value type. Must be default-constructible and copy-assignable.
+/// @tparam TCapacity The number of values that can be stored. Must be power of 2.
+/// @brief Lock-free ring buffer of single producer and single consumer.
+/// TryPush() must be called by only one thread, and TryPop() must be called by only one (other) thread.
+template <typename TType, std::size_t TCapacity>
+class TSpscRingBuffer final
+{
+public:
+  /// @brief Push value. Called by producer thread only.
+  /// @return If buffer is full, return false and value is not pushed.
+  [[nodiscard]] bool TryPush(const TType& value) noexcept;
+
+  /// @brief Pop the oldest value. Called by consumer thread only.
+  /// @return If buffer is empty, return false.
+  [[nodiscard]] bool TryPop(TType& outValue) noexcept;
+
+  /// @brief Get the number of values that can be stored.
+  [[nodiscard]] static constexpr std::size_t GetCapacity() noexcept { return TCapacity; }
+
+private:
+  static_assert(TCapacity > 0 && (TCapacity & (TCapacity - 1)) == 0, "Capacity must be power of 2.");
+  static constexpr std::size_t kMask = TCapacity - 1;
+
+  /// @brief Written only by producer. Aligned to cache line to avoid false-sharing with consumer.
+  alignas(64) std::atomic<std::size_t> mHead = 0;
+  /// @brief Written only by consumer.
+  alignas(64) std::atomic<std::size_t> mTail = 0;
+  alignas(64) std::array<TType, TCapacity> mValues;
+};
+#include <Inline/TSpscRingBuffer.inl>
@@ -0,0 +1,79 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <chrono>
+#include <cstdint>
+
+/// @def PROFILING_TSC_TIMER
+/// @brief If 1, CPU profiling scopes are timed by time-stamp counter (rdtscp) when CPU has invariant TSC.
+/// If 0, or CPU does not have invariant TSC, std::chrono::steady_clock is used.
+#ifndef PROFILING_TSC_TIMER
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PROFILING_TSC_TIMER 1
+#else
+#define PROFILING_TSC_TIMER 0
+#endif
+#endif
+
+/// @class XCpuClock
+/// @brief Low-overhead clock of CPU profiling.
+/// Ticks are raw counter values, and converted into seconds only when they are collected.
+/// Frequency of TSC is calibrated once against steady_clock when clock is used at first.
+class XCpuClock final
+{
+public:
+  using TTicks = uint64_t;
+
+  /// @brief Get current ticks.
+  [[nodiscard]] static TTicks Now() noexcept;
+
+  /// @brief Convert elapsed ticks into seconds.
+  [[nodiscard]] static std::chrono::duration<double> ToDuration(TTicks ticks) noexcept;
+
+  /// @brief Convert ticks into time point of steady_clock.
+  [[nodiscard]] static std::chrono::steady_clock::time_point ToTimePoint(TTicks ticks) noexcept;
+
+  /// @brief Check clock is using time-stamp counter.
+  [[nodiscard]] static bool IsUsingTsc() noexcept;
+
+  /// @brief Get measured average cost of one Now() call.
+  [[nodiscard]] static std::chrono::duration<double> GetCallOverhead() noexcept;
+
+private:
+  /// @struct DCalibration
+  /// @brief Clock source and frequency that are decided once.
+  struct DCalibration final
+  {
+    bool mIsUsingTsc = false;
+    double mSecondsPerTick = 0.0;
+    TTicks mAnchorTicks = 0;
+    std::chrono::steady_clock::time_point mAnchorTime;
+    std::chrono::duration<double> mCallOverhead{0};
+  };
+
+  /// @brief Get calibration. Calibrate at the first call.
+  static const DCalibration& GetCalibration() noexcept;
+
+  /// @brief Check CPU supports rdtscp and invariant TSC.
+  static bool HasInvariantTsc() noexcept;
+
+  /// @brief Read time-stamp counter.
+  static TTicks ReadTsc() noexcept;
+
+  /// @brief Read steady_clock as ticks.
+  static TTicks ReadSteadyClock() noexcept;
+
+  static DCalibration Calibrate() noexcept;
+};
+#include <Inline/XCpuClock.inl>
@@ -13,7 +13,7 @@
 ///
 
 #include <Resource/DD3D11Handle.h>
-#include <Windows.h>
+#include <windows.h>
 
 /// @class D11DefaultHandles
 /// @brief Default handles that have handles of default device and swap-chain. \n
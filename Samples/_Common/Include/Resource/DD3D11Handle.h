@@ -12,37 +12,66 @@
 /// SOFTWARE.
 ///
 
-#include <Math/Type/Micellanous/DUuid.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <Resource/DSlotKey.h>
 #include <Resource/ED3D11Resc.h>
 
 /// @class DD3D11Handle
-/// @tparam EValue
-/// @brief
+/// @tparam EValue Resource type of handle. This is only used in compile time.
+/// @brief Handle of D3D11 resource in MD3D11Resources.
+/// Slot index and generation of resource container is packed into one 64-bit integer,
+/// so handle is trivially copyable and can be copied, compared and hashed as an integer.
+/// Packed value 0 is null handle.
 template <ED3D11Resc EValue>
 class DD3D11Handle final
 {
 public:
-  DD3D11Handle(std::nullptr_t) {};
-  DD3D11Handle(const ::dy::math::DUuid& validUuid)
-    : mUuid{validUuid}
-  { } 
+  /// @brief Resource type of handle.
+  static constexpr ED3D11Resc kType = EValue;
 
-  [[nodiscard]] bool IsValid() const noexcept
-  {
-    static const ::dy::math::DUuid noneUuid = ::dy::math::DUuid{};
-    return this->mUuid != noneUuid;
-  }
+  DD3D11Handle() = default;
+  DD3D11Handle(std::nullptr_t) noexcept {};
+  /// @brief Make handle from key issued by container.
+  /// Key must be valid, but invalid key (generation is 0) makes null handle in release build.
+  DD3D11Handle(const DSlotKey& validKey) noexcept;
 
-  const auto& GetUuid() const noexcept
-  {
-    return this->mUuid;
-  }
+  /// @brief Check handle is not null. 
+  /// This does not check resource is still alive, use MD3D11Resources::Has~ for that.
+  [[nodiscard]] bool IsValid() const noexcept;
+
+  /// @brief Get slot key of resource container.
+  [[nodiscard]] DSlotKey GetKey() const noexcept;
+
+  /// @brief Get packed value of handle. (Generation << 32 | Index)
+  [[nodiscard]] uint64_t GetPacked() const noexcept;
 
 private:
-  ED3D11Resc mValue = EValue;
-  ::dy::math::DUuid mUuid = ::dy::math::DUuid{false};
+  uint64_t mPacked = 0;
 };
 
+template <ED3D11Resc EValue>
+bool operator==(const DD3D11Handle<EValue>& lhs, const DD3D11Handle<EValue>& rhs) noexcept;
+
+template <ED3D11Resc EValue>
+bool operator!=(const DD3D11Handle<EValue>& lhs, const DD3D11Handle<EValue>& rhs) noexcept;
+
+namespace std
+{
+
+template <ED3D11Resc EValue>
+struct hash<DD3D11Handle<EValue>>
+{
+  std::size_t operator()(const DD3D11Handle<EValue>& handle) const noexcept
+  {
+    return std::hash<uint64_t>{}(handle.GetPacked());
+  }
+};
+
+} /// ::std namespace
+
 /// @brief 
 using D11HandleDevice = DD3D11Handle<ED3D11Resc::Device>;
 /// @brief
@@ -70,4 +99,8 @@ using D11HandleTexture2D = DD3D11Handle<ED3D11Resc::Texture2D>;
 /// @brief Handle type for internal ID3DBlob (ID3D10Blob) resource.
 using D11HandleBlob = DD3D11Handle<ED3D11Resc::Blob>;
 /// @brief Handle type for internal ID3D11Query resource.
-using D11HandleQuery = DD3D11Handle<ED3D11Resc::Query>;
\ No newline at end of file
+using D11HandleQuery = DD3D11Handle<ED3D11Resc::Query>;
+
+static_assert(sizeof(D11HandleBuffer) == sizeof(uint64_t), "Handle must be packed into 8 bytes.");
+static_assert(std::is_trivially_copyable_v<D11HandleBuffer>, "Handle must be trivially copyable.");
+#include <Inline/DD3D11Handle.inl>
@@ -12,8 +12,8 @@
 /// SOFTWARE.
 ///
 
+#include <d3d11.h>
 #include <ComWrapper/IComOwner.h>
-#include <D3D11.h>
 
 /// @class DD3DResourceDevice
 /// @brief 
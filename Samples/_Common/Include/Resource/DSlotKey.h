@@ -0,0 +1,40 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdint>
+#include <limits>
+
+/// @struct DSlotKey
+/// @brief Key of generational slot map. 
+/// Index points to slot of TSlotMap, and generation is used for detecting stale key
+/// when slot was removed and reused by other value.
+struct DSlotKey final
+{
+  static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+  /// @brief Slot index of TSlotMap.
+  uint32_t mIndex = kInvalidIndex;
+  /// @brief Generation of slot. Valid generation is always bigger than 0.
+  uint32_t mGeneration = 0;
+};
+
+inline bool operator==(const DSlotKey& lhs, const DSlotKey& rhs) noexcept
+{
+  return lhs.mIndex == rhs.mIndex && lhs.mGeneration == rhs.mGeneration;
+}
+
+inline bool operator!=(const DSlotKey& lhs, const DSlotKey& rhs) noexcept
+{
+  return (lhs == rhs) == false;
+}
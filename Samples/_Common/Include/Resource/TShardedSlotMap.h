@@ -0,0 +1,96 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <Resource/TSlotMap.h>
+
+/// @def MD3D11RESOURCES_CONCURRENT
+/// @brief If 1, resource containers of MD3D11Resources can be accessed from multiple threads.
+/// Lookups take shared lock of one shard, and inserts and removes take exclusive lock of one shard.
+/// If 0, there is only one shard and locks do nothing.
+#ifndef MD3D11RESOURCES_CONCURRENT
+#define MD3D11RESOURCES_CONCURRENT 1
+#endif
+
+/// @class XNoLock
+/// @brief Lock type that does nothing, for single-threaded mode.
+class XNoLock final
+{
+public:
+  void lock() noexcept {};
+  void unlock() noexcept {};
+  void lock_shared() noexcept {};
+  void unlock_shared() noexcept {};
+};
+
+/// @class TShardedSlotMap
+/// @tparam TValue Value type. Must be move-constructible and move-assignable.
+/// @tparam TShardCount The number of shards.
+/// @brief Slot map split into shards, each shard has own TSlotMap and reader-writer lock.
+/// Insertion selects shard by calling thread, so loader threads do not contend each other,
+/// and lookups of other shards are not blocked by insertion or removal.
+/// Shard index is encoded into index of key. (Index = LocalIndex * TShardCount + Shard)
+template <typename TValue, uint32_t TShardCount = MD3D11RESOURCES_CONCURRENT ? 8 : 1>
+class TShardedSlotMap final
+{
+public:
+  using TLock = std::conditional_t<MD3D11RESOURCES_CONCURRENT == 1, std::shared_mutex, XNoLock>;
+
+  /// @brief Construct value in-place into shard of calling thread, and return key of the value.
+  template <typename... TArgs>
+  [[nodiscard]] DSlotKey Emplace(TArgs&&... args);
+
+  /// @brief Check key is valid and value of key is exist in container.
+  [[nodiscard]] bool Has(const DSlotKey& key) const;
+
+  /// @brief Call function with the value of given key while shard is locked for reading.
+  /// If key is stale or invalid, throw std::out_of_range without calling function.
+  /// Reference of value must not be escaped from function, because value can be moved by removal.
+  /// @return Return value of function.
+  template <typename TFunction>
+  decltype(auto) Visit(const DSlotKey& key, TFunction&& function);
+
+  /// @brief Remove value of given key.
+  /// @return If key is stale or invalid, return false.
+  bool Remove(const DSlotKey& key);
+
+  /// @brief Get the number of values of all shards. 
+  /// Shards are locked one by one, so result can be stale while other threads insert or remove.
+  [[nodiscard]] std::size_t Size() const;
+
+private:
+  static_assert(TShardCount > 0, "The number of shards must be bigger than 0.");
+
+  /// @struct DShard
+  /// @brief Shard of container. Aligned to cache line to avoid false-sharing of locks.
+  struct alignas(64) DShard final
+  {
+    mutable TLock mLock;
+    TSlotMap<TValue> mContainer;
+  };
+
+  /// @brief Get shard index of calling thread.
+  [[nodiscard]] static uint32_t GetThreadShardIndex() noexcept;
+
+  /// @brief Convert global key to local key of shard.
+  [[nodiscard]] static DSlotKey ToLocalKey(const DSlotKey& key) noexcept;
+
+  std::array<DShard, TShardCount> mShards;
+};
+#include <Inline/TShardedSlotMap.inl>
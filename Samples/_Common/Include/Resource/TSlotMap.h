@@ -0,0 +1,85 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <cstdint>
+#include <vector>
+#include <Resource/DSlotKey.h>
+
+/// @class TSlotMap
+/// @tparam TValue Value type. Must be move-constructible and move-assignable.
+/// @brief Generational slot map. 
+/// Values are stored densely in one array, and each key is index of indirection slot and its generation.
+/// Lookup is just two array accesses without hashing, and removed or reused slot can be detected 
+/// by comparing generation of key and slot.
+template <typename TValue>
+class TSlotMap final
+{
+public:
+  using TIterator = typename std::vector<TValue>::iterator;
+  using TConstIterator = typename std::vector<TValue>::const_iterator;
+
+  /// @brief Construct value in-place and return key of the value.
+  template <typename... TArgs>
+  [[nodiscard]] DSlotKey Emplace(TArgs&&... args);
+
+  /// @brief Check key is valid and value of key is exist in container.
+  [[nodiscard]] bool Has(const DSlotKey& key) const noexcept;
+
+  /// @brief Get value of given key. Key must be valid. (Checked by assertion)
+  TValue& Get(const DSlotKey& key);
+  /// @brief Get value of given key. Key must be valid. (Checked by assertion)
+  const TValue& Get(const DSlotKey& key) const;
+
+  /// @brief Get pointer of value of given key. If key is stale or invalid, return nullptr.
+  TValue* TryGet(const DSlotKey& key) noexcept;
+
+  /// @brief Remove value of given key. 
+  /// Last value is moved into the removed place to keep values packed.
+  /// @return If key is stale or invalid, return false.
+  bool Remove(const DSlotKey& key);
+
+  /// @brief Remove all values. All keys issued before will be stale.
+  void Clear();
+
+  /// @brief Get the number of values.
+  [[nodiscard]] std::size_t Size() const noexcept;
+
+  TIterator begin() noexcept { return this->mValues.begin(); }
+  TIterator end() noexcept { return this->mValues.end(); }
+  TConstIterator begin() const noexcept { return this->mValues.cbegin(); }
+  TConstIterator end() const noexcept { return this->mValues.cend(); }
+
+private:
+  /// @struct DSlot
+  /// @brief Indirection slot. 
+  /// When slot is not used, mValueIndex is index of next free slot.
+  struct DSlot final
+  {
+    uint32_t mValueIndex = DSlotKey::kInvalidIndex;
+    uint32_t mGeneration = 1;
+  };
+
+  /// @brief Increase generation of slot, and link slot to free list.
+  void ReleaseSlot(uint32_t slotIndex) noexcept;
+
+  /// @brief Indirection slots. Index of key points this.
+  std::vector<DSlot> mSlots;
+  /// @brief Packed values.
+  std::vector<TValue> mValues;
+  /// @brief Slot index of each value, for updating slot when value is moved.
+  std::vector<uint32_t> mValueSlots;
+  /// @brief Head of free slot list.
+  uint32_t mFreeHead = DSlotKey::kInvalidIndex;
+};
+#include <Inline/TSlotMap.inl>
@@ -0,0 +1,59 @@
+#pragma once
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @class FWorkerPool
+/// @brief Fixed-size pool of worker threads running queued tasks.
+class FWorkerPool final
+{
+public:
+  /// @brief Create pool with given worker count.
+  /// If workerCount is 0, hardware thread count - 1 workers are created
+  /// because calling thread also runs blocks of ParallelFor.
+  explicit FWorkerPool(std::size_t workerCount = 0);
+  ~FWorkerPool();
+
+  FWorkerPool(const FWorkerPool&) = delete;
+  FWorkerPool& operator=(const FWorkerPool&) = delete;
+
+  /// @brief Get the number of worker threads. Calling thread is not counted.
+  [[nodiscard]] std::size_t GetWorkerCount() const noexcept;
+
+  /// @brief Queue task to be run by one of workers.
+  void Enqueue(std::function<void()> task);
+
+  /// @brief Split [0, count) into blocks of blockSize items, and call task(begin, end) for each block.
+  /// Calling thread also runs blocks, and this function returns when all blocks are done.
+  /// Blocks are not run in order, so task must write only outputs of its own block.
+  void ParallelFor(
+    std::size_t count, std::size_t blockSize, 
+    const std::function<void(std::size_t, std::size_t)>& task);
+
+private:
+  /// @brief Run queued tasks until pool is destroyed.
+  void RunWorker();
+
+  std::vector<std::thread> mWorkers;
+  std::deque<std::function<void()>> mTasks;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  bool mIsStopping = false;
+};
@@ -13,115 +13,78 @@
 
 #include <Graphics/MD3D11Resources.h>
 
-#include <d3dcompiler.h>
-#include <APlatformBase.h>
-#include <FD3D11Factory.h>
 #include <HelperMacro.h>
-
-MD3D11Resources::THashMap<DD3DResourceDevice>         MD3D11Resources::mDevices; 
-MD3D11Resources::THashMap<IComOwner<IDXGISwapChain>>  MD3D11Resources::mSwapChains;
-MD3D11Resources::THashMap<IComOwner<ID3D11RenderTargetView>>  MD3D11Resources::mRTVs;
-MD3D11Resources::THashMap<IComOwner<ID3D11DepthStencilView>>  MD3D11Resources::mDSVs;
-MD3D11Resources::THashMap<IComOwner<ID3D11RasterizerState>>   MD3D11Resources::mRasterStates;
-MD3D11Resources::THashMap<IComOwner<ID3D11DepthStencilState>> MD3D11Resources::mDepthStencilStates;
-MD3D11Resources::THashMap<IComOwner<ID3D11BlendState>>        MD3D11Resources::mBlendStates;
-MD3D11Resources::THashMap<IComOwner<ID3D11VertexShader>>  MD3D11Resources::mVSs;
-MD3D11Resources::THashMap<IComOwner<ID3D11PixelShader>>   MD3D11Resources::mPSs;
-MD3D11Resources::THashMap<IComOwner<ID3D11InputLayout>>   MD3D11Resources::mInputLayouts;
-MD3D11Resources::THashMap<IComOwner<ID3D11Buffer>>    MD3D11Resources::mBuffers;
-MD3D11Resources::THashMap<IComOwner<ID3D11Texture2D>> MD3D11Resources::mTexture2Ds;
-MD3D11Resources::THashMap<IComOwner<ID3DBlob>>        MD3D11Resources::mBlobs;
-MD3D11Resources::THashMap<IComOwner<ID3D11Query>>     MD3D11Resources::mQueries;
+#include <Mock/FMockD3D11Factory.h>
+#include <Resource/D11DefaultHandles.h>
+
+MD3D11Resources::TContainer<DD3DResourceDevice>         MD3D11Resources::mDevices; 
+MD3D11Resources::TContainer<IComOwner<IDXGISwapChain>>  MD3D11Resources::mSwapChains;
+MD3D11Resources::TContainer<IComOwner<ID3D11RenderTargetView>>  MD3D11Resources::mRTVs;
+MD3D11Resources::TContainer<IComOwner<ID3D11DepthStencilView>>  MD3D11Resources::mDSVs;
+MD3D11Resources::TContainer<IComOwner<ID3D11RasterizerState>>   MD3D11Resources::mRasterStates;
+MD3D11Resources::TContainer<IComOwner<ID3D11DepthStencilState>> MD3D11Resources::mDepthStencilStates;
+MD3D11Resources::TContainer<IComOwner<ID3D11BlendState>>        MD3D11Resources::mBlendStates;
+MD3D11Resources::TContainer<IComOwner<ID3D11VertexShader>>  MD3D11Resources::mVSs;
+MD3D11Resources::TContainer<IComOwner<ID3D11PixelShader>>   MD3D11Resources::mPSs;
+MD3D11Resources::TContainer<IComOwner<ID3D11InputLayout>>   MD3D11Resources::mInputLayouts;
+MD3D11Resources::TContainer<IComOwner<ID3D11Buffer>>    MD3D11Resources::mBuffers;
+MD3D11Resources::TContainer<IComOwner<ID3D11Texture2D>> MD3D11Resources::mTexture2Ds;
+MD3D11Resources::TContainer<IComOwner<ID3DBlob>>        MD3D11Resources::mBlobs;
+MD3D11Resources::TContainer<IComOwner<ID3D11Query>>     MD3D11Resources::mQueries;
 
 //!
 //! Device
 //! 
 
 std::optional<D11HandleDevice> 
-MD3D11Resources::CreateD3D11DefaultDevice(dy::APlatformBase& platform)
+MD3D11Resources::CreateD3D11MockDevice(FMockCommandLog& deviceLog, FMockCommandLog& contextLog)
 {
-  IComOwner<ID3D11Device>         mD3DDevice            = nullptr;
-  IComOwner<ID3D11DeviceContext>  mD3DImmediateContext  = nullptr;
-  D3D_FEATURE_LEVEL               featureLevel;
-  
-  // Crate D3D11 Device & Context
-  UINT createDeviceFlags = 0;
-#if defined(DEBUG) || defined(_DEBUG)
-  createDeviceFlags |= D3D11_CREATE_DEVICE_DEBUG;
-#endif
-
-  // Make device. (physical? logical?)
-  decltype(mD3DDevice)::TPtrType pDevice = nullptr;
-  decltype(mD3DImmediateContext)::TPtrType pDc = nullptr;
-  HRESULT hr = D3D11CreateDevice(
-    nullptr,              // Default Adapter (Primary)
-    D3D_DRIVER_TYPE_HARDWARE, // Use hardware driver (Most optimal) 
-    nullptr,              // No Software device because we use TYPE_HARDWARE (D3D11).
-    createDeviceFlags,    // Set flags (DEBUG, SINGLETHREAD etc...)
-    nullptr,              // If no flag is exist, just pick up the highest version of SDK.
-    0,                    // Above argument brings the array of D3D_FEATURE, so we set it to 0 as nullptr. 
-    D3D11_SDK_VERSION,    // Always specify this.
-    &pDevice,             // Output
-    &featureLevel,        // Output
-    &pDc                  // Output
-  );
-  mD3DDevice = decltype(mD3DDevice){pDevice};
-  mD3DImmediateContext = decltype(mD3DImmediateContext){pDc};
-  
-  // Error checking.
-  if (FAILED(hr))
-  {
-    platform.GetDebugManager().OnAssertionFailed(
-      "D3D11CreateDevice Failed.\n", __FUNCTION__, __FILE__, __LINE__
-    );
-    return std::nullopt;
-  }
-  if (featureLevel != D3D_FEATURE_LEVEL_11_0)
+  return TThis::CreateD3D11MockDevice(deviceLog, contextLog, PMockD3D11Descriptor{});
+}
+
+std::optional<D11HandleDevice> 
+MD3D11Resources::CreateD3D11MockDevice(
+  FMockCommandLog& deviceLog, 
+  FMockCommandLog& contextLog, 
+  const PMockD3D11Descriptor& desc)
+{
+  ID3D11Device* pDevice = nullptr;
+  ID3D11DeviceContext* pDc = nullptr;
+  if (FAILED(FMockD3D11Factory::CreateDevice(deviceLog, contextLog, &pDevice, &pDc, desc)))
   {
-    platform.GetDebugManager().OnAssertionFailed(
-      "Direct3D Feature Level 11 unsupported.\n", __FUNCTION__, __FILE__, __LINE__
-    );
     return std::nullopt;
   }
 
   // Insert.
-  auto [it, isSucceeded] = mDevices.try_emplace(
-    ::dy::math::DUuid{true}, 
-    std::move(mD3DDevice), std::move(mD3DImmediateContext));
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mDevices.Emplace(
+    IComOwner<ID3D11Device>{pDevice}, IComOwner<ID3D11DeviceContext>{pDc});
 
-  return {uuid};
+  return {key};
 }
 
 bool MD3D11Resources::HasDevice(const D11HandleDevice& handle) noexcept
 {
-  return TThis::mDevices.find(handle.GetUuid()) != TThis::mDevices.end();
+  return TThis::mDevices.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11Device> MD3D11Resources::GetDevice(const D11HandleDevice& handle)
 {
-  assert(TThis::HasDevice(handle) == true);
-  
-  auto& object = TThis::mDevices.at(handle.GetUuid());
-  return object.mOwnDevice.GetBorrow();
+  return TThis::mDevices.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.mOwnDevice.GetBorrow(); });
 }
 
 IComBorrow<ID3D11DeviceContext> MD3D11Resources::GetDeviceContext(const D11HandleDevice& handle)
 {
-  assert(TThis::HasDevice(handle) == true);
-
-  auto& object = TThis::mDevices.at(handle.GetUuid());
-  return object.mOwnDc.GetBorrow();
+  return TThis::mDevices.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.mOwnDc.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveDevice(const D11HandleDevice& handle)
 {
-  // Validation check.
-  if (TThis::HasDevice(handle) == false) { return false; }
-
-  TThis::mDevices.erase(handle.GetUuid());
-  return true;
+  // Container checks and removes under one lock, so concurrent removal of same handle succeeds only once.
+  return TThis::mDevices.Remove(handle.GetKey());
 }
 
 //!
@@ -163,34 +126,27 @@ MD3D11Resources::CreateSwapChain(
   if (pSch == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mSwapChains.try_emplace(::dy::math::DUuid{true}, pSch);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mSwapChains.Emplace(pSch);
 
-  return {uuid};
+  return {key};
 }
 
 bool MD3D11Resources::HasSwapChain(const D11SwapChainHandle& handle) noexcept
 {
-  return TThis::mSwapChains.find(handle.GetUuid()) != TThis::mSwapChains.end();
+  return TThis::mSwapChains.Has(handle.GetKey());
 }
 
 IComBorrow<IDXGISwapChain> 
 MD3D11Resources::GetSwapChain(const D11SwapChainHandle& handle)
 {
-  assert(TThis::HasSwapChain(handle) == true);
-
-  auto& object = TThis::mSwapChains.at(handle.GetUuid());
-  return object.GetBorrow();  
+  return TThis::mSwapChains.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveSwapChain(const D11SwapChainHandle& handle)
 {
-  // Validation check.
-  if (TThis::HasSwapChain(handle) == false) { return false; }
-
-  TThis::mSwapChains.erase(handle.GetUuid());
-  return true;
+  return TThis::mSwapChains.Remove(handle.GetKey());
 }
 
 //!
@@ -224,33 +180,26 @@ MD3D11Resources::CreateRTVFromSwapChain(
   if (pRtv == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mRTVs.try_emplace(::dy::math::DUuid{true}, pRtv);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mRTVs.Emplace(pRtv);
 
-  return {uuid};
+  return {key};
 }
 
 bool MD3D11Resources::HasRTV(const D11HandleRTV& handle) noexcept
 {
-  return TThis::mRTVs.find(handle.GetUuid()) != TThis::mRTVs.end();
+  return TThis::mRTVs.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11RenderTargetView> MD3D11Resources::GetRTV(const D11HandleRTV& handle)
 {
-  assert(TThis::HasRTV(handle) == true);
-
-  auto& object = TThis::mRTVs.at(handle.GetUuid());
-  return object.GetBorrow();  
+  return TThis::mRTVs.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveRTV(const D11HandleRTV& handle)
 {
-  // Validation check.
-  if (TThis::HasRTV(handle) == false) { return false; }
-
-  TThis::mRTVs.erase(handle.GetUuid());
-  return true;
+  return TThis::mRTVs.Remove(handle.GetKey());
 }
 
 //!
@@ -277,33 +226,26 @@ MD3D11Resources::CreateDSV(
   if (pDsv == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mDSVs.try_emplace(::dy::math::DUuid{true}, pDsv);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mDSVs.Emplace(pDsv);
 
-  return {uuid};
+  return {key};
 }
 
 bool MD3D11Resources::HasDSV(const D11HandleDSV& handle) noexcept
 {
-  return TThis::mDSVs.find(handle.GetUuid()) != TThis::mDSVs.end();
+  return TThis::mDSVs.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11DepthStencilView> MD3D11Resources::GetDSV(const D11HandleDSV& handle)
 {
-  assert(TThis::HasDSV(handle) == true);
-
-  auto& object = TThis::mDSVs.at(handle.GetUuid());
-  return object.GetBorrow();  
+  return TThis::mDSVs.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveDSV(const D11HandleDSV& handle)
 {
-  // Validation check.
-  if (TThis::HasDSV(handle) == false) { return false; }
-
-  TThis::mDSVs.erase(handle.GetUuid());
-  return true;
+  return TThis::mDSVs.Remove(handle.GetKey());
 }
 
 //!
@@ -325,34 +267,27 @@ MD3D11Resources::CreateRasterState(const D11HandleDevice& hDevice, const D3D11_R
   if (pRasterState == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mRasterStates.try_emplace(::dy::math::DUuid{true}, pRasterState);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mRasterStates.Emplace(pRasterState);
 
-  return {uuid};
+  return {key};
 }
 
 bool MD3D11Resources::HasRasterState(const D11HandleRasterState& handle) noexcept
 {
-  return TThis::mRasterStates.find(handle.GetUuid()) != TThis::mRasterStates.end();
+  return TThis::mRasterStates.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11RasterizerState> 
 MD3D11Resources::GetRasterState(const D11HandleRasterState& handle)
 {
-  assert(TThis::HasRasterState(handle) == true);
-
-  auto& object = TThis::mRasterStates.at(handle.GetUuid());
-  return object.GetBorrow(); 
+  return TThis::mRasterStates.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveRasterState(const D11HandleRasterState& handle)
 {
-  // Validation check.
-  if (TThis::HasRasterState(handle) == false) { return false; }
-
-  TThis::mRasterStates.erase(handle.GetUuid());
-  return true;
+  return TThis::mRasterStates.Remove(handle.GetKey());
 }
 
 //!
@@ -375,34 +310,27 @@ MD3D11Resources::CreateDepthStencilState(
   if (pDss == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mDepthStencilStates.try_emplace(::dy::math::DUuid{true}, pDss);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mDepthStencilStates.Emplace(pDss);
 
-  return {uuid};
+  return {key};
 }
 
 bool MD3D11Resources::HasDepthStencilState(const D11HandleDepthStencilState& handle) noexcept
 {
-  return TThis::mDepthStencilStates.find(handle.GetUuid()) != TThis::mDepthStencilStates.end();
+  return TThis::mDepthStencilStates.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11DepthStencilState> 
 MD3D11Resources::GetDepthStencilState(const D11HandleDepthStencilState& handle)
 {
-  assert(TThis::HasDepthStencilState(handle) == true);
-
-  auto& object = TThis::mDepthStencilStates.at(handle.GetUuid());
-  return object.GetBorrow(); 
+  return TThis::mDepthStencilStates.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveDepthStencilState(const D11HandleDepthStencilState& handle)
 {
-  // Validation check.
-  if (TThis::HasDepthStencilState(handle) == false) { return false; }
-
-  TThis::mDepthStencilStates.erase(handle.GetUuid());
-  return true;
+  return TThis::mDepthStencilStates.Remove(handle.GetKey());
 }
 
 //!
@@ -424,34 +352,27 @@ MD3D11Resources::CreateBlendState(const D11HandleDevice& hDevice, const D3D11_BL
   if (pBlend == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mBlendStates.try_emplace(::dy::math::DUuid{true}, pBlend);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mBlendStates.Emplace(pBlend);
 
-  return {uuid};
+  return {key};
 }
 
 bool MD3D11Resources::HasBlendState(const D11HandleBlendState& handle) noexcept
 {
-  return TThis::mBlendStates.find(handle.GetUuid()) != TThis::mBlendStates.end();
+  return TThis::mBlendStates.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11BlendState> 
 MD3D11Resources::GetBlendState(const D11HandleBlendState& handle)
 {
-  assert(TThis::HasBlendState(handle) == true);
-
-  auto& object = TThis::mBlendStates.at(handle.GetUuid());
-  return object.GetBorrow(); 
+  return TThis::mBlendStates.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveBlendState(const D11HandleBlendState& handle)
 {
-  // Validation check.
-  if (TThis::HasBlendState(handle) == false) { return false; }
-
-  TThis::mBlendStates.erase(handle.GetUuid());
-  return true;
+  return TThis::mBlendStates.Remove(handle.GetKey());
 }
 
 //!
@@ -486,33 +407,26 @@ MD3D11Resources::CreateTexture2D(
   if (pTexture2d == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mTexture2Ds.try_emplace(::dy::math::DUuid{true}, pTexture2d);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mTexture2Ds.Emplace(pTexture2d);
 
-  return {uuid};
+  return {key};
 }
 
 bool MD3D11Resources::HasTexture2D(const D11HandleTexture2D& handle)
 {
-  return TThis::mTexture2Ds.find(handle.GetUuid()) != TThis::mTexture2Ds.end();
+  return TThis::mTexture2Ds.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11Texture2D> MD3D11Resources::GetTexture2D(const D11HandleTexture2D& handle)
 {
-  assert(TThis::HasTexture2D(handle) == true);
-
-  auto& object = TThis::mTexture2Ds.at(handle.GetUuid());
-  return object.GetBorrow();  
+  return TThis::mTexture2Ds.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveTexture2D(const D11HandleTexture2D& handle)
 {
-  // Validation check.
-  if (TThis::HasTexture2D(handle) == false) { return false; }
-
-  TThis::mTexture2Ds.erase(handle.GetUuid());
-  return true;
+  return TThis::mTexture2Ds.Remove(handle.GetKey());
 }
 
 //!
@@ -549,61 +463,32 @@ MD3D11Resources::CreateBuffer(
   if (pBuffer == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mBuffers.try_emplace(::dy::math::DUuid{true}, pBuffer);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mBuffers.Emplace(pBuffer);
 
-  return {uuid}; 
+  return {key}; 
 }
 
 bool MD3D11Resources::HasBuffer(const D11HandleBuffer& handle)
 {
-  return TThis::mBuffers.find(handle.GetUuid()) != TThis::mBuffers.end();
+  return TThis::mBuffers.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11Buffer> MD3D11Resources::GetBuffer(const D11HandleBuffer& handle)
 {
-  assert(TThis::HasBuffer(handle) == true);
-
-  auto& object = TThis::mBuffers.at(handle.GetUuid());
-  return object.GetBorrow();  
+  return TThis::mBuffers.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveBuffer(const D11HandleBuffer& handle)
 {
-  // Validation check.
-  if (TThis::HasBuffer(handle) == false) { return false; }
-
-  TThis::mBuffers.erase(handle.GetUuid());
-  return true;
+  return TThis::mBuffers.Remove(handle.GetKey());
 }
 
 //!
 //! Blob
 //!
 
-std::optional<D11HandleBlob>
-MD3D11Resources::CreateBlob(const D11HandleDevice& hDevice, const std::size_t byteSize)
-{
-  // Validation check.
-  if (TThis::HasDevice(hDevice) == false) { return std::nullopt; }
-  auto device = TThis::GetDevice(hDevice);
-  
-  // Create ID3D11Blob Resource.
-  ID3DBlob* pBlob = nullptr;
-  HR(D3DCreateBlob(byteSize, &pBlob));
-
-  // If blob is null, just return nullopt.
-  if (pBlob == nullptr) { return std::nullopt; }
-
-  // Insert.
-  auto [it, isSucceeded] = TThis::mBlobs.try_emplace(::dy::math::DUuid{true}, pBlob);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
-
-  return {uuid}; 
-}
-
 std::optional<D11HandleBlob>
 MD3D11Resources::InsertRawBlob(ID3DBlob*& pRawBlob)
 {
@@ -611,34 +496,27 @@ MD3D11Resources::InsertRawBlob(ID3DBlob*& pRawBlob)
   if (pRawBlob == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mBlobs.try_emplace(::dy::math::DUuid{true}, pRawBlob);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mBlobs.Emplace(pRawBlob);
 
   pRawBlob = nullptr;
-  return {uuid}; 
+  return {key}; 
 }
 
 bool MD3D11Resources::HasBlob(const D11HandleBlob& handle)
 {
-  return TThis::mBlobs.find(handle.GetUuid()) != TThis::mBlobs.end();
+  return TThis::mBlobs.Has(handle.GetKey());
 }
 
 IComBorrow<ID3DBlob> MD3D11Resources::GetBlob(const D11HandleBlob& handle)
 {
-  assert(TThis::HasBlob(handle) == true);
-
-  auto& object = TThis::mBlobs.at(handle.GetUuid());
-  return object.GetBorrow();  
+  return TThis::mBlobs.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveBlob(const D11HandleBlob& handle)
 {
-  // Validation check.
-  if (TThis::HasBlob(handle) == false) { return false; }
-
-  TThis::mBlobs.erase(handle.GetUuid());
-  return true;
+  return TThis::mBlobs.Remove(handle.GetKey());
 }
 
 //!
@@ -663,33 +541,26 @@ MD3D11Resources::CreateVertexShader(const D11HandleDevice& hDevice, const D11Han
   if (pVS == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mVSs.try_emplace(::dy::math::DUuid{true}, pVS);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mVSs.Emplace(pVS);
 
-  return {uuid}; 
+  return {key}; 
 }
 
 bool MD3D11Resources::HasVertexShader(const D11HandleVS& handle)
 {
-  return TThis::mVSs.find(handle.GetUuid()) != TThis::mVSs.end();
+  return TThis::mVSs.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11VertexShader> MD3D11Resources::GetVertexShader(const D11HandleVS& handle)
 {
-  assert(TThis::HasVertexShader(handle) == true);
-
-  auto& object = TThis::mVSs.at(handle.GetUuid());
-  return object.GetBorrow();  
+  return TThis::mVSs.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveVertexShader(const D11HandleVS& handle)
 {
-  // Validation check.
-  if (TThis::HasVertexShader(handle) == false) { return false; }
-
-  TThis::mVSs.erase(handle.GetUuid());
-  return true;
+  return TThis::mVSs.Remove(handle.GetKey());
 }
 
 //!
@@ -714,33 +585,26 @@ MD3D11Resources::CreatePixelShader(const D11HandleDevice& hDevice, const D11Hand
   if (pPS == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mPSs.try_emplace(::dy::math::DUuid{true}, pPS);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mPSs.Emplace(pPS);
 
-  return {uuid}; 
+  return {key}; 
 }
 
 bool MD3D11Resources::HasPixelShader(const D11HandlePS& handle)
 {
-  return TThis::mPSs.find(handle.GetUuid()) != TThis::mPSs.end();
+  return TThis::mPSs.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11PixelShader> MD3D11Resources::GetPixelShader(const D11HandlePS& handle)
 {
-  assert(TThis::HasPixelShader(handle) == true);
-
-  auto& object = TThis::mPSs.at(handle.GetUuid());
-  return object.GetBorrow();  
+  return TThis::mPSs.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemovePixelShader(const D11HandlePS& handle)
 {
-  // Validation check.
-  if (TThis::HasPixelShader(handle) == false) { return false; }
-
-  TThis::mPSs.erase(handle.GetUuid());
-  return true;
+  return TThis::mPSs.Remove(handle.GetKey());
 }
 
 //!
@@ -769,33 +633,26 @@ MD3D11Resources::CreateInputLayout(
   if (pIL == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mInputLayouts.try_emplace(::dy::math::DUuid{true}, pIL);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mInputLayouts.Emplace(pIL);
 
-  return {uuid};   
+  return {key};   
 }
 
 bool MD3D11Resources::HasInputLayout(const D11HandleInputLayout& handle)
 {
-  return TThis::mInputLayouts.find(handle.GetUuid()) != TThis::mInputLayouts.end();
+  return TThis::mInputLayouts.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11InputLayout> MD3D11Resources::GetInputLayout(const D11HandleInputLayout& handle)
 {
-  assert(TThis::HasInputLayout(handle) == true);
-
-  auto& object = TThis::mInputLayouts.at(handle.GetUuid());
-  return object.GetBorrow();  
+  return TThis::mInputLayouts.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveInputLayout(const D11HandleInputLayout& handle)
 {
-  // Validation check.
-  if (TThis::HasInputLayout(handle) == false) { return false; }
-
-  TThis::mInputLayouts.erase(handle.GetUuid());
-  return true;
+  return TThis::mInputLayouts.Remove(handle.GetKey());
 }
 
 //!
@@ -817,11 +674,9 @@ MD3D11Resources::CreateQuery(const D11HandleDevice& hDevice, const D3D11_QUERY_D
   if (pQuery == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mQueries.try_emplace(::dy::math::DUuid{true}, pQuery);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mQueries.Emplace(pQuery);
 
-  return {uuid}; 
+  return {key}; 
 }
 
 std::optional<D11HandleQuery>
@@ -832,16 +687,17 @@ MD3D11Resources::CreateQuerySimple(const D11HandleDevice& hDevice, E11SimpleQuer
   auto device = TThis::GetDevice(hDevice);
 
   // Create ID3D11Query Resource.
+  // Same descriptors as FD3D11Factory::GetDefaultTimeStamp(Disjoint|Fragment)QueryDesc.
   D3D11_QUERY_DESC desc = {};
   switch (type)
   {
   case E11SimpleQueryType::TimeStampDisjoint:
   {
-    desc = FD3D11Factory::GetDefaultTimeStampDisjointQueryDesc();
+    desc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
   } break;
   case E11SimpleQueryType::TimeStampFragment:
   {
-    desc = FD3D11Factory::GetDefaultTimeStampFragmentQueryDesc();
+    desc.Query = D3D11_QUERY_TIMESTAMP;
   } break;
   }
 
@@ -851,33 +707,26 @@ MD3D11Resources::CreateQuerySimple(const D11HandleDevice& hDevice, E11SimpleQuer
   if (pQuery == nullptr) { return std::nullopt; }
 
   // Insert.
-  auto [it, isSucceeded] = TThis::mQueries.try_emplace(::dy::math::DUuid{true}, pQuery);
-  assert(isSucceeded == true);
-  const auto& [uuid, pOwner] = *it;
+  const auto key = TThis::mQueries.Emplace(pQuery);
 
-  return {uuid}; 
+  return {key}; 
 }
 
 bool MD3D11Resources::HasQuery(const D11HandleQuery& handle)
 {
-  return TThis::mQueries.find(handle.GetUuid()) != TThis::mQueries.end();
+  return TThis::mQueries.Has(handle.GetKey());
 }
 
 IComBorrow<ID3D11Query> MD3D11Resources::GetQuery(const D11HandleQuery& handle)
 {
-  assert(TThis::HasQuery(handle) == true);
-
-  auto& object = TThis::mQueries.at(handle.GetUuid());
-  return object.GetBorrow();  
+  return TThis::mQueries.Visit(
+    handle.GetKey(), 
+    [](auto& object) { return object.GetBorrow(); });
 }
 
 bool MD3D11Resources::RemoveQuery(const D11HandleQuery& handle)
 {
-  // Validation check.
-  if (TThis::HasQuery(handle) == false) { return false; }
-
-  TThis::mQueries.erase(handle.GetUuid());
-  return true;
+  return TThis::mQueries.Remove(handle.GetKey());
 }
 
 //!
@@ -934,3 +783,25 @@ bool MD3D11Resources::RemoveDefaultFrameBufferResouce(const D11DefaultHandles& h
   }
   return true;
 }
+
+std::size_t MD3D11Resources::GetResourceCount(ED3D11Resc type)
+{
+  switch (type)
+  {
+  case ED3D11Resc::Device:            { return TThis::mDevices.Size(); }
+  case ED3D11Resc::SwapChain:         { return TThis::mSwapChains.Size(); }
+  case ED3D11Resc::RTV:               { return TThis::mRTVs.Size(); }
+  case ED3D11Resc::DSV:               { return TThis::mDSVs.Size(); }
+  case ED3D11Resc::RasterizerState:   { return TThis::mRasterStates.Size(); }
+  case ED3D11Resc::DepthStencilState: { return TThis::mDepthStencilStates.Size(); }
+  case ED3D11Resc::BlendState:        { return TThis::mBlendStates.Size(); }
+  case ED3D11Resc::VertexShader:      { return TThis::mVSs.Size(); }
+  case ED3D11Resc::PixelShader:       { return TThis::mPSs.Size(); }
+  case ED3D11Resc::InputLayout:       { return TThis::mInputLayouts.Size(); }
+  case ED3D11Resc::Buffer:            { return TThis::mBuffers.Size(); }
+  case ED3D11Resc::Texture2D:         { return TThis::mTexture2Ds.Size(); }
+  case ED3D11Resc::Blob:              { return TThis::mBlobs.Size(); }
+  case ED3D11Resc::Query:             { return TThis::mQueries.Size(); }
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+/// Functions of MD3D11Resources which call D3D11 and D3DCompiler runtime libraries.
+/// Other functions only use interfaces of created device, so they can be built and tested with mock device.
+#include <Graphics/MD3D11Resources.h>
+
+#include <d3dcompiler.h>
+#include <APlatformBase.h>
+#include <HelperMacro.h>
+
+//!
+//! Device
+//! 
+
+std::optional<D11HandleDevice> 
+MD3D11Resources::CreateD3D11DefaultDevice(dy::APlatformBase& platform)
+{
+  IComOwner<ID3D11Device>         mD3DDevice            = nullptr;
+  IComOwner<ID3D11DeviceContext>  mD3DImmediateContext  = nullptr;
+  D3D_FEATURE_LEVEL               featureLevel;
+  
+  // Crate D3D11 Device & Context
+  UINT createDeviceFlags = 0;
+#if defined(DEBUG) || defined(_DEBUG)
+  createDeviceFlags |= D3D11_CREATE_DEVICE_DEBUG;
+#endif
+
+  // Make device. (physical? logical?)
+  decltype(mD3DDevice)::TPtrType pDevice = nullptr;
+  decltype(mD3DImmediateContext)::TPtrType pDc = nullptr;
+  HRESULT hr = D3D11CreateDevice(
+    nullptr,              // Default Adapter (Primary)
+    D3D_DRIVER_TYPE_HARDWARE, // Use hardware driver (Most optimal) 
+    nullptr,              // No Software device because we use TYPE_HARDWARE (D3D11).
+    createDeviceFlags,    // Set flags (DEBUG, SINGLETHREAD etc...)
+    nullptr,              // If no flag is exist, just pick up the highest version of SDK.
+    0,                    // Above argument brings the array of D3D_FEATURE, so we set it to 0 as nullptr. 
+    D3D11_SDK_VERSION,    // Always specify this.
+    &pDevice,             // Output
+    &featureLevel,        // Output
+    &pDc                  // Output
+  );
+  mD3DDevice = decltype(mD3DDevice){pDevice};
+  mD3DImmediateContext = decltype(mD3DImmediateContext){pDc};
+  
+  // Error checking.
+  if (FAILED(hr))
+  {
+    platform.GetDebugManager().OnAssertionFailed(
+      "D3D11CreateDevice Failed.\n", __FUNCTION__, __FILE__, __LINE__
+    );
+    return std::nullopt;
+  }
+  if (featureLevel != D3D_FEATURE_LEVEL_11_0)
+  {
+    platform.GetDebugManager().OnAssertionFailed(
+      "Direct3D Feature Level 11 unsupported.\n", __FUNCTION__, __FILE__, __LINE__
+    );
+    return std::nullopt;
+  }
+
+  // Insert.
+  const auto key = TThis::mDevices.Emplace(
+    std::move(mD3DDevice), std::move(mD3DImmediateContext));
+
+  return {key};
+}
+
+//!
+//! Blob
+//!
+
+std::optional<D11HandleBlob>
+MD3D11Resources::CreateBlob(const D11HandleDevice& hDevice, const std::size_t byteSize)
+{
+  // Validation check.
+  if (TThis::HasDevice(hDevice) == false) { return std::nullopt; }
+  auto device = TThis::GetDevice(hDevice);
+  
+  // Create ID3D11Blob Resource.
+  ID3DBlob* pBlob = nullptr;
+  HR(D3DCreateBlob(byteSize, &pBlob));
+
+  // If blob is null, just return nullopt.
+  if (pBlob == nullptr) { return std::nullopt; }
+
+  // Insert.
+  const auto key = TThis::mBlobs.Emplace(pBlob);
+
+  return {key}; 
+}
@@ -0,0 +1,123 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <Mock/FMockCommandLog.h>
+
+#include <sstream>
+
+const char* ToString(EMockD3D11Call call) noexcept
+{
+  switch (call)
+  {
+  case EMockD3D11Call::CreateBuffer: return "CreateBuffer";
+  case EMockD3D11Call::CreateTexture2D: return "CreateTexture2D";
+  case EMockD3D11Call::CreateRenderTargetView: return "CreateRenderTargetView";
+  case EMockD3D11Call::CreateDepthStencilView: return "CreateDepthStencilView";
+  case EMockD3D11Call::CreateInputLayout: return "CreateInputLayout";
+  case EMockD3D11Call::CreateVertexShader: return "CreateVertexShader";
+  case EMockD3D11Call::CreatePixelShader: return "CreatePixelShader";
+  case EMockD3D11Call::CreateBlendState: return "CreateBlendState";
+  case EMockD3D11Call::CreateDepthStencilState: return "CreateDepthStencilState";
+  case EMockD3D11Call::CreateRasterizerState: return "CreateRasterizerState";
+  case EMockD3D11Call::CreateSamplerState: return "CreateSamplerState";
+  case EMockD3D11Call::CreateQuery: return "CreateQuery";
+  case EMockD3D11Call::IASetInputLayout: return "IASetInputLayout";
+  case EMockD3D11Call::IASetVertexBuffers: return "IASetVertexBuffers";
+  case EMockD3D11Call::IASetIndexBuffer: return "IASetIndexBuffer";
+  case EMockD3D11Call::IASetPrimitiveTopology: return "IASetPrimitiveTopology";
+  case EMockD3D11Call::VSSetShader: return "VSSetShader";
+  case EMockD3D11Call::VSSetConstantBuffers: return "VSSetConstantBuffers";
+  case EMockD3D11Call::PSSetShader: return "PSSetShader";
+  case EMockD3D11Call::PSSetConstantBuffers: return "PSSetConstantBuffers";
+  case EMockD3D11Call::PSSetShaderResources: return "PSSetShaderResources";
+  case EMockD3D11Call::PSSetSamplers: return "PSSetSamplers";
+  case EMockD3D11Call::RSSetState: return "RSSetState";
+  case EMockD3D11Call::RSSetViewports: return "RSSetViewports";
+  case EMockD3D11Call::RSSetScissorRects: return "RSSetScissorRects";
+  case EMockD3D11Call::OMSetRenderTargets: return "OMSetRenderTargets";
+  case EMockD3D11Call::OMSetBlendState: return "OMSetBlendState";
+  case EMockD3D11Call::OMSetDepthStencilState: return "OMSetDepthStencilState";
+  case EMockD3D11Call::ClearRenderTargetView: return "ClearRenderTargetView";
+  case EMockD3D11Call::ClearDepthStencilView: return "ClearDepthStencilView";
+  case EMockD3D11Call::UpdateSubresource: return "UpdateSubresource";
+  case EMockD3D11Call::Map: return "Map";
+  case EMockD3D11Call::Unmap: return "Unmap";
+  case EMockD3D11Call::CopyResource: return "CopyResource";
+  case EMockD3D11Call::Draw: return "Draw";
+  case EMockD3D11Call::DrawIndexed: return "DrawIndexed";
+  case EMockD3D11Call::DrawInstanced: return "DrawInstanced";
+  case EMockD3D11Call::DrawIndexedInstanced: return "DrawIndexedInstanced";
+  case EMockD3D11Call::Begin: return "Begin";
+  case EMockD3D11Call::End: return "End";
+  case EMockD3D11Call::GetData: return "GetData";
+  case EMockD3D11Call::ClearState: return "ClearState";
+  case EMockD3D11Call::Flush: return "Flush";
+  case EMockD3D11Call::Unsupported: return "Unsupported";
+  default: return "";
+  }
+}
+
+void FMockCommandLog::SetRecording(bool isRecording) noexcept
+{
+  this->mIsRecording = isRecording;
+}
+
+void FMockCommandLog::Clear() noexcept
+{
+  this->mCommands.clear();
+  this->mCounts.fill(0);
+  this->mVertexCount = 0;
+  this->mUploadedBytes = 0;
+}
+
+const std::vector<DMockCommand>& FMockCommandLog::GetCommands() const noexcept
+{
+  return this->mCommands;
+}
+
+uint64_t FMockCommandLog::GetCount(EMockD3D11Call call) const noexcept
+{
+  if (call == EMockD3D11Call::__Sum) { return 0; }
+  return this->mCounts[static_cast<size_t>(call)];
+}
+
+uint64_t FMockCommandLog::GetDrawCallCount() const noexcept
+{
+  return this->GetCount(EMockD3D11Call::Draw)
+    + this->GetCount(EMockD3D11Call::DrawIndexed)
+    + this->GetCount(EMockD3D11Call::DrawInstanced)
+    + this->GetCount(EMockD3D11Call::DrawIndexedInstanced);
+}
+
+uint64_t FMockCommandLog::GetDrawnPrimitiveVertexCount() const noexcept
+{
+  return this->mVertexCount;
+}
+
+uint64_t FMockCommandLog::GetUploadedBytes() const noexcept
+{
+  return this->mUploadedBytes;
+}
+
+std::string FMockCommandLog::GetSummary() const
+{
+  std::ostringstream stream;
+  for (size_t i = 0; i < kCallCount; ++i)
+  {
+    if (this->mCounts[i] == 0) { continue; }
+    stream << ToString(static_cast<EMockD3D11Call>(i)) << " : " << this->mCounts[i] << '\n';
+  }
+  stream << "Uploaded bytes : " << this->mUploadedBytes << '\n';
+
+  return stream.str();
+}
@@ -0,0 +1,1344 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <Mock/FMockD3D11Factory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include <Mock/FMockCommandLog.h>
+
+namespace
+{
+
+/// @brief Get byte size of one pixel of given format.
+/// Block-compressed and packed video formats are not supported, and regarded as 4 bytes.
+UINT GetFormatByteSize(DXGI_FORMAT format) noexcept
+{
+  if (format == DXGI_FORMAT_UNKNOWN)                      { return 0; }
+  if (format <= DXGI_FORMAT_R32G32B32A32_SINT)            { return 16; }
+  if (format <= DXGI_FORMAT_R32G32B32_SINT)               { return 12; }
+  if (format <= DXGI_FORMAT_X32_TYPELESS_G8X24_UINT)      { return 8; }
+  if (format <= DXGI_FORMAT_X24_TYPELESS_G8_UINT)         { return 4; }
+  if (format <= DXGI_FORMAT_R16_SINT)                     { return 2; }
+  if (format <= DXGI_FORMAT_A8_UNORM)                     { return 1; }
+  return 4;
+}
+
+/// @class DMockPrivateData
+/// @brief Private data container of mock D3D11 objects.
+class DMockPrivateData final
+{
+public:
+  ~DMockPrivateData()
+  {
+    for (auto& item : this->mItems) 
+    { 
+      if (item.mInterface != nullptr) { item.mInterface->Release(); }
+    }
+  }
+
+  HRESULT Get(REFGUID guid, UINT* pDataSize, void* pData)
+  {
+    if (pDataSize == nullptr) { return E_INVALIDARG; }
+
+    std::lock_guard<std::mutex> lock{this->mMutex};
+    const auto it = std::find_if(
+      this->mItems.begin(), this->mItems.end(), 
+      [&guid](const DItem& item) { return item.mGuid == guid; });
+    if (it == this->mItems.end())
+    {
+      *pDataSize = 0;
+      return DXGI_ERROR_NOT_FOUND;
+    }
+
+    const auto size = static_cast<UINT>(it->mData.size());
+    if (pData == nullptr)
+    {
+      *pDataSize = size;
+      return S_OK;
+    }
+    if (*pDataSize < size)
+    {
+      *pDataSize = size;
+      return DXGI_ERROR_MORE_DATA;
+    }
+
+    std::memcpy(pData, it->mData.data(), size);
+    if (it->mInterface != nullptr) { it->mInterface->AddRef(); }
+    *pDataSize = size;
+    return S_OK;
+  }
+
+  HRESULT Set(REFGUID guid, UINT dataSize, const void* pData, IUnknown* pInterface = nullptr)
+  {
+    std::lock_guard<std::mutex> lock{this->mMutex};
+    auto it = std::find_if(
+      this->mItems.begin(), this->mItems.end(), 
+      [&guid](const DItem& item) { return item.mGuid == guid; });
+    if (it != this->mItems.end())
+    {
+      if (it->mInterface != nullptr) { it->mInterface->Release(); }
+      this->mItems.erase(it);
+    }
+    if (pData == nullptr) { return S_OK; }
+
+    DItem item;
+    item.mGuid = guid;
+    item.mData.assign(
+      static_cast<const char*>(pData), 
+      static_cast<const char*>(pData) + dataSize);
+    item.mInterface = pInterface;
+    if (pInterface != nullptr) { pInterface->AddRef(); }
+    this->mItems.emplace_back(std::move(item));
+    return S_OK;
+  }
+
+  HRESULT SetInterface(REFGUID guid, const IUnknown* pData)
+  {
+    auto* pInterface = const_cast<IUnknown*>(pData);
+    return this->Set(guid, sizeof(pInterface), pData == nullptr ? nullptr : &pInterface, pInterface);
+  }
+
+private:
+  struct DItem final
+  {
+    GUID mGuid = {};
+    std::vector<char> mData;
+    IUnknown* mInterface = nullptr;
+  };
+
+  std::mutex mMutex;
+  std::vector<DItem> mItems;
+};
+
+/// @class TMockChild
+/// @brief Base type of mock D3D11 objects which implements IUnknown and ID3D11DeviceChild.
+template <typename TInterface>
+class TMockChild : public TInterface
+{
+public:
+  TMockChild(ID3D11Device* pDevice, uint32_t id) 
+    : mDevice{pDevice}, 
+      mId{id} 
+  { }
+  virtual ~TMockChild() = default;
+
+  /// @brief Get mock object id, which is recorded into command log.
+  uint32_t GetId() const noexcept { return this->mId; }
+
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+  {
+    if (ppvObject == nullptr) { return E_POINTER; }
+
+    bool isSupported = riid == __uuidof(IUnknown) 
+      || riid == __uuidof(ID3D11DeviceChild) 
+      || riid == __uuidof(TInterface);
+    if constexpr (std::is_base_of_v<ID3D11Resource, TInterface> == true)
+    {
+      isSupported = isSupported || riid == __uuidof(ID3D11Resource);
+    }
+    if constexpr (std::is_base_of_v<ID3D11View, TInterface> == true)
+    {
+      isSupported = isSupported || riid == __uuidof(ID3D11View);
+    }
+    if constexpr (std::is_base_of_v<ID3D11Asynchronous, TInterface> == true)
+    {
+      isSupported = isSupported || riid == __uuidof(ID3D11Asynchronous);
+    }
+
+    if (isSupported == false)
+    {
+      *ppvObject = nullptr;
+      return E_NOINTERFACE;
+    }
+
+    this->AddRef();
+    *ppvObject = static_cast<TInterface*>(this);
+    return S_OK;
+  }
+
+  ULONG STDMETHODCALLTYPE AddRef() override
+  {
+    return ++this->mCounter;
+  }
+
+  ULONG STDMETHODCALLTYPE Release() override
+  {
+    const ULONG count = --this->mCounter;
+    if (count == 0) { delete this; }
+    return count;
+  }
+
+  void STDMETHODCALLTYPE GetDevice(ID3D11Device** ppDevice) override
+  {
+    this->mDevice->AddRef();
+    *ppDevice = this->mDevice;
+  }
+
+  HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) override
+  {
+    return this->mPrivateData.Get(guid, pDataSize, pData);
+  }
+
+  HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) override
+  {
+    return this->mPrivateData.Set(guid, DataSize, pData);
+  }
+
+  HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) override
+  {
+    return this->mPrivateData.SetInterface(guid, pData);
+  }
+
+protected:
+  ID3D11Device* mDevice = nullptr;
+
+private:
+  uint32_t mId = 0;
+  std::atomic<ULONG> mCounter = 1;
+  DMockPrivateData mPrivateData;
+};
+
+/// @brief Get mock object id of given object. If nullptr, return 0.
+/// Given object must be created from mock device.
+template <typename TInterface>
+uint32_t GetMockId(TInterface* pObject) noexcept
+{
+  if (pObject == nullptr) { return 0; }
+  return static_cast<TMockChild<TInterface>*>(pObject)->GetId();
+}
+
+/// @brief Get mock object id of first item of given array. If not exist, return 0.
+template <typename TInterface>
+uint32_t GetFirstMockId(TInterface* const* ppObjects, UINT count) noexcept
+{
+  if (ppObjects == nullptr || count == 0) { return 0; }
+  return GetMockId(ppObjects[0]);
+}
+
+/// @class TMockResource
+/// @brief Mock resource type which has CPU-side storage.
+template <typename TInterface, D3D11_RESOURCE_DIMENSION TDimension, typename TDesc>
+class TMockResource final : public TMockChild<TInterface>
+{
+public:
+  TMockResource(ID3D11Device* pDevice, uint32_t id, const TDesc& desc, size_t byteSize, UINT rowPitch)
+    : TMockChild<TInterface>{pDevice, id},
+      mDesc{desc},
+      mData(byteSize, 0),
+      mRowPitch{rowPitch}
+  { }
+
+  void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* pResourceDimension) override
+  {
+    *pResourceDimension = TDimension;
+  }
+
+  void STDMETHODCALLTYPE SetEvictionPriority(UINT EvictionPriority) override
+  {
+    this->mEvictionPriority = EvictionPriority;
+  }
+
+  UINT STDMETHODCALLTYPE GetEvictionPriority() override
+  {
+    return this->mEvictionPriority;
+  }
+
+  void STDMETHODCALLTYPE GetDesc(TDesc* pDesc) override
+  {
+    *pDesc = this->mDesc;
+  }
+
+  TDesc mDesc;
+  std::vector<uint8_t> mData;
+  UINT mRowPitch = 0;
+  UINT mEvictionPriority = 0;
+};
+
+using FMockBuffer     = TMockResource<ID3D11Buffer, D3D11_RESOURCE_DIMENSION_BUFFER, D3D11_BUFFER_DESC>;
+using FMockTexture2D  = TMockResource<ID3D11Texture2D, D3D11_RESOURCE_DIMENSION_TEXTURE2D, D3D11_TEXTURE2D_DESC>;
+
+/// @struct DMockStorage
+/// @brief CPU-side storage reference of mock resource.
+struct DMockStorage final
+{
+  uint32_t mId = 0;
+  std::vector<uint8_t>* mData = nullptr;
+  UINT mRowPitch = 0;
+  UINT mHeight = 0;
+  UINT mPixelSize = 0;
+};
+
+/// @brief Get storage of given mock resource. 
+/// If resource is nullptr or not supported, return empty storage.
+DMockStorage GetStorage(ID3D11Resource* pResource)
+{
+  if (pResource == nullptr) { return {}; }
+
+  D3D11_RESOURCE_DIMENSION type = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+  pResource->GetType(&type);
+  switch (type)
+  {
+  case D3D11_RESOURCE_DIMENSION_BUFFER:
+  {
+    auto& buffer = static_cast<FMockBuffer&>(*static_cast<ID3D11Buffer*>(pResource));
+    return {buffer.GetId(), &buffer.mData, buffer.mRowPitch, 1, 1};
+  } 
+  case D3D11_RESOURCE_DIMENSION_TEXTURE2D:
+  {
+    auto& texture = static_cast<FMockTexture2D&>(*static_cast<ID3D11Texture2D*>(pResource));
+    return {texture.GetId(), &texture.mData, texture.mRowPitch, 
+      texture.mDesc.Height, GetFormatByteSize(texture.mDesc.Format)};
+  } 
+  default: return {};
+  }
+}
+
+/// @class TMockView
+/// @brief Mock view type. View holds reference of resource.
+template <typename TInterface, typename TDesc>
+class TMockView final : public TMockChild<TInterface>
+{
+public:
+  TMockView(ID3D11Device* pDevice, uint32_t id, ID3D11Resource* pResource, const TDesc& desc)
+    : TMockChild<TInterface>{pDevice, id},
+      mResource{pResource},
+      mDesc{desc}
+  { 
+    this->mResource->AddRef();
+  }
+
+  ~TMockView()
+  {
+    this->mResource->Release();
+  }
+
+  void STDMETHODCALLTYPE GetResource(ID3D11Resource** ppResource) override
+  {
+    this->mResource->AddRef();
+    *ppResource = this->mResource;
+  }
+
+  void STDMETHODCALLTYPE GetDesc(TDesc* pDesc) override
+  {
+    *pDesc = this->mDesc;
+  }
+
+private:
+  ID3D11Resource* mResource = nullptr;
+  TDesc mDesc;
+};
+
+using FMockRenderTargetView = TMockView<ID3D11RenderTargetView, D3D11_RENDER_TARGET_VIEW_DESC>;
+using FMockDepthStencilView = TMockView<ID3D11DepthStencilView, D3D11_DEPTH_STENCIL_VIEW_DESC>;
+
+/// @class TMockState
+/// @brief Mock state type which only keeps descriptor.
+template <typename TInterface, typename TDesc>
+class TMockState final : public TMockChild<TInterface>
+{
+public:
+  TMockState(ID3D11Device* pDevice, uint32_t id, const TDesc& desc)
+    : TMockChild<TInterface>{pDevice, id},
+      mDesc{desc}
+  { }
+
+  void STDMETHODCALLTYPE GetDesc(TDesc* pDesc) override
+  {
+    *pDesc = this->mDesc;
+  }
+
+private:
+  TDesc mDesc;
+};
+
+using FMockBlendState         = TMockState<ID3D11BlendState, D3D11_BLEND_DESC>;
+using FMockDepthStencilState  = TMockState<ID3D11DepthStencilState, D3D11_DEPTH_STENCIL_DESC>;
+using FMockRasterizerState    = TMockState<ID3D11RasterizerState, D3D11_RASTERIZER_DESC>;
+using FMockSamplerState       = TMockState<ID3D11SamplerState, D3D11_SAMPLER_DESC>;
+
+/// @class TMockObject
+/// @brief Mock type which does not have any additional feature. (Shaders, input layout)
+template <typename TInterface>
+class TMockObject final : public TMockChild<TInterface>
+{
+public:
+  using TMockChild<TInterface>::TMockChild;
+};
+
+using FMockInputLayout  = TMockObject<ID3D11InputLayout>;
+using FMockVertexShader = TMockObject<ID3D11VertexShader>;
+using FMockPixelShader  = TMockObject<ID3D11PixelShader>;
+
+/// @class FMockQuery
+/// @brief Mock query type. Query is completed when immediate context was flushed 
+/// the number of query latency times after query was ended. (Immediately if latency is 0)
+/// Timestamp query returns steady clock as nanoseconds, and disjoint query returns 1 GHz frequency.
+class FMockQuery final : public TMockChild<ID3D11Query>
+{
+public:
+  FMockQuery(ID3D11Device* pDevice, uint32_t id, const D3D11_QUERY_DESC& desc)
+    : TMockChild<ID3D11Query>{pDevice, id},
+      mDesc{desc}
+  { }
+
+  UINT STDMETHODCALLTYPE GetDataSize() override
+  {
+    switch (this->mDesc.Query)
+    {
+    case D3D11_QUERY_EVENT: 
+    case D3D11_QUERY_OCCLUSION_PREDICATE: 
+    case D3D11_QUERY_SO_OVERFLOW_PREDICATE: return sizeof(BOOL);
+    case D3D11_QUERY_TIMESTAMP_DISJOINT: return sizeof(D3D11_QUERY_DATA_TIMESTAMP_DISJOINT);
+    case D3D11_QUERY_PIPELINE_STATISTICS: return sizeof(D3D11_QUERY_DATA_PIPELINE_STATISTICS);
+    case D3D11_QUERY_SO_STATISTICS: return sizeof(D3D11_QUERY_DATA_SO_STATISTICS);
+    default: return sizeof(UINT64);
+    }
+  }
+
+  void STDMETHODCALLTYPE GetDesc(D3D11_QUERY_DESC* pDesc) override
+  {
+    *pDesc = this->mDesc;
+  }
+
+  void OnBegin() noexcept
+  {
+    this->mIsEnded = false;
+  }
+
+  /// @brief Query will be completed when flush count of context reaches given count.
+  void OnEnd(uint64_t completeFlushCount) noexcept
+  {
+    using namespace std::chrono;
+    this->mTimestamp = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    this->mCompleteFlushCount = completeFlushCount;
+    this->mIsEnded = true;
+  }
+
+  HRESULT WriteData(void* pData, UINT dataSize, uint64_t flushCount)
+  {
+    if (this->mIsEnded == false || flushCount < this->mCompleteFlushCount) { return S_FALSE; }
+    if (pData == nullptr) { return S_OK; }
+
+    const UINT size = this->GetDataSize();
+    if (dataSize < size) { return E_INVALIDARG; }
+
+    std::memset(pData, 0, size);
+    switch (this->mDesc.Query)
+    {
+    case D3D11_QUERY_EVENT:
+    {
+      const BOOL isDone = TRUE;
+      std::memcpy(pData, &isDone, sizeof(isDone));
+    } break;
+    case D3D11_QUERY_TIMESTAMP:
+    {
+      std::memcpy(pData, &this->mTimestamp, sizeof(this->mTimestamp));
+    } break;
+    case D3D11_QUERY_TIMESTAMP_DISJOINT:
+    {
+      D3D11_QUERY_DATA_TIMESTAMP_DISJOINT data = {};
+      data.Frequency = 1'000'000'000;
+      data.Disjoint = FALSE;
+      std::memcpy(pData, &data, sizeof(data));
+    } break;
+    default: break;
+    }
+    return S_OK;
+  }
+
+private:
+  D3D11_QUERY_DESC mDesc;
+  UINT64 mTimestamp = 0;
+  uint64_t mCompleteFlushCount = 0;
+  bool mIsEnded = false;
+};
+
+/// @brief Get mock query from asynchronous object. Predicate and counter are not supported.
+FMockQuery* GetQuery(ID3D11Asynchronous* pAsync) noexcept
+{
+  if (pAsync == nullptr) { return nullptr; }
+  return static_cast<FMockQuery*>(static_cast<ID3D11Query*>(pAsync));
+}
+
+/// @class FMockContext
+/// @brief Mock immediate context. Every call is recorded into command log without lock.
+class FMockContext final : public TMockChild<ID3D11DeviceContext>
+{
+public:
+  FMockContext(ID3D11Device* pDevice, uint32_t id, FMockCommandLog& log, uint32_t queryLatency)
+    : TMockChild<ID3D11DeviceContext>{pDevice, id},
+      mLog{log},
+      mQueryLatency{queryLatency}
+  { }
+
+  //!
+  //! Input assembler
+  //!
+
+  void STDMETHODCALLTYPE IASetInputLayout(ID3D11InputLayout* pInputLayout) override
+  {
+    this->mLog.Record(EMockD3D11Call::IASetInputLayout, GetMockId(pInputLayout));
+  }
+
+  void STDMETHODCALLTYPE IASetVertexBuffers(
+    UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppVertexBuffers, 
+    const UINT*, const UINT*) override
+  {
+    this->mLog.Record(EMockD3D11Call::IASetVertexBuffers, 
+      StartSlot, NumBuffers, GetFirstMockId(ppVertexBuffers, NumBuffers));
+  }
+
+  void STDMETHODCALLTYPE IASetIndexBuffer(ID3D11Buffer* pIndexBuffer, DXGI_FORMAT Format, UINT Offset) override
+  {
+    this->mLog.Record(EMockD3D11Call::IASetIndexBuffer, GetMockId(pIndexBuffer), Format, Offset);
+  }
+
+  void STDMETHODCALLTYPE IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) override
+  {
+    this->mLog.Record(EMockD3D11Call::IASetPrimitiveTopology, Topology);
+  }
+
+  //!
+  //! Shader stages
+  //!
+
+  void STDMETHODCALLTYPE VSSetShader(ID3D11VertexShader* pVertexShader, ID3D11ClassInstance* const*, UINT) override
+  {
+    this->mLog.Record(EMockD3D11Call::VSSetShader, GetMockId(pVertexShader));
+  }
+
+  void STDMETHODCALLTYPE VSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers) override
+  {
+    this->mLog.Record(EMockD3D11Call::VSSetConstantBuffers, 
+      StartSlot, NumBuffers, GetFirstMockId(ppConstantBuffers, NumBuffers));
+  }
+
+  void STDMETHODCALLTYPE PSSetShader(ID3D11PixelShader* pPixelShader, ID3D11ClassInstance* const*, UINT) override
+  {
+    this->mLog.Record(EMockD3D11Call::PSSetShader, GetMockId(pPixelShader));
+  }
+
+  void STDMETHODCALLTYPE PSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers) override
+  {
+    this->mLog.Record(EMockD3D11Call::PSSetConstantBuffers, 
+      StartSlot, NumBuffers, GetFirstMockId(ppConstantBuffers, NumBuffers));
+  }
+
+  void STDMETHODCALLTYPE PSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const*) override
+  {
+    this->mLog.Record(EMockD3D11Call::PSSetShaderResources, StartSlot, NumViews);
+  }
+
+  void STDMETHODCALLTYPE PSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers) override
+  {
+    this->mLog.Record(EMockD3D11Call::PSSetSamplers, 
+      StartSlot, NumSamplers, GetFirstMockId(ppSamplers, NumSamplers));
+  }
+
+  void STDMETHODCALLTYPE VSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE VSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE GSSetShader(ID3D11GeometryShader*, ID3D11ClassInstance* const*, UINT) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE GSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE GSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE GSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE HSSetShader(ID3D11HullShader*, ID3D11ClassInstance* const*, UINT) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE HSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE HSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE HSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE DSSetShader(ID3D11DomainShader*, ID3D11ClassInstance* const*, UINT) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE DSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE DSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE DSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE CSSetShader(ID3D11ComputeShader*, ID3D11ClassInstance* const*, UINT) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE CSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE CSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE CSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE CSSetUnorderedAccessViews(UINT, UINT, ID3D11UnorderedAccessView* const*, const UINT*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE SOSetTargets(UINT, ID3D11Buffer* const*, const UINT*) override { this->RecordUnsupported(); }
+
+  //!
+  //! Rasterizer & Output merger
+  //!
+
+  void STDMETHODCALLTYPE RSSetState(ID3D11RasterizerState* pRasterizerState) override
+  {
+    this->mLog.Record(EMockD3D11Call::RSSetState, GetMockId(pRasterizerState));
+  }
+
+  void STDMETHODCALLTYPE RSSetViewports(UINT NumViewports, const D3D11_VIEWPORT*) override
+  {
+    this->mLog.Record(EMockD3D11Call::RSSetViewports, NumViewports);
+  }
+
+  void STDMETHODCALLTYPE RSSetScissorRects(UINT NumRects, const D3D11_RECT*) override
+  {
+    this->mLog.Record(EMockD3D11Call::RSSetScissorRects, NumRects);
+  }
+
+  void STDMETHODCALLTYPE OMSetRenderTargets(
+    UINT NumViews, ID3D11RenderTargetView* const* ppRenderTargetViews, 
+    ID3D11DepthStencilView* pDepthStencilView) override
+  {
+    this->mLog.Record(EMockD3D11Call::OMSetRenderTargets, 
+      NumViews, GetFirstMockId(ppRenderTargetViews, NumViews), GetMockId(pDepthStencilView));
+  }
+
+  void STDMETHODCALLTYPE OMSetRenderTargetsAndUnorderedAccessViews(
+    UINT, ID3D11RenderTargetView* const*, ID3D11DepthStencilView*, 
+    UINT, UINT, ID3D11UnorderedAccessView* const*, const UINT*) override 
+  { 
+    this->RecordUnsupported(); 
+  }
+
+  void STDMETHODCALLTYPE OMSetBlendState(ID3D11BlendState* pBlendState, const FLOAT[4], UINT SampleMask) override
+  {
+    this->mLog.Record(EMockD3D11Call::OMSetBlendState, GetMockId(pBlendState), SampleMask);
+  }
+
+  void STDMETHODCALLTYPE OMSetDepthStencilState(ID3D11DepthStencilState* pDepthStencilState, UINT StencilRef) override
+  {
+    this->mLog.Record(EMockD3D11Call::OMSetDepthStencilState, GetMockId(pDepthStencilState), StencilRef);
+  }
+
+  void STDMETHODCALLTYPE ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, const FLOAT[4]) override
+  {
+    this->mLog.Record(EMockD3D11Call::ClearRenderTargetView, GetMockId(pRenderTargetView));
+  }
+
+  void STDMETHODCALLTYPE ClearDepthStencilView(
+    ID3D11DepthStencilView* pDepthStencilView, UINT ClearFlags, FLOAT, UINT8) override
+  {
+    this->mLog.Record(EMockD3D11Call::ClearDepthStencilView, GetMockId(pDepthStencilView), ClearFlags);
+  }
+
+  void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(ID3D11UnorderedAccessView*, const UINT[4]) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(ID3D11UnorderedAccessView*, const FLOAT[4]) override { this->RecordUnsupported(); }
+
+  //!
+  //! Resource
+  //!
+
+  void STDMETHODCALLTYPE UpdateSubresource(
+    ID3D11Resource* pDstResource, UINT DstSubresource, const D3D11_BOX* pDstBox, 
+    const void* pSrcData, UINT SrcRowPitch, UINT) override
+  {
+    const auto storage = GetStorage(pDstResource);
+    if (storage.mData == nullptr || pSrcData == nullptr || DstSubresource != 0) 
+    { 
+      this->RecordUnsupported(); 
+      return; 
+    }
+
+    auto& data = *storage.mData;
+    const auto* pSource = static_cast<const uint8_t*>(pSrcData);
+    size_t copiedBytes = 0;
+
+    D3D11_RESOURCE_DIMENSION type = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+    pDstResource->GetType(&type);
+    if (type == D3D11_RESOURCE_DIMENSION_BUFFER)
+    {
+      // Buffer only uses (left, right) of box.
+      const size_t left  = pDstBox == nullptr ? 0 : (std::min)(size_t(pDstBox->left), data.size());
+      const size_t right = pDstBox == nullptr ? data.size() : (std::min)(size_t(pDstBox->right), data.size());
+      if (right > left)
+      {
+        copiedBytes = right - left;
+        std::memcpy(data.data() + left, pSource, copiedBytes);
+      }
+    }
+    else
+    {
+      // Copy rows of first subresource in box with given row pitch.
+      const size_t top    = pDstBox == nullptr ? 0 : (std::min)(pDstBox->top, storage.mHeight);
+      const size_t bottom = pDstBox == nullptr ? storage.mHeight : (std::min)(pDstBox->bottom, storage.mHeight);
+      const size_t left   = pDstBox == nullptr ? 0 : size_t(pDstBox->left) * storage.mPixelSize;
+      const size_t right  = pDstBox == nullptr 
+        ? storage.mRowPitch 
+        : (std::min)(size_t(pDstBox->right) * storage.mPixelSize, size_t(storage.mRowPitch));
+
+      for (size_t y = top; y < bottom && right > left; ++y)
+      {
+        std::memcpy(
+          data.data() + y * storage.mRowPitch + left, 
+          pSource + (y - top) * SrcRowPitch, 
+          right - left);
+        copiedBytes += right - left;
+      }
+    }
+
+    this->mLog.Record(EMockD3D11Call::UpdateSubresource, 
+      storage.mId, DstSubresource, static_cast<uint32_t>(copiedBytes));
+    this->mLog.AddUploadedBytes(copiedBytes);
+  }
+
+  HRESULT STDMETHODCALLTYPE Map(
+    ID3D11Resource* pResource, UINT Subresource, D3D11_MAP MapType, UINT, 
+    D3D11_MAPPED_SUBRESOURCE* pMappedResource) override
+  {
+    const auto storage = GetStorage(pResource);
+    if (storage.mData == nullptr || pMappedResource == nullptr || Subresource != 0) 
+    { 
+      this->RecordUnsupported(); 
+      return E_NOTIMPL; 
+    }
+
+    pMappedResource->pData = storage.mData->data();
+    pMappedResource->RowPitch = storage.mRowPitch;
+    pMappedResource->DepthPitch = storage.mRowPitch * storage.mHeight;
+
+    this->mLog.Record(EMockD3D11Call::Map, storage.mId, Subresource, MapType);
+    if (MapType != D3D11_MAP_READ) 
+    { 
+      this->mLog.AddUploadedBytes(pMappedResource->DepthPitch); 
+    }
+    return S_OK;
+  }
+
+  void STDMETHODCALLTYPE Unmap(ID3D11Resource* pResource, UINT Subresource) override
+  {
+    this->mLog.Record(EMockD3D11Call::Unmap, GetStorage(pResource).mId, Subresource);
+  }
+
+  void STDMETHODCALLTYPE CopyResource(ID3D11Resource* pDstResource, ID3D11Resource* pSrcResource) override
+  {
+    const auto dest = GetStorage(pDstResource);
+    const auto source = GetStorage(pSrcResource);
+    if (dest.mData == nullptr || source.mData == nullptr) 
+    { 
+      this->RecordUnsupported(); 
+      return; 
+    }
+
+    const size_t copiedBytes = (std::min)(dest.mData->size(), source.mData->size());
+    std::memcpy(dest.mData->data(), source.mData->data(), copiedBytes);
+    this->mLog.Record(EMockD3D11Call::CopyResource, 
+      dest.mId, source.mId, static_cast<uint32_t>(copiedBytes));
+  }
+
+  void STDMETHODCALLTYPE CopySubresourceRegion(
+    ID3D11Resource*, UINT, UINT, UINT, UINT, 
+    ID3D11Resource*, UINT, const D3D11_BOX*) override 
+  { 
+    this->RecordUnsupported(); 
+  }
+
+  void STDMETHODCALLTYPE CopyStructureCount(ID3D11Buffer*, UINT, ID3D11UnorderedAccessView*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE GenerateMips(ID3D11ShaderResourceView*) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE SetResourceMinLOD(ID3D11Resource*, FLOAT) override { this->RecordUnsupported(); }
+  FLOAT STDMETHODCALLTYPE GetResourceMinLOD(ID3D11Resource*) override { return 0.0f; }
+  void STDMETHODCALLTYPE ResolveSubresource(ID3D11Resource*, UINT, ID3D11Resource*, UINT, DXGI_FORMAT) override { this->RecordUnsupported(); }
+
+  //!
+  //! Draw & Dispatch
+  //!
+
+  void STDMETHODCALLTYPE Draw(UINT VertexCount, UINT StartVertexLocation) override
+  {
+    this->mLog.Record(EMockD3D11Call::Draw, VertexCount, StartVertexLocation);
+  }
+
+  void STDMETHODCALLTYPE DrawIndexed(UINT IndexCount, UINT StartIndexLocation, INT BaseVertexLocation) override
+  {
+    this->mLog.Record(EMockD3D11Call::DrawIndexed, 
+      IndexCount, StartIndexLocation, static_cast<uint32_t>(BaseVertexLocation));
+  }
+
+  void STDMETHODCALLTYPE DrawInstanced(
+    UINT VertexCountPerInstance, UINT InstanceCount, UINT StartVertexLocation, UINT) override
+  {
+    this->mLog.Record(EMockD3D11Call::DrawInstanced, 
+      VertexCountPerInstance, InstanceCount, StartVertexLocation);
+  }
+
+  void STDMETHODCALLTYPE DrawIndexedInstanced(
+    UINT IndexCountPerInstance, UINT InstanceCount, UINT StartIndexLocation, INT, UINT) override
+  {
+    this->mLog.Record(EMockD3D11Call::DrawIndexedInstanced, 
+      IndexCountPerInstance, InstanceCount, StartIndexLocation);
+  }
+
+  void STDMETHODCALLTYPE DrawAuto() override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE DrawIndexedInstancedIndirect(ID3D11Buffer*, UINT) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE DrawInstancedIndirect(ID3D11Buffer*, UINT) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE Dispatch(UINT, UINT, UINT) override { this->RecordUnsupported(); }
+  void STDMETHODCALLTYPE DispatchIndirect(ID3D11Buffer*, UINT) override { this->RecordUnsupported(); }
+
+  //!
+  //! Query
+  //!
+
+  void STDMETHODCALLTYPE Begin(ID3D11Asynchronous* pAsync) override
+  {
+    auto* pQuery = GetQuery(pAsync);
+    if (pQuery != nullptr) { pQuery->OnBegin(); }
+    this->mLog.Record(EMockD3D11Call::Begin, GetMockId(static_cast<ID3D11Query*>(pQuery)));
+  }
+
+  void STDMETHODCALLTYPE End(ID3D11Asynchronous* pAsync) override
+  {
+    auto* pQuery = GetQuery(pAsync);
+    if (pQuery != nullptr) { pQuery->OnEnd(this->mFlushCount + this->mQueryLatency); }
+    this->mLog.Record(EMockD3D11Call::End, GetMockId(static_cast<ID3D11Query*>(pQuery)));
+  }
+
+  HRESULT STDMETHODCALLTYPE GetData(ID3D11Asynchronous* pAsync, void* pData, UINT DataSize, UINT) override
+  {
+    auto* pQuery = GetQuery(pAsync);
+    const HRESULT result = pQuery == nullptr ? E_INVALIDARG : pQuery->WriteData(pData, DataSize, this->mFlushCount);
+    this->mLog.Record(EMockD3D11Call::GetData, 
+      GetMockId(static_cast<ID3D11Query*>(pQuery)), static_cast<uint32_t>(result));
+    return result;
+  }
+
+  void STDMETHODCALLTYPE SetPredication(ID3D11Predicate*, BOOL) override { this->RecordUnsupported(); }
+
+  //!
+  //! Getters. Mock does not track bound states, so every output is empty.
+  //!
+
+  void STDMETHODCALLTYPE VSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) override { Fill(ppConstantBuffers, NumBuffers); }
+  void STDMETHODCALLTYPE VSGetShader(ID3D11VertexShader** ppVertexShader, ID3D11ClassInstance**, UINT* pNumClassInstances) override { Fill(ppVertexShader, 1); Fill(pNumClassInstances, 1); }
+  void STDMETHODCALLTYPE VSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) override { Fill(ppShaderResourceViews, NumViews); }
+  void STDMETHODCALLTYPE VSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** ppSamplers) override { Fill(ppSamplers, NumSamplers); }
+  void STDMETHODCALLTYPE PSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) override { Fill(ppConstantBuffers, NumBuffers); }
+  void STDMETHODCALLTYPE PSGetShader(ID3D11PixelShader** ppPixelShader, ID3D11ClassInstance**, UINT* pNumClassInstances) override { Fill(ppPixelShader, 1); Fill(pNumClassInstances, 1); }
+  void STDMETHODCALLTYPE PSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) override { Fill(ppShaderResourceViews, NumViews); }
+  void STDMETHODCALLTYPE PSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** ppSamplers) override { Fill(ppSamplers, NumSamplers); }
+  void STDMETHODCALLTYPE GSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) override { Fill(ppConstantBuffers, NumBuffers); }
+  void STDMETHODCALLTYPE GSGetShader(ID3D11GeometryShader** ppGeometryShader, ID3D11ClassInstance**, UINT* pNumClassInstances) override { Fill(ppGeometryShader, 1); Fill(pNumClassInstances, 1); }
+  void STDMETHODCALLTYPE GSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) override { Fill(ppShaderResourceViews, NumViews); }
+  void STDMETHODCALLTYPE GSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** ppSamplers) override { Fill(ppSamplers, NumSamplers); }
+  void STDMETHODCALLTYPE HSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) override { Fill(ppConstantBuffers, NumBuffers); }
+  void STDMETHODCALLTYPE HSGetShader(ID3D11HullShader** ppHullShader, ID3D11ClassInstance**, UINT* pNumClassInstances) override { Fill(ppHullShader, 1); Fill(pNumClassInstances, 1); }
+  void STDMETHODCALLTYPE HSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) override { Fill(ppShaderResourceViews, NumViews); }
+  void STDMETHODCALLTYPE HSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** ppSamplers) override { Fill(ppSamplers, NumSamplers); }
+  void STDMETHODCALLTYPE DSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) override { Fill(ppConstantBuffers, NumBuffers); }
+  void STDMETHODCALLTYPE DSGetShader(ID3D11DomainShader** ppDomainShader, ID3D11ClassInstance**, UINT* pNumClassInstances) override { Fill(ppDomainShader, 1); Fill(pNumClassInstances, 1); }
+  void STDMETHODCALLTYPE DSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) override { Fill(ppShaderResourceViews, NumViews); }
+  void STDMETHODCALLTYPE DSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** ppSamplers) override { Fill(ppSamplers, NumSamplers); }
+  void STDMETHODCALLTYPE CSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) override { Fill(ppConstantBuffers, NumBuffers); }
+  void STDMETHODCALLTYPE CSGetShader(ID3D11ComputeShader** ppComputeShader, ID3D11ClassInstance**, UINT* pNumClassInstances) override { Fill(ppComputeShader, 1); Fill(pNumClassInstances, 1); }
+  void STDMETHODCALLTYPE CSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) override { Fill(ppShaderResourceViews, NumViews); }
+  void STDMETHODCALLTYPE CSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** ppSamplers) override { Fill(ppSamplers, NumSamplers); }
+  void STDMETHODCALLTYPE CSGetUnorderedAccessViews(UINT, UINT NumUAVs, ID3D11UnorderedAccessView** ppUnorderedAccessViews) override { Fill(ppUnorderedAccessViews, NumUAVs); }
+  void STDMETHODCALLTYPE IAGetInputLayout(ID3D11InputLayout** ppInputLayout) override { Fill(ppInputLayout, 1); }
+  void STDMETHODCALLTYPE IAGetVertexBuffers(UINT, UINT NumBuffers, ID3D11Buffer** ppVertexBuffers, UINT* pStrides, UINT* pOffsets) override { Fill(ppVertexBuffers, NumBuffers); Fill(pStrides, NumBuffers); Fill(pOffsets, NumBuffers); }
+  void STDMETHODCALLTYPE IAGetIndexBuffer(ID3D11Buffer** pIndexBuffer, DXGI_FORMAT* Format, UINT* Offset) override { Fill(pIndexBuffer, 1); Fill(Format, 1); Fill(Offset, 1); }
+  void STDMETHODCALLTYPE IAGetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY* pTopology) override { Fill(pTopology, 1); }
+  void STDMETHODCALLTYPE GetPredication(ID3D11Predicate** ppPredicate, BOOL* pPredicateValue) override { Fill(ppPredicate, 1); Fill(pPredicateValue, 1); }
+  void STDMETHODCALLTYPE OMGetRenderTargets(UINT NumViews, ID3D11RenderTargetView** ppRenderTargetViews, ID3D11DepthStencilView** ppDepthStencilView) override { Fill(ppRenderTargetViews, NumViews); Fill(ppDepthStencilView, 1); }
+  void STDMETHODCALLTYPE OMGetRenderTargetsAndUnorderedAccessViews(
+    UINT NumRTVs, ID3D11RenderTargetView** ppRenderTargetViews, ID3D11DepthStencilView** ppDepthStencilView, 
+    UINT, UINT NumUAVs, ID3D11UnorderedAccessView** ppUnorderedAccessViews) override 
+  { 
+    Fill(ppRenderTargetViews, NumRTVs); Fill(ppDepthStencilView, 1); Fill(ppUnorderedAccessViews, NumUAVs); 
+  }
+  void STDMETHODCALLTYPE OMGetBlendState(ID3D11BlendState** ppBlendState, FLOAT BlendFactor[4], UINT* pSampleMask) override { Fill(ppBlendState, 1); Fill(BlendFactor, 4); Fill(pSampleMask, 1); }
+  void STDMETHODCALLTYPE OMGetDepthStencilState(ID3D11DepthStencilState** ppDepthStencilState, UINT* pStencilRef) override { Fill(ppDepthStencilState, 1); Fill(pStencilRef, 1); }
+  void STDMETHODCALLTYPE SOGetTargets(UINT NumBuffers, ID3D11Buffer** ppSOTargets) override { Fill(ppSOTargets, NumBuffers); }
+  void STDMETHODCALLTYPE RSGetState(ID3D11RasterizerState** ppRasterizerState) override { Fill(ppRasterizerState, 1); }
+  void STDMETHODCALLTYPE RSGetViewports(UINT* pNumViewports, D3D11_VIEWPORT*) override { Fill(pNumViewports, 1); }
+  void STDMETHODCALLTYPE RSGetScissorRects(UINT* pNumRects, D3D11_RECT*) override { Fill(pNumRects, 1); }
+
+  //!
+  //! Miscellaneous
+  //!
+
+  void STDMETHODCALLTYPE ClearState() override
+  {
+    this->mLog.Record(EMockD3D11Call::ClearState);
+  }
+
+  void STDMETHODCALLTYPE Flush() override
+  {
+    this->mFlushCount += 1;
+    this->mLog.Record(EMockD3D11Call::Flush);
+  }
+
+  void STDMETHODCALLTYPE ExecuteCommandList(ID3D11CommandList*, BOOL) override { this->RecordUnsupported(); }
+
+  D3D11_DEVICE_CONTEXT_TYPE STDMETHODCALLTYPE GetType() override
+  {
+    return D3D11_DEVICE_CONTEXT_IMMEDIATE;
+  }
+
+  UINT STDMETHODCALLTYPE GetContextFlags() override
+  {
+    return 0;
+  }
+
+  HRESULT STDMETHODCALLTYPE FinishCommandList(BOOL, ID3D11CommandList** ppCommandList) override
+  {
+    Fill(ppCommandList, 1);
+    return DXGI_ERROR_INVALID_CALL;
+  }
+
+private:
+  /// @brief Fill given output array with zero value if not nullptr.
+  template <typename TType>
+  static void Fill(TType* pOutputs, UINT count) noexcept
+  {
+    if (pOutputs == nullptr) { return; }
+    std::fill(pOutputs, pOutputs + count, TType{});
+  }
+
+  void RecordUnsupported()
+  {
+    this->mLog.Record(EMockD3D11Call::Unsupported);
+  }
+
+  FMockCommandLog& mLog;
+  uint32_t mQueryLatency = 0;
+  uint64_t mFlushCount = 0;
+};
+
+/// @class FMockDevice
+/// @brief Mock device. Device can be used from multiple threads, so calls are recorded with lock.
+class FMockDevice final : public ID3D11Device
+{
+public:
+  FMockDevice(FMockCommandLog& log)
+    : mLog{log}
+  { }
+
+  ~FMockDevice()
+  {
+    if (this->mContext != nullptr) { this->mContext->Release(); }
+  }
+
+  /// @brief Set immediate context which is released with device.
+  void SetImmediateContext(ID3D11DeviceContext* pContext) noexcept
+  {
+    this->mContext = pContext;
+  }
+
+  /// @brief Issue new mock object id.
+  uint32_t IssueId() noexcept
+  {
+    return ++this->mLastId;
+  }
+
+  //!
+  //! IUnknown
+  //!
+
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+  {
+    if (ppvObject == nullptr) { return E_POINTER; }
+
+    // DXGI interfaces are not supported, so swap-chain can not be created from mock device.
+    if (riid != __uuidof(IUnknown) && riid != __uuidof(ID3D11Device))
+    {
+      *ppvObject = nullptr;
+      return E_NOINTERFACE;
+    }
+
+    this->AddRef();
+    *ppvObject = static_cast<ID3D11Device*>(this);
+    return S_OK;
+  }
+
+  ULONG STDMETHODCALLTYPE AddRef() override
+  {
+    return ++this->mCounter;
+  }
+
+  ULONG STDMETHODCALLTYPE Release() override
+  {
+    const ULONG count = --this->mCounter;
+    if (count == 0) { delete this; }
+    return count;
+  }
+
+  //!
+  //! Resource
+  //!
+
+  HRESULT STDMETHODCALLTYPE CreateBuffer(
+    const D3D11_BUFFER_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, 
+    ID3D11Buffer** ppBuffer) override
+  {
+    if (pDesc == nullptr || pDesc->ByteWidth == 0) { return E_INVALIDARG; }
+    if (ppBuffer == nullptr) { return S_FALSE; }
+
+    const auto id = this->IssueId();
+    auto* pBuffer = new FMockBuffer(this, id, *pDesc, pDesc->ByteWidth, pDesc->ByteWidth);
+    if (pInitialData != nullptr && pInitialData->pSysMem != nullptr)
+    {
+      std::memcpy(pBuffer->mData.data(), pInitialData->pSysMem, pDesc->ByteWidth);
+    }
+
+    this->Record(EMockD3D11Call::CreateBuffer, id, pDesc->ByteWidth, pDesc->BindFlags);
+    if (pInitialData != nullptr) { this->AddUploadedBytes(pDesc->ByteWidth); }
+    *ppBuffer = pBuffer;
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE CreateTexture2D(
+    const D3D11_TEXTURE2D_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, 
+    ID3D11Texture2D** ppTexture2D) override
+  {
+    if (pDesc == nullptr || pDesc->Width == 0 || pDesc->Height == 0) { return E_INVALIDARG; }
+    if (ppTexture2D == nullptr) { return S_FALSE; }
+
+    // Only keep storage of the most detailed mip of each array slice, and first sample.
+    const UINT rowPitch   = pDesc->Width * GetFormatByteSize(pDesc->Format);
+    const UINT slicePitch = rowPitch * pDesc->Height;
+    const UINT arraySize  = (std::max)(pDesc->ArraySize, 1u);
+    const auto id = this->IssueId();
+    auto* pTexture = new FMockTexture2D(this, id, *pDesc, size_t(slicePitch) * arraySize, rowPitch);
+
+    if (pInitialData != nullptr)
+    {
+      const UINT mipLevels = (std::max)(pDesc->MipLevels, 1u);
+      for (UINT slice = 0; slice < arraySize; ++slice)
+      {
+        const auto& initialData = pInitialData[slice * mipLevels];
+        if (initialData.pSysMem == nullptr) { continue; }
+
+        for (UINT y = 0; y < pDesc->Height; ++y)
+        {
+          std::memcpy(
+            pTexture->mData.data() + size_t(slice) * slicePitch + size_t(y) * rowPitch,
+            static_cast<const uint8_t*>(initialData.pSysMem) + size_t(y) * initialData.SysMemPitch,
+            (std::min)(rowPitch, initialData.SysMemPitch));
+        }
+      }
+      this->AddUploadedBytes(size_t(slicePitch) * arraySize);
+    }
+
+    this->Record(EMockD3D11Call::CreateTexture2D, id, pDesc->Width, pDesc->Height);
+    *ppTexture2D = pTexture;
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE CreateRenderTargetView(
+    ID3D11Resource* pResource, const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, 
+    ID3D11RenderTargetView** ppRTView) override
+  {
+    D3D11_RENDER_TARGET_VIEW_DESC desc = {};
+    if (this->GetViewDesc(pResource, pDesc, desc) == false) { return E_INVALIDARG; }
+    if (ppRTView == nullptr) { return S_FALSE; }
+
+    const auto id = this->IssueId();
+    this->Record(EMockD3D11Call::CreateRenderTargetView, id, GetStorage(pResource).mId);
+    *ppRTView = new FMockRenderTargetView(this, id, pResource, desc);
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE CreateDepthStencilView(
+    ID3D11Resource* pResource, const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, 
+    ID3D11DepthStencilView** ppDepthStencilView) override
+  {
+    D3D11_DEPTH_STENCIL_VIEW_DESC desc = {};
+    if (this->GetViewDesc(pResource, pDesc, desc) == false) { return E_INVALIDARG; }
+    if (ppDepthStencilView == nullptr) { return S_FALSE; }
+
+    const auto id = this->IssueId();
+    this->Record(EMockD3D11Call::CreateDepthStencilView, id, GetStorage(pResource).mId);
+    *ppDepthStencilView = new FMockDepthStencilView(this, id, pResource, desc);
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE CreateTexture1D(const D3D11_TEXTURE1D_DESC*, const D3D11_SUBRESOURCE_DATA*, ID3D11Texture1D** ppTexture1D) override { return this->Unsupported(ppTexture1D); }
+  HRESULT STDMETHODCALLTYPE CreateTexture3D(const D3D11_TEXTURE3D_DESC*, const D3D11_SUBRESOURCE_DATA*, ID3D11Texture3D** ppTexture3D) override { return this->Unsupported(ppTexture3D); }
+  HRESULT STDMETHODCALLTYPE CreateShaderResourceView(ID3D11Resource*, const D3D11_SHADER_RESOURCE_VIEW_DESC*, ID3D11ShaderResourceView** ppSRView) override { return this->Unsupported(ppSRView); }
+  HRESULT STDMETHODCALLTYPE CreateUnorderedAccessView(ID3D11Resource*, const D3D11_UNORDERED_ACCESS_VIEW_DESC*, ID3D11UnorderedAccessView** ppUAView) override { return this->Unsupported(ppUAView); }
+  HRESULT STDMETHODCALLTYPE OpenSharedResource(HANDLE, REFIID, void** ppResource) override { return this->Unsupported(ppResource); }
+
+  //!
+  //! Shader & Input layout
+  //!
+
+  HRESULT STDMETHODCALLTYPE CreateInputLayout(
+    const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, UINT NumElements, 
+    const void* pShaderBytecodeWithInputSignature, SIZE_T, 
+    ID3D11InputLayout** ppInputLayout) override
+  {
+    if (pInputElementDescs == nullptr || pShaderBytecodeWithInputSignature == nullptr) { return E_INVALIDARG; }
+    if (ppInputLayout == nullptr) { return S_FALSE; }
+
+    const auto id = this->IssueId();
+    this->Record(EMockD3D11Call::CreateInputLayout, id, NumElements);
+    *ppInputLayout = new FMockInputLayout(this, id);
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE CreateVertexShader(
+    const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage*, 
+    ID3D11VertexShader** ppVertexShader) override
+  {
+    if (pShaderBytecode == nullptr) { return E_INVALIDARG; }
+    if (ppVertexShader == nullptr) { return S_FALSE; }
+
+    const auto id = this->IssueId();
+    this->Record(EMockD3D11Call::CreateVertexShader, id, static_cast<uint32_t>(BytecodeLength));
+    *ppVertexShader = new FMockVertexShader(this, id);
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE CreatePixelShader(
+    const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage*, 
+    ID3D11PixelShader** ppPixelShader) override
+  {
+    if (pShaderBytecode == nullptr) { return E_INVALIDARG; }
+    if (ppPixelShader == nullptr) { return S_FALSE; }
+
+    const auto id = this->IssueId();
+    this->Record(EMockD3D11Call::CreatePixelShader, id, static_cast<uint32_t>(BytecodeLength));
+    *ppPixelShader = new FMockPixelShader(this, id);
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE CreateGeometryShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11GeometryShader** ppGeometryShader) override { return this->Unsupported(ppGeometryShader); }
+  HRESULT STDMETHODCALLTYPE CreateGeometryShaderWithStreamOutput(
+    const void*, SIZE_T, const D3D11_SO_DECLARATION_ENTRY*, UINT, const UINT*, UINT, UINT, 
+    ID3D11ClassLinkage*, ID3D11GeometryShader** ppGeometryShader) override 
+  { 
+    return this->Unsupported(ppGeometryShader); 
+  }
+  HRESULT STDMETHODCALLTYPE CreateHullShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11HullShader** ppHullShader) override { return this->Unsupported(ppHullShader); }
+  HRESULT STDMETHODCALLTYPE CreateDomainShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11DomainShader** ppDomainShader) override { return this->Unsupported(ppDomainShader); }
+  HRESULT STDMETHODCALLTYPE CreateComputeShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11ComputeShader** ppComputeShader) override { return this->Unsupported(ppComputeShader); }
+  HRESULT STDMETHODCALLTYPE CreateClassLinkage(ID3D11ClassLinkage** ppLinkage) override { return this->Unsupported(ppLinkage); }
+
+  //!
+  //! States & Queries
+  //!
+
+  HRESULT STDMETHODCALLTYPE CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc, ID3D11BlendState** ppBlendState) override
+  {
+    return this->CreateState<FMockBlendState>(EMockD3D11Call::CreateBlendState, pBlendStateDesc, ppBlendState);
+  }
+
+  HRESULT STDMETHODCALLTYPE CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* pDepthStencilDesc, ID3D11DepthStencilState** ppDepthStencilState) override
+  {
+    return this->CreateState<FMockDepthStencilState>(EMockD3D11Call::CreateDepthStencilState, pDepthStencilDesc, ppDepthStencilState);
+  }
+
+  HRESULT STDMETHODCALLTYPE CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc, ID3D11RasterizerState** ppRasterizerState) override
+  {
+    return this->CreateState<FMockRasterizerState>(EMockD3D11Call::CreateRasterizerState, pRasterizerDesc, ppRasterizerState);
+  }
+
+  HRESULT STDMETHODCALLTYPE CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc, ID3D11SamplerState** ppSamplerState) override
+  {
+    return this->CreateState<FMockSamplerState>(EMockD3D11Call::CreateSamplerState, pSamplerDesc, ppSamplerState);
+  }
+
+  HRESULT STDMETHODCALLTYPE CreateQuery(const D3D11_QUERY_DESC* pQueryDesc, ID3D11Query** ppQuery) override
+  {
+    if (pQueryDesc == nullptr) { return E_INVALIDARG; }
+    if (ppQuery == nullptr) { return S_FALSE; }
+
+    const auto id = this->IssueId();
+    this->Record(EMockD3D11Call::CreateQuery, id, pQueryDesc->Query);
+    *ppQuery = new FMockQuery(this, id, *pQueryDesc);
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE CreatePredicate(const D3D11_QUERY_DESC*, ID3D11Predicate** ppPredicate) override { return this->Unsupported(ppPredicate); }
+  HRESULT STDMETHODCALLTYPE CreateCounter(const D3D11_COUNTER_DESC*, ID3D11Counter** ppCounter) override { return this->Unsupported(ppCounter); }
+  HRESULT STDMETHODCALLTYPE CreateDeferredContext(UINT, ID3D11DeviceContext** ppDeferredContext) override { return this->Unsupported(ppDeferredContext); }
+
+  //!
+  //! Miscellaneous
+  //!
+
+  HRESULT STDMETHODCALLTYPE CheckFormatSupport(DXGI_FORMAT, UINT* pFormatSupport) override 
+  { 
+    return this->Unsupported(pFormatSupport); 
+  }
+
+  HRESULT STDMETHODCALLTYPE CheckMultisampleQualityLevels(DXGI_FORMAT, UINT SampleCount, UINT* pNumQualityLevels) override
+  {
+    if (pNumQualityLevels == nullptr) { return E_INVALIDARG; }
+
+    // Regard 1, 2, 4 and 8 samples as supported with one quality level.
+    const bool isSupported = SampleCount > 0 && SampleCount <= 8 && (SampleCount & (SampleCount - 1)) == 0;
+    *pNumQualityLevels = isSupported == true ? 1 : 0;
+    return S_OK;
+  }
+
+  void STDMETHODCALLTYPE CheckCounterInfo(D3D11_COUNTER_INFO* pCounterInfo) override
+  {
+    if (pCounterInfo != nullptr) { *pCounterInfo = {}; }
+  }
+
+  HRESULT STDMETHODCALLTYPE CheckCounter(
+    const D3D11_COUNTER_DESC*, D3D11_COUNTER_TYPE*, UINT*, 
+    LPSTR, UINT*, LPSTR, UINT*, LPSTR, UINT*) override
+  {
+    return this->Unsupported<void>(nullptr);
+  }
+
+  HRESULT STDMETHODCALLTYPE CheckFeatureSupport(D3D11_FEATURE, void*, UINT) override
+  {
+    return this->Unsupported<void>(nullptr);
+  }
+
+  HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) override
+  {
+    return this->mPrivateData.Get(guid, pDataSize, pData);
+  }
+
+  HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) override
+  {
+    return this->mPrivateData.Set(guid, DataSize, pData);
+  }
+
+  HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) override
+  {
+    return this->mPrivateData.SetInterface(guid, pData);
+  }
+
+  D3D_FEATURE_LEVEL STDMETHODCALLTYPE GetFeatureLevel() override
+  {
+    return D3D_FEATURE_LEVEL_11_0;
+  }
+
+  UINT STDMETHODCALLTYPE GetCreationFlags() override
+  {
+    return 0;
+  }
+
+  HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason() override
+  {
+    return S_OK;
+  }
+
+  void STDMETHODCALLTYPE GetImmediateContext(ID3D11DeviceContext** ppImmediateContext) override
+  {
+    this->mContext->AddRef();
+    *ppImmediateContext = this->mContext;
+  }
+
+  HRESULT STDMETHODCALLTYPE SetExceptionMode(UINT RaiseFlags) override
+  {
+    this->mExceptionMode = RaiseFlags;
+    return S_OK;
+  }
+
+  UINT STDMETHODCALLTYPE GetExceptionMode() override
+  {
+    return this->mExceptionMode;
+  }
+
+private:
+  void Record(EMockD3D11Call call, uint32_t arg0 = 0, uint32_t arg1 = 0, uint32_t arg2 = 0)
+  {
+    std::lock_guard<std::mutex> lock{this->mLogMutex};
+    this->mLog.Record(call, arg0, arg1, arg2);
+  }
+
+  void AddUploadedBytes(uint64_t bytes)
+  {
+    std::lock_guard<std::mutex> lock{this->mLogMutex};
+    this->mLog.AddUploadedBytes(bytes);
+  }
+
+  /// @brief Record unsupported call and reset output to zero value.
+  template <typename TType>
+  HRESULT Unsupported(TType* pOutput)
+  {
+    if constexpr (std::is_void_v<TType> == false)
+    {
+      if (pOutput != nullptr) { *pOutput = TType{}; }
+    }
+    this->Record(EMockD3D11Call::Unsupported);
+    return E_NOTIMPL;
+  }
+
+  template <typename TState, typename TDesc, typename TInterface>
+  HRESULT CreateState(EMockD3D11Call call, const TDesc* pDesc, TInterface** ppState)
+  {
+    if (pDesc == nullptr) { return E_INVALIDARG; }
+    if (ppState == nullptr) { return S_FALSE; }
+
+    const auto id = this->IssueId();
+    this->Record(call, id);
+    *ppState = new TState(this, id, *pDesc);
+    return S_OK;
+  }
+
+  /// @brief Get view descriptor. If pDesc is nullptr, make default descriptor from 2D texture.
+  template <typename TDesc>
+  static bool GetViewDesc(ID3D11Resource* pResource, const TDesc* pDesc, TDesc& outDesc)
+  {
+    if (pResource == nullptr) { return false; }
+    if (pDesc != nullptr) 
+    { 
+      outDesc = *pDesc; 
+      return true;
+    }
+
+    D3D11_RESOURCE_DIMENSION type = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+    pResource->GetType(&type);
+    if (type != D3D11_RESOURCE_DIMENSION_TEXTURE2D) { return false; }
+
+    D3D11_TEXTURE2D_DESC textureDesc = {};
+    static_cast<ID3D11Texture2D*>(pResource)->GetDesc(&textureDesc);
+
+    const bool isMultisampled = textureDesc.SampleDesc.Count > 1;
+    outDesc.Format = textureDesc.Format;
+    if constexpr (std::is_same_v<TDesc, D3D11_RENDER_TARGET_VIEW_DESC> == true)
+    {
+      outDesc.ViewDimension = isMultisampled == true 
+        ? D3D11_RTV_DIMENSION_TEXTURE2DMS 
+        : D3D11_RTV_DIMENSION_TEXTURE2D;
+    }
+    else
+    {
+      outDesc.ViewDimension = isMultisampled == true 
+        ? D3D11_DSV_DIMENSION_TEXTURE2DMS 
+        : D3D11_DSV_DIMENSION_TEXTURE2D;
+    }
+    return true;
+  }
+
+  FMockCommandLog& mLog;
+  std::mutex mLogMutex;
+  std::atomic<ULONG> mCounter = 1;
+  std::atomic<uint32_t> mLastId = 0;
+  ID3D11DeviceContext* mContext = nullptr;
+  UINT mExceptionMode = 0;
+  DMockPrivateData mPrivateData;
+};
+
+} /// ::anonymous namespace
+
+HRESULT FMockD3D11Factory::CreateDevice(
+  FMockCommandLog& deviceLog, 
+  FMockCommandLog& contextLog,
+  ID3D11Device** ppDevice,
+  ID3D11DeviceContext** ppContext,
+  const PMockD3D11Descriptor& desc)
+{
+  if (ppDevice == nullptr || ppContext == nullptr) { return E_INVALIDARG; }
+
+  auto* pDevice = new FMockDevice(deviceLog);
+  auto* pContext = new FMockContext(pDevice, pDevice->IssueId(), contextLog, desc.mQueryLatency);
+  pDevice->SetImmediateContext(pContext);
+
+  // Device holds one reference of immediate context.
+  pContext->AddRef();
+  *ppDevice = pDevice;
+  *ppContext = pContext;
+  return S_OK;
+}
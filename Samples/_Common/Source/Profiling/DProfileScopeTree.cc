@@ -0,0 +1,109 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <Profiling/DProfileScopeTree.h>
+
+#include <algorithm>
+#include <cassert>
+
+std::size_t DProfileScopeTree::FindOrInsert(const std::string& name, std::size_t parent)
+{
+  const auto& siblings = parent == kNone ? this->mRoots : this->mNodes[parent].mChildren;
+
+  const auto it = std::find_if(
+    siblings.begin(), siblings.end(), 
+    [this, &name](std::size_t index) { return this->mNodes[index].mName == name; });
+  if (it != siblings.end()) { return *it; }
+
+  return this->Insert(kNoTag, name, parent);
+}
+
+std::size_t DProfileScopeTree::FindOrInsert(uint32_t tagId, const std::string& name, std::size_t parent)
+{
+  const auto& siblings = parent == kNone ? this->mRoots : this->mNodes[parent].mChildren;
+
+  const auto it = std::find_if(
+    siblings.begin(), siblings.end(), 
+    [this, tagId](std::size_t index) { return this->mNodes[index].mTagId == tagId; });
+  if (it != siblings.end()) { return *it; }
+
+  return this->Insert(tagId, name, parent);
+}
+
+std::size_t DProfileScopeTree::Insert(uint32_t tagId, const std::string& name, std::size_t parent)
+{
+  auto& siblings = parent == kNone ? this->mRoots : this->mNodes[parent].mChildren;
+
+  // `siblings` can be invalidated by inserting new node, so push index first.
+  const auto index = this->mNodes.size();
+  siblings.emplace_back(index);
+  auto& node = this->mNodes.emplace_back();
+  node.mName = name;
+  node.mParent = parent;
+  node.mTagId = tagId;
+  return index;
+}
+
+void DProfileScopeTree::AddTime(std::size_t index, const DProfileScopeNode::TTimeStamp& elapsedTime)
+{
+  assert(index < this->mNodes.size());
+
+  auto& node = this->mNodes[index];
+  node.mTotal += elapsedTime;
+  node.mCallCount += 1;
+}
+
+void DProfileScopeTree::CalculateSelfTimes()
+{
+  for (auto& node : this->mNodes)
+  {
+    auto childrenTotal = DProfileScopeNode::TTimeStamp{0};
+    for (const auto childIndex : node.mChildren)
+    {
+      childrenTotal += this->mNodes[childIndex].mTotal;
+    }
+
+    node.mSelf = std::max(node.mTotal - childrenTotal, DProfileScopeNode::TTimeStamp{0});
+  }
+}
+
+void DProfileScopeTree::Clear() noexcept
+{
+  this->mNodes.clear();
+  this->mRoots.clear();
+}
+
+const DProfileScopeNode& DProfileScopeTree::operator[](std::size_t index) const noexcept
+{
+  return this->mNodes[index];
+}
+
+const std::vector<DProfileScopeNode>& DProfileScopeTree::GetNodes() const noexcept
+{
+  return this->mNodes;
+}
+
+const std::vector<std::size_t>& DProfileScopeTree::GetRoots() const noexcept
+{
+  return this->mRoots;
+}
+
+DProfileScopeNode::TTimeStamp DProfileScopeTree::GetTotal() const noexcept
+{
+  auto total = DProfileScopeNode::TTimeStamp{0};
+  for (const auto rootIndex : this->mRoots)
+  {
+    total += this->mNodes[rootIndex].mTotal;
+  }
+  return total;
+}
@@ -12,26 +12,45 @@
 ///
 
 #include <Profiling/FCpuTimeHandle.h>
-#include <Profiling/FTimeContainer.h>
+#include <Profiling/MTimeChecker.h>
 
-FCpuTimeHandle::FCpuTimeHandle(FTimeContainer& container)
-  : mContainer{container},
-    mStart{std::chrono::steady_clock::now()}
-{ }
+FCpuTimeHandle::FCpuTimeHandle(uint32_t tagId, uint32_t depth)
+  : mTagId{tagId},
+    mDepth{depth}
+{ 
+  // Counters are read outside of timed region, so reading cost is not included in time.
+#if PROFILING_HARDWARE_COUNTERS == 1
+  this->mStartCounters = MTimeChecker::GetThreadBuffer().ReadHardwareCounters();
+#endif
+  this->mStart = XCpuClock::Now();
+}
 
 FCpuTimeHandle::~FCpuTimeHandle()
 {
   if (this->mIsMoved == false)
   {
-    this->mEnd = std::chrono::steady_clock::now();
-    TTimeStamp duration = this->mEnd - this->mStart;
+    const auto end = XCpuClock::Now();
 
-    this->mContainer.Insert(duration);
+    DProfileEvent event;
+    event.mTagId = this->mTagId;
+    event.mDepth = this->mDepth;
+    event.mStartTicks = this->mStart;
+    event.mDurationTicks = end - this->mStart;
+#if PROFILING_HARDWARE_COUNTERS == 1
+    event.mCounters = MTimeChecker::GetThreadBuffer().ReadHardwareCounters() - this->mStartCounters;
+#endif
+    MTimeChecker::EndCpuScope(event);
   }
 }
 
 FCpuTimeHandle::FCpuTimeHandle(FCpuTimeHandle&& handle) noexcept
   : mIsMoved{handle.mIsMoved},
-    mContainer{handle.mContainer},
+    mTagId{handle.mTagId},
+    mDepth{handle.mDepth},
     mStart{handle.mStart}
-{ }
+#if PROFILING_HARDWARE_COUNTERS == 1
+    , mStartCounters{handle.mStartCounters}
+#endif
+{ 
+  handle.mIsMoved = true;
+}
@@ -0,0 +1,87 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <Profiling/FD3D11QueryPool.h>
+
+#include <cassert>
+#include <d3d11.h>
+#include <Graphics/MD3D11Resources.h>
+
+FD3D11QueryPool::FD3D11QueryPool(const D11HandleDevice& hDevice)
+  : mDevice{hDevice}
+{ }
+
+FD3D11QueryPool::~FD3D11QueryPool()
+{
+  this->Release();
+}
+
+ID3D11Query& FD3D11QueryPool::NextFrame()
+{
+  this->mSetIndex = (this->mSetIndex + 1) % kSetCount;
+
+  auto& set = this->mSets[this->mSetIndex];
+  if (set.mDisjoint.mPtr == nullptr)
+  {
+    set.mDisjoint = this->CreateQuery(true);
+  }
+
+  return *set.mDisjoint.mPtr;
+}
+
+std::pair<ID3D11Query*, ID3D11Query*> 
+FD3D11QueryPool::GetFragmentQueries(const std::string& fragmentName)
+{
+  auto& fragments = this->mSets[this->mSetIndex].mFragments;
+
+  auto it = fragments.find(fragmentName);
+  if (it == fragments.end())
+  {
+    it = fragments.try_emplace(fragmentName, this->CreateQuery(false), this->CreateQuery(false)).first;
+  }
+
+  const auto& [start, end] = it->second;
+  return {start.mPtr, end.mPtr};
+}
+
+void FD3D11QueryPool::Release()
+{
+  const auto RemoveQuery = [](DQuery& query)
+  {
+    if (query.mHandle.IsValid() == true) { MD3D11Resources::RemoveQuery(query.mHandle); }
+    query = DQuery{};
+  };
+
+  for (auto& set : this->mSets)
+  {
+    RemoveQuery(set.mDisjoint);
+    for (auto& [fragmentName, pair] : set.mFragments)
+    {
+      RemoveQuery(pair.first);
+      RemoveQuery(pair.second);
+    }
+    set.mFragments.clear();
+  }
+}
+
+FD3D11QueryPool::DQuery FD3D11QueryPool::CreateQuery(bool isDisjoint)
+{
+  const auto type = isDisjoint == true 
+    ? E11SimpleQueryType::TimeStampDisjoint 
+    : E11SimpleQueryType::TimeStampFragment;
+
+  auto optHandle = MD3D11Resources::CreateQuerySimple(this->mDevice, type);
+  assert(optHandle.has_value() == true);
+
+  return DQuery{*optHandle, MD3D11Resources::GetQuery(*optHandle).GetPtr()};
+}
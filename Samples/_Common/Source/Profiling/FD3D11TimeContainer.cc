@@ -13,6 +13,16 @@
 
 #include <Profiling/FD3D11TimeContainer.h>
 
+#include <algorithm>
+#include <limits>
+#include <d3d11.h>
+#include <Profiling/MTraceCapture.h>
+
+FD3D11TimeContainer::FD3D11TimeContainer(const std::string& name)
+  : mName{name},
+    mTraceTrackId{MTraceCapture::AllocateTrackId()}
+{ }
+
 const FTimeContainer& 
 FD3D11TimeContainer::operator[](const std::string& fragmentName) const noexcept
 {
@@ -24,7 +34,9 @@ bool FD3D11TimeContainer::HasFragment(const std::string& fragmentName) const noe
   return this->mFragments.find(fragmentName) != this->mFragments.end();
 }
 
-void FD3D11TimeContainer::Insert(const FD3D11TimeHandle::TTimeStamps& elapsedTimes)
+void FD3D11TimeContainer::Insert(
+  const FD3D11TimeHandle::TTimeStamps& elapsedTimes,
+  const FD3D11TimeHandle::TFragmentParents& fragmentParents)
 {
   for (auto& [fragmentName, timeStamp] : elapsedTimes)
   {
@@ -35,4 +47,158 @@ void FD3D11TimeContainer::Insert(const FD3D11TimeHandle::TTimeStamps& elapsedTim
 
     this->mFragments[fragmentName].Insert(TTimeStamp{timeStamp / 1000.0});
   }
+
+  // Disjoint frame has no result, so keep the tree of previous frame.
+  if (elapsedTimes.empty() == true || fragmentParents.empty() == true) { return; }
+
+  // Parents are always checked before their children, so parent node is already inserted.
+  this->mScopeTree.Clear();
+  std::unordered_map<std::string, std::size_t> nodeIndices;
+  for (const auto& [fragmentName, parentName] : fragmentParents)
+  {
+    const auto itTime = elapsedTimes.find(fragmentName);
+    if (itTime == elapsedTimes.end()) { continue; }
+
+    const auto itParent = nodeIndices.find(parentName);
+    const auto parent = itParent == nodeIndices.end() ? DProfileScopeTree::kNone : itParent->second;
+
+    const auto index = this->mScopeTree.FindOrInsert(fragmentName, parent);
+    this->mScopeTree.AddTime(index, TTimeStamp{itTime->second / 1000.0});
+    nodeIndices.try_emplace(fragmentName, index);
+  }
+  this->mScopeTree.CalculateSelfTimes();
+}
+
+void FD3D11TimeContainer::Trace(
+  const FD3D11TimeHandle::TTimePoint& beginTime,
+  const FD3D11TimeHandle::TTimeStamps& startOffsets,
+  const FD3D11TimeHandle::TTimeStamps& elapsedTimes) const
+{
+  if (MTraceCapture::IsCapturing() == false) { return; }
+
+  for (const auto& [fragmentName, msElapsed] : elapsedTimes)
+  {
+    const auto itOffset = startOffsets.find(fragmentName);
+    const auto msOffset = itOffset == startOffsets.end() ? 0.0 : itOffset->second;
+
+    // Key of fragment container is not moved until this container is destroyed, so pass it as event name.
+    const auto start = beginTime 
+      + std::chrono::duration_cast<std::chrono::steady_clock::duration>(TTimeStamp{msOffset / 1000.0});
+    MTraceCapture::AddCompleteEvent(
+      this->mFragments.find(fragmentName)->first.c_str(), 
+      "gpu",
+      this->mTraceTrackId,
+      this->mName.c_str(),
+      start,
+      TTimeStamp{msElapsed / 1000.0});
+  }
+}
+
+const DProfileScopeTree& FD3D11TimeContainer::GetScopeTree() const noexcept
+{
+  return this->mScopeTree;
+}
+
+void FD3D11TimeContainer::Enqueue(
+  ID3D11Query& disjointQuery, 
+  FD3D11TimeHandle::TTimeFragments&& fragments,
+  FD3D11TimeHandle::TFragmentParents&& fragmentParents,
+  const FD3D11TimeHandle::TTimePoint& beginTime)
+{
+  if (this->mPendingFrames.size() >= kMaxInFlightFrames)
+  {
+    this->mPendingFrames.pop_front();
+    this->mDroppedFrameCount += 1;
+  }
+
+  this->mPendingFrames.push_back(
+    DPendingFrame{&disjointQuery, std::move(fragments), std::move(fragmentParents), beginTime});
+}
+
+void FD3D11TimeContainer::TryResolve(ID3D11DeviceContext& deviceContext)
+{
+  while (this->mPendingFrames.empty() == false)
+  {
+    auto& frame = this->mPendingFrames.front();
+
+    FD3D11TimeHandle::TTimeStamps startOffsets;
+    auto optResults = TryGetTimestamps(deviceContext, frame, startOffsets);
+    if (optResults.has_value() == false) { break; }
+
+    this->Insert(*optResults, frame.mFragmentParents);
+    this->Trace(frame.mBeginTime, startOffsets, *optResults);
+    this->mPendingFrames.pop_front();
+  }
+}
+
+void FD3D11TimeContainer::DiscardPending(const ID3D11Query& disjointQuery)
+{
+  const auto itEnd = std::remove_if(
+    this->mPendingFrames.begin(), this->mPendingFrames.end(),
+    [pQuery = &disjointQuery](const DPendingFrame& frame) { return frame.mDisjointQuery == pQuery; });
+
+  this->mDroppedFrameCount += std::distance(itEnd, this->mPendingFrames.end());
+  this->mPendingFrames.erase(itEnd, this->mPendingFrames.end());
+}
+
+void FD3D11TimeContainer::DiscardAllPending()
+{
+  this->mDroppedFrameCount += this->mPendingFrames.size();
+  this->mPendingFrames.clear();
+}
+
+std::size_t FD3D11TimeContainer::GetDroppedFrameCount() const noexcept
+{
+  return this->mDroppedFrameCount;
+}
+
+std::optional<FD3D11TimeHandle::TTimeStamps> 
+FD3D11TimeContainer::TryGetTimestamps(
+  ID3D11DeviceContext& deviceContext, 
+  DPendingFrame& frame,
+  FD3D11TimeHandle::TTimeStamps& outStartOffsets)
+{
+  // Do not flush command buffer, just check results are arrived.
+  constexpr UINT flags = D3D11_ASYNC_GETDATA_DONOTFLUSH;
+
+  D3D11_QUERY_DATA_TIMESTAMP_DISJOINT tsDisjoint;
+  if (deviceContext.GetData(frame.mDisjointQuery, &tsDisjoint, sizeof(tsDisjoint), flags) != S_OK)
+  {
+    return std::nullopt;
+  }
+
+  // Read all fragment timestamps first, because timestamps can arrive later than disjoint.
+  FD3D11TimeHandle::TTimeStamps results;
+  std::unordered_map<std::string, UINT64> beginTicks;
+  UINT64 minBeginTick = std::numeric_limits<UINT64>::max();
+  for (auto& [fragmentName, pair] : frame.mFragments)
+  {
+    auto& [start, end] = pair;
+
+    UINT64 tsBegin, tsEnd;
+    if (deviceContext.GetData(start, &tsBegin, sizeof(UINT64), flags) != S_OK
+    ||  deviceContext.GetData(end, &tsEnd, sizeof(UINT64), flags) != S_OK)
+    {
+      return std::nullopt;
+    }
+
+    // Convert to real time (ms).
+    const auto msFragment = double(tsEnd - tsBegin) / double(tsDisjoint.Frequency) * 1'000.0;
+    results.try_emplace(fragmentName, msFragment);
+    beginTicks.try_emplace(fragmentName, tsBegin);
+    minBeginTick = std::min(minBeginTick, tsBegin);
+  }
+
+  // If timestamps were disjoint, results are not reliable. Just return empty results.
+  if (tsDisjoint.Disjoint) 
+  { 
+    results.clear(); 
+    return results;
+  }
+
+  for (const auto& [fragmentName, tick] : beginTicks)
+  {
+    outStartOffsets[fragmentName] = double(tick - minBeginTick) / double(tsDisjoint.Frequency) * 1'000.0;
+  }
+  return results;
 }
@@ -12,7 +12,8 @@
 ///
 
 #include <Profiling/FD3D11TimeFragment.h>
-#include <D3D11.h>
+#include <d3d11.h>
+#include <Profiling/FD3D11TimeHandle.h>
 
 FD3D11TimeFragment::FD3D11TimeFragment(
   FD3D11TimeHandle& parentHandle,
@@ -32,6 +33,7 @@ FD3D11TimeFragment::~FD3D11TimeFragment()
   if (this->mIsMoved == false)
   {
     this->mDC.End(&this->mEndQuery);
+    this->mContainer.EndFragment();
   }
 }
 
@@ -13,8 +13,11 @@
 
 #include <Profiling/FD3D11TimeHandle.h>
 
+#include <algorithm>
 #include <cassert>
-#include <D3D11.h>
+#include <limits>
+#include <d3d11.h>
+#include <Profiling/FD3D11QueryPool.h>
 #include <Profiling/FD3D11TimeContainer.h>
 
 FD3D11TimeHandle::FD3D11TimeHandle(
@@ -25,28 +28,54 @@ FD3D11TimeHandle::FD3D11TimeHandle(
   : mIsUpdateDeferred{isUpdateDeferred},
     mContainer{container},
     mDC{deviceContext},
-    mDisjointQuery{disjointQuery}
+    mDisjointQuery{disjointQuery},
+    mBeginTime{std::chrono::steady_clock::now()}
 {
+  // If deferred, results of old frame that used this disjoint query can not be read anymore.
+  if (this->mIsUpdateDeferred == true)
+  {
+    this->mContainer.TryResolve(this->mDC);
+    this->mContainer.DiscardPending(this->mDisjointQuery);
+  }
+
   this->mDC.Begin(&this->mDisjointQuery);
 }
 
+FD3D11TimeHandle::FD3D11TimeHandle(
+  FD3D11TimeContainer& container,
+  FD3D11QueryPool& queryPool,
+  ID3D11DeviceContext& deviceContext)
+  : FD3D11TimeHandle{container, queryPool.NextFrame(), deviceContext, true}
+{
+  this->mPtrQueryPool = &queryPool;
+}
+
 FD3D11TimeHandle::~FD3D11TimeHandle()
 {
   if (this->mIsMoved == false)
   {
-    // If update should be deferred, 
+    this->mDC.End(&this->mDisjointQuery);
+
+    // If update should be deferred, enqueue queries and read results of previous frames if arrived.
     if (this->mIsUpdateDeferred == true)
     {
-      assert(false);
+      this->mContainer.Enqueue(
+        this->mDisjointQuery, 
+        std::move(this->mTimeFragments), 
+        std::move(this->mFragmentParents),
+        this->mBeginTime);
+      this->mContainer.TryResolve(this->mDC);
       return;
     }
 
-    // If not, end disjoint query and stall thread to get time stamps.
-    this->mDC.End(&this->mDisjointQuery);
-    const auto results = this->CalculateTimestamps(this->mDC, this->mDisjointQuery, this->mTimeFragments);
+    // If not, stall thread to get time stamps.
+    TTimeStamps startOffsets;
+    const auto results = this->CalculateTimestamps(
+      this->mDC, this->mDisjointQuery, this->mTimeFragments, startOffsets);
 
     // Insert results into container.
-    this->mContainer.Insert(results);
+    this->mContainer.Insert(results, this->mFragmentParents);
+    this->mContainer.Trace(this->mBeginTime, startOffsets, results);
   }
 }
 
@@ -55,7 +84,12 @@ FD3D11TimeHandle::FD3D11TimeHandle(FD3D11TimeHandle&& handle) noexcept
     mIsUpdateDeferred{handle.mIsUpdateDeferred},
     mContainer{handle.mContainer},
     mDC{handle.mDC},
-    mDisjointQuery{handle.mDisjointQuery}
+    mDisjointQuery{handle.mDisjointQuery},
+    mPtrQueryPool{handle.mPtrQueryPool},
+    mBeginTime{handle.mBeginTime},
+    mTimeFragments{std::move(handle.mTimeFragments)},
+    mFragmentParents{std::move(handle.mFragmentParents)},
+    mOpenedFragments{std::move(handle.mOpenedFragments)}
 { 
   handle.mIsMoved = true;
 }
@@ -68,20 +102,43 @@ FD3D11TimeFragment FD3D11TimeHandle::CheckFragment(
   if (this->mTimeFragments.find(fragmentName) == this->mTimeFragments.end())
   {
     this->mTimeFragments.try_emplace(fragmentName, &startQuery, &endQuery);
+
+    // Fragment is nested into the innermost opened fragment.
+    this->mFragmentParents.emplace_back(
+      fragmentName, 
+      this->mOpenedFragments.empty() == true ? std::string{} : this->mOpenedFragments.back());
   }
+  this->mOpenedFragments.emplace_back(fragmentName);
 
   return std::move(
     FD3D11TimeFragment{*this, this->mDC, startQuery, endQuery}
   );
 }
 
+FD3D11TimeFragment FD3D11TimeHandle::CheckFragment(const std::string& fragmentName)
+{
+  assert(this->mPtrQueryPool != nullptr);
+
+  auto [pStart, pEnd] = this->mPtrQueryPool->GetFragmentQueries(fragmentName);
+  return this->CheckFragment(fragmentName, *pStart, *pEnd);
+}
+
+void FD3D11TimeHandle::EndFragment()
+{
+  assert(this->mOpenedFragments.empty() == false);
+  this->mOpenedFragments.pop_back();
+}
+
 std::unordered_map<std::string, double>
 FD3D11TimeHandle::CalculateTimestamps(
   ID3D11DeviceContext& dc, 
   ID3D11Query& disjoint, 
-  TTimeFragments& fragments)
+  TTimeFragments& fragments,
+  TTimeStamps& outStartOffsets)
 {
   std::unordered_map<std::string, double> results;
+  std::unordered_map<std::string, UINT64> beginTicks;
+  UINT64 minBeginTick = std::numeric_limits<UINT64>::max();
 
   // Stall until disjointQuery is available.
   while (dc.GetData(&disjoint, nullptr, 0, 0) == S_FALSE)
@@ -122,6 +179,13 @@ FD3D11TimeHandle::CalculateTimestamps(
         double(tsEndFrame - tsBeginFrame) / double(tsDisjoint.Frequency) 
       * 1'000.0;
     results.try_emplace(fragmentName, msGpuFrame);
+    beginTicks.try_emplace(fragmentName, tsBeginFrame);
+    minBeginTick = std::min(minBeginTick, tsBeginFrame);
+  }
+
+  for (const auto& [fragmentName, tick] : beginTicks)
+  {
+    outStartOffsets[fragmentName] = double(tick - minBeginTick) / double(tsDisjoint.Frequency) * 1'000.0;
   }
 
   return results;
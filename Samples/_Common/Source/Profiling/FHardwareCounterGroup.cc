@@ -0,0 +1,120 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <Profiling/FHardwareCounterGroup.h>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+
+/// @brief Open user-space hardware counter of calling thread into group.
+/// If group is -1, counter becomes disabled group leader.
+int OpenCounter(uint64_t config, int group) noexcept
+{
+  perf_event_attr attribute;
+  std::memset(&attribute, 0, sizeof(attribute));
+  attribute.size = sizeof(attribute);
+  attribute.type = PERF_TYPE_HARDWARE;
+  attribute.config = config;
+  attribute.disabled = group == -1 ? 1 : 0;
+  attribute.exclude_kernel = 1;
+  attribute.exclude_hv = 1;
+  attribute.read_format = PERF_FORMAT_GROUP;
+
+  return int(syscall(__NR_perf_event_open, &attribute, 0, -1, group, 0));
+}
+
+} /// ::anonymous namespace
+#endif
+
+FHardwareCounterGroup::FHardwareCounterGroup()
+{
+#if defined(__linux__)
+  constexpr std::array<uint64_t, 4> kConfigs = 
+  {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+  };
+
+  for (std::size_t i = 0; i < kConfigs.size(); ++i)
+  {
+    this->mFileDescriptors[i] = OpenCounter(kConfigs[i], this->mFileDescriptors[0]);
+    if (this->mFileDescriptors[i] == -1) 
+    { 
+      this->Close(); 
+      return; 
+    }
+  }
+
+  const int leader = this->mFileDescriptors[0];
+  ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  this->mIsValid = true;
+#endif
+}
+
+FHardwareCounterGroup::~FHardwareCounterGroup()
+{
+  this->Close();
+}
+
+bool FHardwareCounterGroup::IsValid() const noexcept
+{
+  return this->mIsValid;
+}
+
+DHardwareCounters FHardwareCounterGroup::Read() const noexcept
+{
+  DHardwareCounters counters;
+#if defined(__linux__)
+  if (this->mIsValid == false) { return counters; }
+
+  // PERF_FORMAT_GROUP layout is the number of counters and values in opened order.
+  struct DGroupValues final
+  {
+    uint64_t mCount;
+    uint64_t mValues[4];
+  } values;
+  if (read(this->mFileDescriptors[0], &values, sizeof(values)) != ssize_t(sizeof(values))) 
+  { 
+    return counters; 
+  }
+
+  counters.mCycles       = values.mValues[0];
+  counters.mInstructions = values.mValues[1];
+  counters.mCacheMisses  = values.mValues[2];
+  counters.mBranchMisses = values.mValues[3];
+#endif
+  return counters;
+}
+
+void FHardwareCounterGroup::Close() noexcept
+{
+#if defined(__linux__)
+  // Members must be closed before group leader.
+  for (auto it = this->mFileDescriptors.rbegin(); it != this->mFileDescriptors.rend(); ++it)
+  {
+    if (*it != -1) { close(*it); }
+    *it = -1;
+  }
+#endif
+  this->mIsValid = false;
+}
@@ -0,0 +1,84 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <Profiling/FProfileThreadBuffer.h>
+
+#include <cassert>
+
+FProfileThreadBuffer::FProfileThreadBuffer(uint32_t trackId, bool isFrameThread)
+  : mIsFrameThread{isFrameThread},
+    mTrackId{trackId}
+{ }
+
+uint32_t FProfileThreadBuffer::EnterScope() noexcept
+{
+  return this->mDepth++;
+}
+
+void FProfileThreadBuffer::ExitScope(const DProfileEvent& event) noexcept
+{
+  assert(this->mDepth > 0);
+  this->mDepth -= 1;
+
+  if (this->mEvents.TryPush(event) == false)
+  {
+    this->mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+bool FProfileThreadBuffer::TryPop(DProfileEvent& outEvent) noexcept
+{
+  return this->mEvents.TryPop(outEvent);
+}
+
+void FProfileThreadBuffer::Retire() noexcept
+{
+  this->mIsRetired.store(true, std::memory_order_release);
+}
+
+bool FProfileThreadBuffer::IsRetired() const noexcept
+{
+  return this->mIsRetired.load(std::memory_order_acquire);
+}
+
+bool FProfileThreadBuffer::IsFrameThread() const noexcept
+{
+  return this->mIsFrameThread.load(std::memory_order_acquire);
+}
+
+void FProfileThreadBuffer::SetFrameThread(bool isFrameThread) noexcept
+{
+  this->mIsFrameThread.store(isFrameThread, std::memory_order_release);
+}
+
+uint32_t FProfileThreadBuffer::GetTrackId() const noexcept
+{
+  return this->mTrackId;
+}
+
+std::size_t FProfileThreadBuffer::GetDroppedCount() const noexcept
+{
+  return this->mDroppedCount.load(std::memory_order_relaxed);
+}
+
+#if PROFILING_HARDWARE_COUNTERS == 1
+bool FProfileThreadBuffer::HasHardwareCounters() const noexcept
+{
+  return this->mCounterGroup.IsValid();
+}
+
+DHardwareCounters FProfileThreadBuffer::ReadHardwareCounters() const noexcept
+{
+  return this->mCounterGroup.Read();
+}
+#endif
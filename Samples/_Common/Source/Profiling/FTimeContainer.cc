@@ -13,11 +13,46 @@
 
 #include <Profiling/FTimeContainer.h>
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+FTimeContainer::FTimeContainer(std::size_t windowLength)
+{
+  this->SetWindowLength(windowLength);
+}
+
 std::size_t FTimeContainer::Length() const noexcept
 {
   return this->mElapsedSeconds.size();
 }
 
+std::size_t FTimeContainer::GetWindowLength() const noexcept
+{
+  return this->mWindowLength;
+}
+
+void FTimeContainer::SetWindowLength(std::size_t windowLength)
+{
+  assert(windowLength > 0);
+
+  this->mWindowLength = windowLength;
+  this->mElapsedSeconds.clear();
+  this->mElapsedSeconds.reserve(windowLength);
+  this->mPresentIndex = 0;
+
+  this->mMean = 0.0;
+  this->mSquaredDiffSum = 0.0;
+  this->mHistogram.Clear();
+  this->mMaxCandidates.clear();
+  this->mInsertedCount = 0;
+
+  this->mCounters.clear();
+  this->mIsCounterValid.clear();
+  this->mValidCounterCount = 0;
+  this->mCounterSum = DHardwareCounters{};
+}
+
 TTimeStamp FTimeContainer::GetRecent() const noexcept
 {
   if (this->Length() == 0)
@@ -25,9 +60,9 @@ TTimeStamp FTimeContainer::GetRecent() const noexcept
     return TTimeStamp(-1.0);
   }
 
-  if (this->Length() == kMax)
+  if (this->Length() == this->mWindowLength)
   {
-    if (this->mPresentIndex == 0) { return this->mElapsedSeconds[kMax - 1]; }
+    if (this->mPresentIndex == 0) { return this->mElapsedSeconds[this->mWindowLength - 1]; }
     else                          { return this->mElapsedSeconds[this->mPresentIndex - 1]; }
   }
   else
@@ -43,13 +78,43 @@ TTimeStamp FTimeContainer::GetAverage() const noexcept
     return TTimeStamp(-1.0);
   }
 
-  auto sum = TTimeStamp(0);
-  for (const auto& elapsedSecond : this->mElapsedSeconds)
+  return TTimeStamp(this->mMean);
+}
+
+double FTimeContainer::GetVariance() const noexcept
+{
+  if (this->Length() == 0)
   {
-    sum += elapsedSecond;
+    return -1.0;
   }
 
-  return sum / this->Length();
+  // Population variance of window. Rounding error can make sum slightly negative.
+  return std::max(this->mSquaredDiffSum, 0.0) / double(this->Length());
+}
+
+TTimeStamp FTimeContainer::GetStandardDeviation() const noexcept
+{
+  if (this->Length() == 0)
+  {
+    return TTimeStamp(-1.0);
+  }
+
+  return TTimeStamp(std::sqrt(this->GetVariance()));
+}
+
+TTimeStamp FTimeContainer::GetPercentile(double ratio) const noexcept
+{
+  return this->mHistogram.GetPercentile(ratio);
+}
+
+TTimeStamp FTimeContainer::GetMax() const noexcept
+{
+  if (this->Length() == 0)
+  {
+    return TTimeStamp(-1.0);
+  }
+
+  return this->mMaxCandidates.front().second;
 }
 
 TTimeStamp FTimeContainer::operator[](std::size_t index) const noexcept
@@ -59,14 +124,118 @@ TTimeStamp FTimeContainer::operator[](std::size_t index) const noexcept
 
 void FTimeContainer::Insert(const TTimeStamp& elapsedTime)
 {
-  if (this->Length() == kMax)
+  this->InsertCounters(DHardwareCounters{}, false);
+  this->InsertTime(elapsedTime);
+}
+
+void FTimeContainer::Insert(const TTimeStamp& elapsedTime, const DHardwareCounters& counters)
+{
+  this->InsertCounters(counters, true);
+  this->InsertTime(elapsedTime);
+}
+
+void FTimeContainer::InsertTime(const TTimeStamp& elapsedTime)
+{
+  const double value = elapsedTime.count();
+
+  if (this->Length() == this->mWindowLength)
   {
+    // Replace the oldest item, and update statistics as sliding window.
+    const auto oldest = this->mElapsedSeconds[this->mPresentIndex];
+    const double oldValue = oldest.count();
+    const double oldMean = this->mMean;
+
+    this->mMean += (value - oldValue) / double(this->mWindowLength);
+    this->mSquaredDiffSum += (value - oldValue) * (value - this->mMean + oldValue - oldMean);
+
+    this->mHistogram.Remove(oldest);
     this->mElapsedSeconds[this->mPresentIndex] = elapsedTime;
   }
   else
   {
+    // Welford's online algorithm.
     this->mElapsedSeconds.emplace_back(elapsedTime);
+
+    const double delta = value - this->mMean;
+    this->mMean += delta / double(this->Length());
+    this->mSquaredDiffSum += delta * (value - this->mMean);
+  }
+
+  this->mHistogram.Add(elapsedTime);
+
+  // Keep candidates decreasing, and drop the front candidate when it goes out of window.
+  while (this->mMaxCandidates.empty() == false && this->mMaxCandidates.back().second <= elapsedTime)
+  {
+    this->mMaxCandidates.pop_back();
+  }
+  this->mMaxCandidates.emplace_back(this->mInsertedCount, elapsedTime);
+  if (this->mMaxCandidates.front().first + this->mWindowLength <= this->mInsertedCount)
+  {
+    this->mMaxCandidates.pop_front();
+  }
+
+  this->mInsertedCount += 1;
+  this->mPresentIndex = (this->mPresentIndex + 1) % this->mWindowLength;
+}
+
+void FTimeContainer::InsertCounters(const DHardwareCounters& counters, bool isValid)
+{
+  // Nothing to track until the first counters arrive, so containers without counters stay lean.
+  if (this->mCounters.empty() == true)
+  {
+    if (isValid == false) { return; }
+
+    // Slots of time stamps inserted before have no counters.
+    this->mCounters.resize(this->Length());
+    this->mIsCounterValid.resize(this->Length(), false);
   }
+  assert(this->mCounters.size() == this->Length());
+
+  // Time stamp will be placed at present index, so put counters at the same index.
+  if (this->Length() == this->mWindowLength)
+  {
+    if (this->mIsCounterValid[this->mPresentIndex] == true)
+    {
+      this->mCounterSum -= this->mCounters[this->mPresentIndex];
+      this->mValidCounterCount -= 1;
+    }
+    this->mCounters[this->mPresentIndex] = counters;
+    this->mIsCounterValid[this->mPresentIndex] = isValid;
+  }
+  else
+  {
+    this->mCounters.emplace_back(counters);
+    this->mIsCounterValid.emplace_back(isValid);
+  }
+
+  if (isValid == true)
+  {
+    this->mCounterSum += counters;
+    this->mValidCounterCount += 1;
+  }
+}
+
+bool FTimeContainer::HasCounters() const noexcept
+{
+  return this->mValidCounterCount > 0;
+}
+
+DHardwareCounters FTimeContainer::GetAverageCounters() const noexcept
+{
+  if (this->HasCounters() == false) { return DHardwareCounters{}; }
+
+  const auto count = uint64_t(this->mValidCounterCount);
+  DHardwareCounters average;
+  average.mCycles       = this->mCounterSum.mCycles / count;
+  average.mInstructions = this->mCounterSum.mInstructions / count;
+  average.mCacheMisses  = this->mCounterSum.mCacheMisses / count;
+  average.mBranchMisses = this->mCounterSum.mBranchMisses / count;
+  return average;
+}
+
+double FTimeContainer::GetInstructionsPerCycle() const noexcept
+{
+  if (this->HasCounters() == false || this->mCounterSum.mCycles == 0) { return -1.0; }
 
-  this->mPresentIndex = (this->mPresentIndex + 1) % kMax;
+  return double(this->mCounterSum.mInstructions) / double(this->mCounterSum.mCycles);
 }
@@ -0,0 +1,96 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <Profiling/FTimeHistogram.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void FTimeHistogram::Add(const TTimeStamp& elapsedTime) noexcept
+{
+  this->mBuckets[GetBucketIndex(elapsedTime)] += 1;
+  this->mCount += 1;
+}
+
+void FTimeHistogram::Remove(const TTimeStamp& elapsedTime) noexcept
+{
+  auto& bucket = this->mBuckets[GetBucketIndex(elapsedTime)];
+  assert(bucket > 0 && this->mCount > 0);
+
+  bucket -= 1;
+  this->mCount -= 1;
+}
+
+void FTimeHistogram::Clear() noexcept
+{
+  this->mBuckets.fill(0);
+  this->mCount = 0;
+}
+
+FTimeHistogram::TTimeStamp FTimeHistogram::GetPercentile(double ratio) const noexcept
+{
+  if (this->mCount == 0) { return TTimeStamp(-1.0); }
+
+  // Find the first bucket which cumulative count reaches rank.
+  const auto rank = std::max<std::size_t>(
+    1, 
+    std::size_t(std::ceil(std::clamp(ratio, 0.0, 1.0) * double(this->mCount))));
+
+  std::size_t cumulative = 0;
+  for (std::size_t i = 0; i < kBucketCount; ++i)
+  {
+    cumulative += this->mBuckets[i];
+    if (cumulative >= rank) { return GetBucketValue(i); }
+  }
+
+  return GetBucketValue(kBucketCount - 1);
+}
+
+std::size_t FTimeHistogram::GetCount() const noexcept
+{
+  return this->mCount;
+}
+
+std::size_t FTimeHistogram::GetBucketIndex(const TTimeStamp& elapsedTime) noexcept
+{
+  const auto us = std::clamp(
+    elapsedTime.count() * 1'000'000.0, 
+    0.0, 
+    double((uint64_t{1} << (kMaxExponent + 1)) - 1));
+  const auto value = uint64_t(us);
+
+  // Values in [0, 2 * kSubBucketCount) have their own bucket.
+  if (value < kSubBucketCount * 2) { return std::size_t(value); }
+
+  // Otherwise, [2^e, 2^(e+1)) range is divided into kSubBucketCount buckets.
+  uint32_t exponent = 0;
+  while ((value >> (exponent + 1)) != 0) { exponent += 1; }
+
+  const auto shift = exponent - kSubBucketBits;
+  const auto subBucket = (value >> shift) - kSubBucketCount;
+  return (kSubBucketCount * 2) + (exponent - kSubBucketBits - 1) * kSubBucketCount + std::size_t(subBucket);
+}
+
+FTimeHistogram::TTimeStamp FTimeHistogram::GetBucketValue(std::size_t index) noexcept
+{
+  if (index < kSubBucketCount * 2) { return TTimeStamp((double(index) + 0.5) / 1'000'000.0); }
+
+  const auto exponent = uint32_t((index - kSubBucketCount * 2) / kSubBucketCount) + kSubBucketBits + 1;
+  const auto subBucket = (index - kSubBucketCount * 2) % kSubBucketCount + kSubBucketCount;
+
+  const auto shift = exponent - kSubBucketBits;
+  const auto lower = double(uint64_t(subBucket) << shift);
+  const auto width = double(uint64_t{1} << shift);
+  return TTimeStamp((lower + width * 0.5) / 1'000'000.0);
+}
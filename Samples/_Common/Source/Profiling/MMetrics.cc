@@ -0,0 +1,421 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <Profiling/MMetrics.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <AProfilingBase.h>
+#include <Graphics/MD3D11Resources.h>
+#include <Profiling/MTraceCapture.h>
+
+/// @def PROFILING_TRACK_ALLOCATIONS
+/// @brief If 1, global operator new and delete are replaced to count allocations for allocation rate metrics.
+/// Counting costs one relaxed atomic addition per allocation.
+/// Replacement affects every program that links Common, so it is set only by CMake option of same name.
+#ifndef PROFILING_TRACK_ALLOCATIONS
+#define PROFILING_TRACK_ALLOCATIONS 0
+#endif
+
+#if PROFILING_TRACK_ALLOCATIONS == 1 && defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+std::mutex MMetrics::mMutex;
+std::array<MMetrics::DMetric, MMetrics::kMaxMetricCount> MMetrics::mMetrics;
+std::atomic<std::size_t> MMetrics::mMetricCount = 0;
+std::vector<std::function<void()>> MMetrics::mSampleCallbacks;
+std::atomic<uint64_t> MMetrics::mFrameCount = 0;
+std::atomic<uint64_t> MMetrics::mDrawCallCount = 0;
+uint64_t MMetrics::mLastFrameCount = 0;
+std::chrono::steady_clock::time_point MMetrics::mLastSampleTime = std::chrono::steady_clock::now();
+std::mutex MMetrics::mSamplerMutex;
+std::condition_variable MMetrics::mSamplerConditionVariable;
+bool MMetrics::mIsStopRequested = false;
+std::thread MMetrics::mSamplerThread;
+
+namespace
+{
+
+/// @brief Total allocated bytes and count by global operator new.
+/// Constant-initialized, so allocations before dynamic initialization are also counted.
+std::atomic<uint64_t> sAllocatedBytes = 0;
+std::atomic<uint64_t> sAllocationCount = 0;
+
+/// @brief Names of resource count metrics. Index is ED3D11Resc.
+constexpr std::array<std::pair<ED3D11Resc, const char*>, 14> kResourceMetrics =
+{
+  std::pair{ED3D11Resc::Device,             "D3D11 Devices"},
+  std::pair{ED3D11Resc::SwapChain,          "D3D11 SwapChains"},
+  std::pair{ED3D11Resc::RTV,                "D3D11 RTVs"},
+  std::pair{ED3D11Resc::DSV,                "D3D11 DSVs"},
+  std::pair{ED3D11Resc::RasterizerState,    "D3D11 RasterizerStates"},
+  std::pair{ED3D11Resc::DepthStencilState,  "D3D11 DepthStencilStates"},
+  std::pair{ED3D11Resc::BlendState,         "D3D11 BlendStates"},
+  std::pair{ED3D11Resc::VertexShader,       "D3D11 VertexShaders"},
+  std::pair{ED3D11Resc::PixelShader,        "D3D11 PixelShaders"},
+  std::pair{ED3D11Resc::InputLayout,        "D3D11 InputLayouts"},
+  std::pair{ED3D11Resc::Buffer,             "D3D11 Buffers"},
+  std::pair{ED3D11Resc::Texture2D,          "D3D11 Texture2Ds"},
+  std::pair{ED3D11Resc::Blob,               "D3D11 Blobs"},
+  std::pair{ED3D11Resc::Query,              "D3D11 Queries"},
+};
+
+} /// ::anonymous namespace
+
+#if PROFILING_TRACK_ALLOCATIONS == 1
+
+void* operator new(std::size_t size)
+{
+  sAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  sAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+  // malloc(0) can return null, so allocate at least one byte.
+  void* pMemory = std::malloc(size == 0 ? 1 : size);
+  if (pMemory == nullptr) { throw std::bad_alloc{}; }
+  return pMemory;
+}
+
+void* operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+  std::free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+  std::free(pMemory);
+}
+
+void operator delete(void* pMemory, std::size_t) noexcept
+{
+  std::free(pMemory);
+}
+
+void operator delete[](void* pMemory, std::size_t) noexcept
+{
+  std::free(pMemory);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  sAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  sAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+  const auto align = static_cast<std::size_t>(alignment);
+  const auto allocSize = size == 0 ? 1 : size;
+#if defined(_MSC_VER)
+  void* pMemory = _aligned_malloc(allocSize, align);
+#else
+  // aligned_alloc requires size to be multiple of alignment.
+  void* pMemory = std::aligned_alloc(align, (allocSize + align - 1) / align * align);
+#endif
+  if (pMemory == nullptr) { throw std::bad_alloc{}; }
+  return pMemory;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return ::operator new(size, alignment);
+}
+
+void operator delete(void* pMemory, std::align_val_t) noexcept
+{
+#if defined(_MSC_VER)
+  _aligned_free(pMemory);
+#else
+  std::free(pMemory);
+#endif
+}
+
+void operator delete[](void* pMemory, std::align_val_t alignment) noexcept
+{
+  ::operator delete(pMemory, alignment);
+}
+
+void operator delete(void* pMemory, std::size_t, std::align_val_t alignment) noexcept
+{
+  ::operator delete(pMemory, alignment);
+}
+
+void operator delete[](void* pMemory, std::size_t, std::align_val_t alignment) noexcept
+{
+  ::operator delete(pMemory, alignment);
+}
+
+#endif
+
+uint32_t MMetrics::RegisterMetric(const std::string& name, EMetricKind kind)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+
+  const auto count = mMetricCount.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (mMetrics[i].mName == name) { return uint32_t(i); }
+  }
+
+  assert(count < kMaxMetricCount);
+  auto& metric = mMetrics[count];
+  metric.mName = name;
+  metric.mKind = kind;
+  mMetricCount.store(count + 1, std::memory_order_release);
+  return uint32_t(count);
+}
+
+std::optional<uint32_t> MMetrics::FindMetric(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+
+  const auto count = mMetricCount.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (mMetrics[i].mName == name) { return uint32_t(i); }
+  }
+  return std::nullopt;
+}
+
+void MMetrics::SetGauge(uint32_t id, double value) noexcept
+{
+  assert(id < mMetricCount.load(std::memory_order_acquire));
+  mMetrics[id].mValue.store(value, std::memory_order_relaxed);
+}
+
+void MMetrics::AddCount(uint32_t id, uint64_t count) noexcept
+{
+  assert(id < mMetricCount.load(std::memory_order_acquire));
+  mMetrics[id].mCount.fetch_add(count, std::memory_order_relaxed);
+}
+
+void MMetrics::SetCount(uint32_t id, uint64_t total) noexcept
+{
+  assert(id < mMetricCount.load(std::memory_order_acquire));
+  mMetrics[id].mCount.store(total, std::memory_order_relaxed);
+}
+
+void MMetrics::CountDrawCall(uint32_t count) noexcept
+{
+  mDrawCallCount.fetch_add(count, std::memory_order_relaxed);
+}
+
+void MMetrics::MarkFrame() noexcept
+{
+  mFrameCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MMetrics::AddSampleCallback(std::function<void()> callback)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  mSampleCallbacks.emplace_back(std::move(callback));
+}
+
+void MMetrics::RegisterDefaultMetrics(dy::AProfilingBase& profiling)
+{
+  const auto cpuUsage = RegisterMetric("CPU Usage", EMetricKind::Gauge);
+  const auto ramUsage = RegisterMetric("RAM Usage", EMetricKind::Gauge);
+
+  // The first call of per-core usage sets baseline of next call.
+  std::vector<uint32_t> coreUsages;
+  const auto coreCount = profiling.GetCpuUsagePerCore().size();
+  for (std::size_t i = 0; i < coreCount; ++i)
+  {
+    coreUsages.emplace_back(RegisterMetric("CPU Core " + std::to_string(i), EMetricKind::Gauge));
+  }
+
+  const auto drawCalls = RegisterMetric("Draw Calls", EMetricKind::CounterPerFrame);
+#if PROFILING_TRACK_ALLOCATIONS == 1
+  const auto allocatedBytes = RegisterMetric("Allocated Bytes", EMetricKind::CounterPerSecond);
+  const auto allocations = RegisterMetric("Allocations", EMetricKind::CounterPerSecond);
+#endif
+
+  std::array<uint32_t, kResourceMetrics.size()> resourceCounts;
+  for (std::size_t i = 0; i < kResourceMetrics.size(); ++i)
+  {
+    resourceCounts[i] = RegisterMetric(kResourceMetrics[i].second, EMetricKind::Gauge);
+  }
+
+  AddSampleCallback([&profiling, cpuUsage, ramUsage, coreUsages]
+  {
+    SetGauge(cpuUsage, profiling.GetCpuUsage());
+    SetGauge(ramUsage, double(profiling.GetRamUsage()));
+
+    // The number of cores can be changed by hotplug, so only update registered cores.
+    const auto usages = profiling.GetCpuUsagePerCore();
+    for (std::size_t i = 0; i < coreUsages.size() && i < usages.size(); ++i)
+    {
+      SetGauge(coreUsages[i], usages[i]);
+    }
+  });
+
+  AddSampleCallback([drawCalls, resourceCounts]
+  {
+    SetCount(drawCalls, mDrawCallCount.load(std::memory_order_relaxed));
+    for (std::size_t i = 0; i < kResourceMetrics.size(); ++i)
+    {
+      SetGauge(resourceCounts[i], double(MD3D11Resources::GetResourceCount(kResourceMetrics[i].first)));
+    }
+  });
+
+#if PROFILING_TRACK_ALLOCATIONS == 1
+  AddSampleCallback([allocatedBytes, allocations]
+  {
+    SetCount(allocatedBytes, sAllocatedBytes.load(std::memory_order_relaxed));
+    SetCount(allocations, sAllocationCount.load(std::memory_order_relaxed));
+  });
+#endif
+}
+
+void MMetrics::StartSampling(std::chrono::milliseconds interval)
+{
+  std::lock_guard<std::mutex> lock{mSamplerMutex};
+  if (mSamplerThread.joinable() == true) { return; }
+
+  mIsStopRequested = false;
+  mSamplerThread = std::thread{&MMetrics::SampleRoutine, interval};
+}
+
+void MMetrics::StopSampling()
+{
+  {
+    std::lock_guard<std::mutex> lock{mSamplerMutex};
+    if (mSamplerThread.joinable() == false) { return; }
+    mIsStopRequested = true;
+  }
+
+  mSamplerConditionVariable.notify_one();
+  mSamplerThread.join();
+}
+
+void MMetrics::SampleRoutine(std::chrono::milliseconds interval)
+{
+  // Sample at fixed rate. If sampling is delayed, next sample is not hurried to catch up.
+  auto nextTime = std::chrono::steady_clock::now() + interval;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock{mSamplerMutex};
+      const auto isStopped = mSamplerConditionVariable.wait_until(
+        lock, nextTime, 
+        [] { return mIsStopRequested; });
+      if (isStopped == true) { return; }
+    }
+
+    Sample();
+
+    nextTime += interval;
+    const auto now = std::chrono::steady_clock::now();
+    if (nextTime < now) { nextTime = now + interval; }
+  }
+}
+
+void MMetrics::Sample()
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  for (const auto& callback : mSampleCallbacks) { callback(); }
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto seconds = std::chrono::duration<double>(now - mLastSampleTime).count();
+  const auto frameCount = mFrameCount.load(std::memory_order_relaxed);
+  const auto frames = frameCount - mLastFrameCount;
+  mLastSampleTime = now;
+  mLastFrameCount = frameCount;
+
+  static const uint32_t traceTrackId = MTraceCapture::AllocateTrackId();
+  const bool isCapturing = MTraceCapture::IsCapturing();
+  const auto metricCount = mMetricCount.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < metricCount; ++i)
+  {
+    auto& metric = mMetrics[i];
+
+    double value = 0.0;
+    switch (metric.mKind)
+    {
+    case EMetricKind::Gauge: 
+    {
+      value = metric.mValue.load(std::memory_order_relaxed);
+    } break;
+    case EMetricKind::CounterPerSecond: 
+    case EMetricKind::CounterPerFrame: 
+    {
+      const auto count = metric.mCount.load(std::memory_order_relaxed);
+      const auto delta = double(count - metric.mLastCount);
+      metric.mLastCount = count;
+
+      const auto divisor = metric.mKind == EMetricKind::CounterPerSecond ? seconds : double(frames);
+      value = divisor > 0.0 ? delta / divisor : 0.0;
+    } break;
+    }
+
+    metric.mHistory[metric.mHistoryHead] = float(value);
+    metric.mHistoryHead = (metric.mHistoryHead + 1) % kHistoryLength;
+    metric.mHistorySize = std::min(metric.mHistorySize + 1, kHistoryLength);
+
+    if (isCapturing == true)
+    {
+      MTraceCapture::AddCounterEvent(metric.mName.c_str(), traceTrackId, "Metrics", now, value);
+    }
+  }
+}
+
+std::size_t MMetrics::GetMetricCount()
+{
+  return mMetricCount.load(std::memory_order_acquire);
+}
+
+std::string MMetrics::GetMetricName(uint32_t id)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  assert(id < mMetricCount.load(std::memory_order_relaxed));
+  return mMetrics[id].mName;
+}
+
+EMetricKind MMetrics::GetMetricKind(uint32_t id)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  assert(id < mMetricCount.load(std::memory_order_relaxed));
+  return mMetrics[id].mKind;
+}
+
+float MMetrics::GetLatest(uint32_t id)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  assert(id < mMetricCount.load(std::memory_order_relaxed));
+
+  const auto& metric = mMetrics[id];
+  if (metric.mHistorySize == 0) { return 0.0f; }
+  return metric.mHistory[(metric.mHistoryHead + kHistoryLength - 1) % kHistoryLength];
+}
+
+std::vector<float> MMetrics::GetHistory(uint32_t id)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  assert(id < mMetricCount.load(std::memory_order_relaxed));
+
+  const auto& metric = mMetrics[id];
+  std::vector<float> history;
+  history.reserve(metric.mHistorySize);
+
+  const auto oldest = (metric.mHistoryHead + kHistoryLength - metric.mHistorySize) % kHistoryLength;
+  for (std::size_t i = 0; i < metric.mHistorySize; ++i)
+  {
+    history.emplace_back(metric.mHistory[(oldest + i) % kHistoryLength]);
+  }
+  return history;
+}
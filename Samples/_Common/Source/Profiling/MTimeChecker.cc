@@ -13,17 +13,204 @@
 
 #include <Profiling/MTimeChecker.h>
 
+#include <algorithm>
+#include <cassert>
+#include <Graphics/MD3D11Resources.h>
+#include <Profiling/MMetrics.h>
+#include <Profiling/MTraceCapture.h>
+
+std::mutex MTimeChecker::mMutex;
 MTimeChecker::TCpuContainer   MTimeChecker::mTimerContainer;
+std::array<MTimeChecker::DTagEntry, MTimeChecker::kMaxTagCount> MTimeChecker::mTags;
+std::size_t MTimeChecker::mTagCount = 0;
+std::unordered_map<std::string, uint32_t> MTimeChecker::mTagIds;
+std::vector<std::shared_ptr<FProfileThreadBuffer>> MTimeChecker::mThreadBuffers;
+std::size_t MTimeChecker::mRetiredDroppedCount = 0;
 MTimeChecker::TD3D11Container MTimeChecker::mD3D11TimeContainer;
+MTimeChecker::TD3D11QueryPools MTimeChecker::mD3D11QueryPools;
+std::vector<DProfileEvent> MTimeChecker::mFrameEvents;
+DProfileScopeTree MTimeChecker::mCpuScopeTree;
+uint64_t MTimeChecker::mCpuFrameIndex = 0;
+TTimeStamp MTimeChecker::mScopeOverhead{0};
+
+namespace
+{
+
+/// @struct DThreadBufferOwner
+/// @brief Thread local owner of thread buffer. Retire buffer when thread is terminated.
+struct DThreadBufferOwner final
+{
+  ~DThreadBufferOwner()
+  {
+    if (this->mBuffer != nullptr) { this->mBuffer->Retire(); }
+  }
+
+  std::shared_ptr<FProfileThreadBuffer> mBuffer = nullptr;
+};
+
+} /// ::anonymous namespace
+
+void MTimeChecker::Initialize()
+{
+  // Clock is calibrated at the first use, so use it here instead of the first profiled scope.
+  [[maybe_unused]] const bool isUsingTsc = XCpuClock::IsUsingTsc();
+  mScopeOverhead = MeasureScopeOverhead();
+
+  // Bind caller thread before any other thread checks CPU time, so worker can not become frame thread.
+  SetFrameThread();
+}
+
+uint32_t MTimeChecker::RegisterTag(const std::string& tagName)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  if (const auto itId = mTagIds.find(tagName); itId != mTagIds.end()) 
+  { 
+    return itId->second; 
+  }
+
+  auto it = mTimerContainer.find(tagName);
+  if (it == mTimerContainer.end())
+  {
+    it = mTimerContainer.try_emplace(tagName, std::make_unique<FTimeContainer>()).first;
+  }
+
+  // Key and container of map are not moved until program is terminated, so just refer them.
+  assert(mTagCount < kMaxTagCount);
+  const auto tagId = uint32_t(mTagCount++);
+  mTags[tagId] = DTagEntry{&it->first, it->second.get()};
+  mTagIds.try_emplace(tagName, tagId);
+  return tagId;
+}
+
+void MTimeChecker::SetFrameThread()
+{
+  auto& threadBuffer = GetThreadBuffer();
+
+  std::lock_guard<std::mutex> lock{mMutex};
+  for (const auto& pBuffer : mThreadBuffers) 
+  { 
+    pBuffer->SetFrameThread(pBuffer.get() == &threadBuffer); 
+  }
+}
 
 FCpuTimeHandle MTimeChecker::CheckCpuTime(const std::string& tagName)
 {
-  if (mTimerContainer.find(tagName) == mTimerContainer.end())
+  return BeginCpuScope(RegisterTag(tagName));
+}
+
+FCpuTimeHandle MTimeChecker::CheckCpuTime(const DProfileTag& tag)
+{
+  return BeginCpuScope(tag.mId);
+}
+
+FCpuTimeHandle MTimeChecker::BeginCpuScope(uint32_t tagId)
+{
+  const auto depth = GetThreadBuffer().EnterScope();
+  return FCpuTimeHandle{tagId, depth};
+}
+
+void MTimeChecker::EndCpuScope(const DProfileEvent& event)
+{
+  auto& buffer = GetThreadBuffer();
+  buffer.ExitScope(event);
+
+  // If the outermost scope of frame thread is ended, frame is completed.
+  if (event.mDepth == 0 && buffer.IsFrameThread() == true)
+  {
+    CompleteFrame();
+  }
+}
+
+FProfileThreadBuffer& MTimeChecker::GetThreadBuffer()
+{
+  thread_local DThreadBufferOwner owner;
+  if (owner.mBuffer == nullptr)
   {
-    mTimerContainer[tagName] = std::make_unique<FTimeContainer>();
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    // Track id 0 is not used. If Initialize() or SetFrameThread() was not called, 
+    // the first registered thread becomes frame thread.
+    static uint32_t trackCounter = 0;
+    trackCounter += 1;
+    owner.mBuffer = std::make_shared<FProfileThreadBuffer>(trackCounter, trackCounter == 1);
+    mThreadBuffers.emplace_back(owner.mBuffer);
   }
 
-  return std::move(FCpuTimeHandle{*mTimerContainer[tagName]});
+  return *owner.mBuffer;
+}
+
+void MTimeChecker::CompleteFrame()
+{
+  std::vector<std::shared_ptr<FProfileThreadBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    buffers = mThreadBuffers;
+  }
+
+  const bool isCapturing = MTraceCapture::IsCapturing();
+  for (const auto& pBuffer : buffers)
+  {
+    // Retired flag must be read before collecting, so events pushed before retirement are not lost.
+    const bool isRetired = pBuffer->IsRetired();
+
+    DProfileEvent event;
+    while (pBuffer->TryPop(event) == true)
+    {
+      const auto& [pTagName, pContainer] = mTags[event.mTagId];
+      const auto duration = XCpuClock::ToDuration(event.mDurationTicks);
+#if PROFILING_HARDWARE_COUNTERS == 1
+      if (pBuffer->HasHardwareCounters() == true) { pContainer->Insert(duration, event.mCounters); }
+      else                                        { pContainer->Insert(duration); }
+#else
+      pContainer->Insert(duration);
+#endif
+
+      if (pBuffer->IsFrameThread() == true) { mFrameEvents.emplace_back(event); }
+      if (isCapturing == true)
+      {
+        MTraceCapture::AddCompleteEvent(
+          pTagName->c_str(), "cpu", pBuffer->GetTrackId(), nullptr, 
+          XCpuClock::ToTimePoint(event.mStartTicks), duration);
+      }
+    }
+
+    if (isRetired == true)
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      mRetiredDroppedCount += pBuffer->GetDroppedCount();
+      mThreadBuffers.erase(std::find(mThreadBuffers.begin(), mThreadBuffers.end(), pBuffer));
+    }
+  }
+
+  // Events are pushed when scope is ended, so sort them by start time to visit parent before children.
+  std::sort(
+    mFrameEvents.begin(), mFrameEvents.end(), 
+    [](const DProfileEvent& lhs, const DProfileEvent& rhs) 
+    { 
+      return lhs.mStartTicks != rhs.mStartTicks ? lhs.mStartTicks < rhs.mStartTicks : lhs.mDepth < rhs.mDepth; 
+    });
+
+  // Build scope tree. Parent of event is the last visited event that is shallower than event.
+  mCpuScopeTree.Clear();
+  std::vector<std::pair<uint32_t, std::size_t>> opened;
+  for (const auto& event : mFrameEvents)
+  {
+    while (opened.empty() == false && opened.back().first >= event.mDepth) { opened.pop_back(); }
+
+    const auto parent = opened.empty() == true ? DProfileScopeTree::kNone : opened.back().second;
+    const auto index = mCpuScopeTree.FindOrInsert(event.mTagId, *mTags[event.mTagId].mName, parent);
+    mCpuScopeTree.AddTime(index, XCpuClock::ToDuration(event.mDurationTicks));
+    opened.emplace_back(event.mDepth, index);
+  }
+  mCpuScopeTree.CalculateSelfTimes();
+  mFrameEvents.clear();
+
+  if (isCapturing == true)
+  {
+    MTraceCapture::MarkFrame(mCpuFrameIndex, GetThreadBuffer().GetTrackId(), std::chrono::steady_clock::now());
+  }
+  mCpuFrameIndex += 1;
+  MMetrics::MarkFrame();
 }
 
 FD3D11TimeHandle MTimeChecker::CheckGpuD3D11Time(
@@ -34,7 +221,7 @@ FD3D11TimeHandle MTimeChecker::CheckGpuD3D11Time(
 {
   if (mD3D11TimeContainer.find(tagName) == mD3D11TimeContainer.end())
   {
-    mD3D11TimeContainer[tagName] = std::make_unique<FD3D11TimeContainer>();
+    mD3D11TimeContainer[tagName] = std::make_unique<FD3D11TimeContainer>(tagName);
   }
 
   return std::move(
@@ -42,12 +229,89 @@ FD3D11TimeHandle MTimeChecker::CheckGpuD3D11Time(
   );
 }
 
+FD3D11TimeHandle MTimeChecker::CheckGpuD3D11Time(
+  const std::string& tagName,
+  const D11HandleDevice& hDevice)
+{
+  if (mD3D11TimeContainer.find(tagName) == mD3D11TimeContainer.end())
+  {
+    mD3D11TimeContainer[tagName] = std::make_unique<FD3D11TimeContainer>(tagName);
+  }
+  if (mD3D11QueryPools.find(tagName) == mD3D11QueryPools.end())
+  {
+    mD3D11QueryPools[tagName] = std::make_unique<FD3D11QueryPool>(hDevice);
+  }
+
+  // Device context is owned by device resource, so pointer is valid while device is alive.
+  auto* pDc = MD3D11Resources::GetDeviceContext(hDevice).GetPtr();
+  return FD3D11TimeHandle{*mD3D11TimeContainer[tagName], *mD3D11QueryPools[tagName], *pDc};
+}
+
+void MTimeChecker::ReleaseD3D11Queries()
+{
+  for (auto& [tagName, pPool] : mD3D11QueryPools)
+  {
+    mD3D11TimeContainer.at(tagName)->DiscardAllPending();
+    pPool->Release();
+  }
+  mD3D11QueryPools.clear();
+}
+
+bool MTimeChecker::Has(const std::string& tagName)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  return mTimerContainer.find(tagName) != mTimerContainer.end();
+}
+
 const FTimeContainer& MTimeChecker::Get(const std::string& tagName)
 {
+  std::lock_guard<std::mutex> lock{mMutex};
   return *mTimerContainer.at(tagName);
 }
 
 const FD3D11TimeContainer& MTimeChecker::GetGpuD3D11(const std::string& tagName)
 {
   return *mD3D11TimeContainer.at(tagName);
+}
+
+const DProfileScopeTree& MTimeChecker::GetCpuScopeTree()
+{
+  return mCpuScopeTree;
+}
+
+TTimeStamp MTimeChecker::GetScopeOverhead()
+{
+  return mScopeOverhead;
+}
+
+TTimeStamp MTimeChecker::MeasureScopeOverhead()
+{
+  // Simulate instrumentation path of one scope. 
+  // Thread buffer is not used, because it is large and opens hardware counters when it is created.
+  constexpr std::size_t kSampleCount = 256;
+  TSpscRingBuffer<DProfileEvent, kSampleCount> events;
+  uint32_t depth = 0;
+
+  const auto begin = XCpuClock::Now();
+  for (std::size_t i = 0; i < kSampleCount; ++i)
+  {
+    DProfileEvent event;
+    event.mStartTicks = XCpuClock::Now();
+    event.mDepth = depth++;
+    event.mDurationTicks = XCpuClock::Now() - event.mStartTicks;
+    depth -= 1;
+    [[maybe_unused]] const bool isPushed = events.TryPush(event);
+  }
+  const auto end = XCpuClock::Now();
+
+  return XCpuClock::ToDuration(end - begin) / double(kSampleCount);
+}
+
+std::size_t MTimeChecker::GetDroppedEventCount()
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+
+  auto count = mRetiredDroppedCount;
+  for (const auto& pBuffer : mThreadBuffers) { count += pBuffer->GetDroppedCount(); }
+  return count;
 }
\ No newline at end of file
@@ -0,0 +1,237 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <Profiling/MTraceCapture.h>
+
+#include <iomanip>
+
+std::atomic<bool> MTraceCapture::mIsCapturing = false;
+std::atomic<uint32_t> MTraceCapture::mVirtualTrackCounter = kVirtualTrackIdBase;
+std::mutex MTraceCapture::mMutex;
+std::condition_variable MTraceCapture::mConditionVariable;
+std::vector<MTraceCapture::DTraceEvent> MTraceCapture::mFrontBuffer;
+bool MTraceCapture::mIsStopRequested = false;
+std::vector<MTraceCapture::DTraceEvent> MTraceCapture::mBackBuffer;
+std::unordered_set<uint32_t> MTraceCapture::mWrittenTracks;
+std::ofstream MTraceCapture::mFile;
+bool MTraceCapture::mIsFirstEvent = true;
+std::thread MTraceCapture::mWriterThread;
+MTraceCapture::TTimePoint MTraceCapture::mStartTime;
+
+bool MTraceCapture::StartCapture(const std::string& filePath)
+{
+  if (mIsCapturing == true) { return false; }
+
+  mFile.open(filePath, std::ios::out | std::ios::trunc);
+  if (mFile.is_open() == false) { return false; }
+
+  // Timestamps are microseconds, so keep nanosecond precision without exponent notation.
+  mFile << std::fixed << std::setprecision(3);
+  mFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  mIsFirstEvent = true;
+  mWrittenTracks.clear();
+  {
+    // Events which were pushed while previous capture was being stopped are just discarded.
+    std::lock_guard<std::mutex> lock{mMutex};
+    mFrontBuffer.clear();
+  }
+  mFrontBuffer.reserve(kFlushThreshold * 2);
+  mBackBuffer.reserve(kFlushThreshold * 2);
+
+  mIsStopRequested = false;
+  mStartTime = TClock::now();
+  mWriterThread = std::thread{&MTraceCapture::WriteRoutine};
+  mIsCapturing = true;
+  return true;
+}
+
+void MTraceCapture::StopCapture()
+{
+  if (mIsCapturing == false) { return; }
+  mIsCapturing = false;
+
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mIsStopRequested = true;
+  }
+  mConditionVariable.notify_one();
+  mWriterThread.join();
+
+  mFile << "]}";
+  mFile.close();
+}
+
+bool MTraceCapture::IsCapturing() noexcept
+{
+  return mIsCapturing.load(std::memory_order_relaxed);
+}
+
+void MTraceCapture::MarkFrame(uint64_t frameIndex, uint32_t trackId, const TTimePoint& time)
+{
+  if (IsCapturing() == false) { return; }
+
+  DTraceEvent event;
+  event.mName = "Frame";
+  event.mPhase = 'i';
+  event.mTrackId = trackId;
+  event.mFrameIndex = frameIndex;
+  event.mTime = time;
+  Push(event);
+}
+
+void MTraceCapture::AddCompleteEvent(
+  const char* name,
+  const char* category,
+  uint32_t trackId,
+  const char* trackName,
+  const TTimePoint& start,
+  const std::chrono::duration<double>& duration)
+{
+  if (IsCapturing() == false) { return; }
+
+  DTraceEvent event;
+  event.mName = name;
+  event.mCategory = category;
+  event.mTrackName = trackName;
+  event.mPhase = 'X';
+  event.mTrackId = trackId;
+  event.mTime = start;
+  event.mDuration = duration;
+  Push(event);
+}
+
+void MTraceCapture::AddCounterEvent(
+  const char* name,
+  uint32_t trackId,
+  const char* trackName,
+  const TTimePoint& time,
+  double value)
+{
+  if (IsCapturing() == false) { return; }
+
+  DTraceEvent event;
+  event.mName = name;
+  event.mTrackName = trackName;
+  event.mPhase = 'C';
+  event.mTrackId = trackId;
+  event.mTime = time;
+  event.mValue = value;
+  Push(event);
+}
+
+uint32_t MTraceCapture::AllocateTrackId() noexcept
+{
+  return mVirtualTrackCounter.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MTraceCapture::Push(const DTraceEvent& event)
+{
+  bool isFull = false;
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mFrontBuffer.emplace_back(event);
+    isFull = mFrontBuffer.size() >= kFlushThreshold;
+  }
+
+  if (isFull == true) { mConditionVariable.notify_one(); }
+}
+
+void MTraceCapture::WriteRoutine()
+{
+  bool isStopped = false;
+  while (isStopped == false)
+  {
+    // Swap buffers and release lock as soon as possible, so producers are not blocked while writing.
+    {
+      std::unique_lock<std::mutex> lock{mMutex};
+      mConditionVariable.wait_for(lock, kFlushInterval, []
+      { 
+        return mIsStopRequested == true || mFrontBuffer.size() >= kFlushThreshold; 
+      });
+
+      std::swap(mFrontBuffer, mBackBuffer);
+      isStopped = mIsStopRequested;
+    }
+
+    for (const auto& event : mBackBuffer) { Write(event); }
+    mBackBuffer.clear();
+  }
+
+  mFile.flush();
+}
+
+void MTraceCapture::Write(const DTraceEvent& event)
+{
+  constexpr uint32_t kProcessId = 1;
+
+  // Name track when event of the track is written at first.
+  if (mWrittenTracks.find(event.mTrackId) == mWrittenTracks.end())
+  {
+    mWrittenTracks.emplace(event.mTrackId);
+
+    mFile << (mIsFirstEvent == true ? "" : ",") 
+      << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << kProcessId 
+      << ",\"tid\":" << event.mTrackId << ",\"args\":{\"name\":\"";
+    if (event.mTrackName != nullptr)  { WriteEscaped(event.mTrackName); }
+    else                              { mFile << "Thread " << event.mTrackId; }
+    mFile << "\"}}";
+    mIsFirstEvent = false;
+  }
+
+  const auto us = std::chrono::duration<double, std::micro>(event.mTime - mStartTime).count();
+
+  mFile << (mIsFirstEvent == true ? "" : ",") 
+    << "\n{\"ph\":\"" << event.mPhase << "\",\"pid\":" << kProcessId 
+    << ",\"tid\":" << event.mTrackId << ",\"ts\":" << us;
+  if (event.mName != nullptr) 
+  { 
+    mFile << ",\"name\":\"";
+    WriteEscaped(event.mName);
+    mFile << '\"';
+  }
+
+  if (event.mCategory != nullptr)
+  {
+    mFile << ",\"cat\":\"";
+    WriteEscaped(event.mCategory);
+    mFile << '\"';
+  }
+
+  switch (event.mPhase)
+  {
+  case 'X': 
+  {
+    mFile << ",\"dur\":" << std::chrono::duration<double, std::micro>(event.mDuration).count();
+  } break;
+  case 'i': 
+  {
+    mFile << ",\"s\":\"g\",\"args\":{\"index\":" << event.mFrameIndex << '}';
+  } break;
+  case 'C':
+  {
+    mFile << ",\"args\":{\"value\":" << event.mValue << '}';
+  } break;
+  }
+
+  mFile << '}';
+  mIsFirstEvent = false;
+}
+
+void MTraceCapture::WriteEscaped(const char* string)
+{
+  for (const char* pChar = string; *pChar != '\0'; ++pChar)
+  {
+    if (*pChar == '\"' || *pChar == '\\') { mFile << '\\'; }
+    mFile << *pChar;
+  }
+}
@@ -0,0 +1,114 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <Profiling/XCpuClock.h>
+
+#if PROFILING_TSC_TIMER == 1 && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+std::chrono::duration<double> XCpuClock::ToDuration(TTicks ticks) noexcept
+{
+  return std::chrono::duration<double>(double(ticks) * GetCalibration().mSecondsPerTick);
+}
+
+std::chrono::steady_clock::time_point XCpuClock::ToTimePoint(TTicks ticks) noexcept
+{
+  const auto& calibration = GetCalibration();
+
+  // Ticks can be earlier than anchor, so calculate signed difference.
+  const auto seconds = (double(ticks) - double(calibration.mAnchorTicks)) * calibration.mSecondsPerTick;
+  return calibration.mAnchorTime 
+    + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+bool XCpuClock::IsUsingTsc() noexcept
+{
+  return GetCalibration().mIsUsingTsc;
+}
+
+std::chrono::duration<double> XCpuClock::GetCallOverhead() noexcept
+{
+  return GetCalibration().mCallOverhead;
+}
+
+const XCpuClock::DCalibration& XCpuClock::GetCalibration() noexcept
+{
+  static const DCalibration calibration = Calibrate();
+  return calibration;
+}
+
+bool XCpuClock::HasInvariantTsc() noexcept
+{
+#if PROFILING_TSC_TIMER == 1
+  // CPUID 0x80000001 EDX[27] is RDTSCP, and CPUID 0x80000007 EDX[8] is invariant TSC.
+  unsigned int registers[4] = {};
+#if defined(_MSC_VER)
+  __cpuid(reinterpret_cast<int*>(registers), 0x80000000);
+  if (registers[0] < 0x80000007) { return false; }
+  __cpuid(reinterpret_cast<int*>(registers), 0x80000001);
+  if ((registers[3] & (1u << 27)) == 0) { return false; }
+  __cpuid(reinterpret_cast<int*>(registers), 0x80000007);
+#else
+  if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007) { return false; }
+  __get_cpuid(0x80000001, &registers[0], &registers[1], &registers[2], &registers[3]);
+  if ((registers[3] & (1u << 27)) == 0) { return false; }
+  __get_cpuid(0x80000007, &registers[0], &registers[1], &registers[2], &registers[3]);
+#endif
+  return (registers[3] & (1u << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+XCpuClock::DCalibration XCpuClock::Calibrate() noexcept
+{
+  using TSteadyClock = std::chrono::steady_clock;
+  DCalibration result;
+
+  result.mIsUsingTsc = HasInvariantTsc();
+  if (result.mIsUsingTsc == true)
+  {
+    // Count ticks while steady_clock goes for a while. Busy waiting is used because sleep can be too coarse.
+    constexpr auto kCalibrationTime = std::chrono::milliseconds(20);
+
+    const auto startTime = TSteadyClock::now();
+    const auto startTicks = ReadTsc();
+    auto endTime = startTime;
+    while (endTime - startTime < kCalibrationTime) { endTime = TSteadyClock::now(); }
+    const auto endTicks = ReadTsc();
+
+    const auto seconds = std::chrono::duration<double>(endTime - startTime).count();
+    result.mSecondsPerTick = seconds / double(endTicks - startTicks);
+  }
+  else
+  {
+    result.mSecondsPerTick = double(TSteadyClock::period::num) / double(TSteadyClock::period::den);
+  }
+
+  result.mAnchorTime = TSteadyClock::now();
+  result.mAnchorTicks = result.mIsUsingTsc == true ? ReadTsc() : ReadSteadyClock();
+
+  // Measure cost of reading clock.
+  constexpr std::size_t kSampleCount = 1000;
+  [[maybe_unused]] volatile TTicks sink = 0;
+  const auto beginTime = TSteadyClock::now();
+  for (std::size_t i = 0; i < kSampleCount; ++i)
+  {
+    sink = result.mIsUsingTsc == true ? ReadTsc() : ReadSteadyClock();
+  }
+  const auto elapsed = std::chrono::duration<double>(TSteadyClock::now() - beginTime);
+  result.mCallOverhead = elapsed / double(kSampleCount);
+
+  return result;
+}
@@ -0,0 +1,133 @@
+///
+/// MIT License
+/// Copyright (c) 2018-2019 Jongmin Yun
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#include <Thread/FWorkerPool.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+
+namespace
+{
+
+/// @struct DParallelForState
+/// @brief Shared progress of one ParallelFor call.
+/// Workers that start after all blocks are claimed still hold this, so this is shared.
+struct DParallelForState final
+{
+  std::atomic<std::size_t> mNextBlock = 0;
+  std::atomic<std::size_t> mDoneBlock = 0;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+};
+
+} /// ::anonymous namespace
+
+FWorkerPool::FWorkerPool(std::size_t workerCount)
+{
+  if (workerCount == 0)
+  {
+    const auto hardwareCount = std::thread::hardware_concurrency();
+    workerCount = hardwareCount > 1 ? hardwareCount - 1 : 0;
+  }
+
+  this->mWorkers.reserve(workerCount);
+  for (std::size_t i = 0; i < workerCount; ++i)
+  {
+    this->mWorkers.emplace_back([this] { this->RunWorker(); });
+  }
+}
+
+FWorkerPool::~FWorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock{this->mMutex};
+    this->mIsStopping = true;
+  }
+  this->mCondition.notify_all();
+
+  for (auto& worker : this->mWorkers) { worker.join(); }
+}
+
+std::size_t FWorkerPool::GetWorkerCount() const noexcept
+{
+  return this->mWorkers.size();
+}
+
+void FWorkerPool::Enqueue(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock{this->mMutex};
+    this->mTasks.emplace_back(std::move(task));
+  }
+  this->mCondition.notify_one();
+}
+
+void FWorkerPool::ParallelFor(
+  std::size_t count, std::size_t blockSize, 
+  const std::function<void(std::size_t, std::size_t)>& task)
+{
+  assert(blockSize > 0);
+  if (count == 0) { return; }
+
+  const auto blockCount = (count + blockSize - 1) / blockSize;
+  auto state = std::make_shared<DParallelForState>();
+
+  // Task is only called after block is claimed, and caller waits all claimed blocks,
+  // so task can be referenced without copy.
+  auto RunBlocks = [state, blockCount, blockSize, count, &task]
+  {
+    for (;;)
+    {
+      const auto block = state->mNextBlock.fetch_add(1);
+      if (block >= blockCount) { return; }
+
+      const auto begin = block * blockSize;
+      task(begin, (std::min)(begin + blockSize, count));
+
+      if (state->mDoneBlock.fetch_add(1) + 1 == blockCount)
+      {
+        std::lock_guard<std::mutex> lock{state->mMutex};
+        state->mCondition.notify_all();
+      }
+    }
+  };
+
+  const auto helperCount = (std::min)(this->GetWorkerCount(), blockCount - 1);
+  for (std::size_t i = 0; i < helperCount; ++i)
+  {
+    this->Enqueue(RunBlocks);
+  }
+  RunBlocks();
+
+  std::unique_lock<std::mutex> lock{state->mMutex};
+  state->mCondition.wait(lock, [&state, blockCount] { return state->mDoneBlock.load() == blockCount; });
+}
+
+void FWorkerPool::RunWorker()
+{
+  for (;;)
+  {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock{this->mMutex};
+      this->mCondition.wait(lock, [this] { return this->mIsStopping == true || this->mTasks.empty() == false; });
+      if (this->mTasks.empty() == true) { return; }
+
+      task = std::move(this->mTasks.front());
+      this->mTasks.pop_front();
+    }
+
+    task();
+  }
+}